@@ -0,0 +1,135 @@
+/**
+ * ChunkedResponse - Streaming HTTP response writer implementation
+ */
+
+#include "PicoWiFiFeatures.h"
+
+#if PICOWIFI_ENABLE_PORTAL || PICOWIFI_ENABLE_STATUS_SERVER
+
+#include "ChunkedResponse.h"
+#include "MemoryMonitor.h"
+#include <stdarg.h>
+
+ChunkedResponse::ChunkedResponse(WebServer& server, int code, const char* contentType)
+    : _server(server)
+    , _used(0)
+    , _bytesSent(0)
+    , _ended(false) {
+    
+    // Unknown length makes WebServer switch to chunked transfer encoding
+    _server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    _server.send(code, contentType, "");
+}
+
+ChunkedResponse::~ChunkedResponse() {
+    end();
+}
+
+size_t ChunkedResponse::write(uint8_t c) {
+    if (_ended) return 0;
+    
+    if (_used == BUFFER_SIZE) {
+        flushBuffer();
+    }
+    _buffer[_used++] = (char)c;
+    return 1;
+}
+
+size_t ChunkedResponse::write(const uint8_t* data, size_t length) {
+    if (_ended) return 0;
+    
+    size_t remaining = length;
+    while (remaining > 0) {
+        if (_used == BUFFER_SIZE) {
+            flushBuffer();
+        }
+        
+        size_t count = BUFFER_SIZE - _used;
+        if (count > remaining) count = remaining;
+        
+        memcpy(_buffer + _used, data, count);
+        _used += count;
+        data += count;
+        remaining -= count;
+    }
+    return length;
+}
+
+size_t ChunkedResponse::printf(const char* format, ...) {
+    if (_ended) return 0;
+    
+    va_list args;
+    va_start(args, format);
+    va_list retry;
+    va_copy(retry, args);
+    int length = vsnprintf(_buffer + _used, BUFFER_SIZE - _used, format, args);
+    va_end(args);
+    
+    if (length >= 0 && (size_t)length >= BUFFER_SIZE - _used) {
+        // Didn't fit behind what is buffered; send that and start over
+        flushBuffer();
+        vsnprintf(_buffer, BUFFER_SIZE, format, retry);
+        if ((size_t)length >= BUFFER_SIZE) {
+            length = BUFFER_SIZE - 1;  // vsnprintf() kept the last byte for its terminator
+        }
+    }
+    va_end(retry);
+    
+    if (length < 0) return 0;
+    _used += length;
+    return length;
+}
+
+void ChunkedResponse::printJSONString(const char* value) {
+    write('"');
+    for (const char* p = value; p && *p; p++) {
+        char c = *p;
+        switch (c) {
+            case '"': print("\\\""); break;
+            case '\\': print("\\\\"); break;
+            case '\n': print("\\n"); break;
+            case '\r': print("\\r"); break;
+            case '\t': print("\\t"); break;
+            default:
+                if ((uint8_t)c < 0x20) {
+                    printf("\\u%04x", c);
+                } else {
+                    write((uint8_t)c);
+                }
+        }
+    }
+    write('"');
+}
+
+void ChunkedResponse::printHTMLEscaped(const char* value) {
+    for (const char* p = value; p && *p; p++) {
+        switch (*p) {
+            case '<': print("&lt;"); break;
+            case '>': print("&gt;"); break;
+            case '&': print("&amp;"); break;
+            case '"': print("&quot;"); break;
+            case '\'': print("&#39;"); break;
+            default: write((uint8_t)*p);
+        }
+    }
+}
+
+void ChunkedResponse::end() {
+    if (_ended) return;
+    
+    flushBuffer();
+    _server.sendContent("");
+    _ended = true;
+}
+
+void ChunkedResponse::flushBuffer() {
+    if (_used == 0) return;
+    
+    // Handlers hold their temporaries while the page is streamed
+    MemoryMonitor::sample();
+    _server.sendContent(_buffer, _used);
+    _bytesSent += _used;
+    _used = 0;
+}
+
+#endif // PICOWIFI_ENABLE_PORTAL || PICOWIFI_ENABLE_STATUS_SERVER
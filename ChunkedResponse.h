@@ -0,0 +1,51 @@
+/**
+ * ChunkedResponse - Streaming HTTP response writer for ConfigPortal
+ * 
+ * Buffers output in a fixed 512-byte array (on the handler's stack) and
+ * forwards it to WebServer::sendContent() using chunked transfer encoding,
+ * so a page never has to be materialized in a heap String
+ */
+
+#ifndef CHUNKED_RESPONSE_H
+#define CHUNKED_RESPONSE_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+
+class ChunkedResponse : public Print {
+public:
+    ChunkedResponse(WebServer& server, int code, const char* contentType);
+    ~ChunkedResponse();
+    
+    // Print interface
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    using Print::write;
+    
+    // Formats straight into the buffer. Print::printf() would allocate on
+    // the heap for anything over 64 bytes; a line longer than the whole
+    // buffer is cut to fit
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    
+    // Escaping helpers for untrusted text (SSIDs, custom titles)
+    void printJSONString(const char* value);
+    void printHTMLEscaped(const char* value);
+    
+    // Sends any buffered bytes and the terminating empty chunk
+    void end();
+    
+    size_t getBytesSent() const { return _bytesSent; }
+    
+    static const size_t BUFFER_SIZE = 512;
+
+private:
+    WebServer& _server;
+    char _buffer[BUFFER_SIZE];
+    size_t _used;
+    size_t _bytesSent;
+    bool _ended;
+    
+    void flushBuffer();
+};
+
+#endif // CHUNKED_RESPONSE_H
@@ -0,0 +1,81 @@
+/**
+ * ComponentSlot - Owning holder for PicoWiFiManager's sub-components
+ *
+ * By default a slot owns a heap object, like a plain pointer would. Built
+ * with PICOWIFI_STATIC_ALLOCATION=1 it constructs the object into storage
+ * inside the slot instead, so the whole library lives in the memory of its
+ * owner and nothing is taken from the heap at begin() or portal start.
+ *
+ * The same option switches the callback types to InplaceFunction, which
+ * keeps the callable inside the object instead of on the heap.
+ *
+ * The option changes class layouts: set it for the whole build (compiler
+ * flags), never with a #define in a single sketch file.
+ */
+
+#ifndef COMPONENT_SLOT_H
+#define COMPONENT_SLOT_H
+
+#include <Arduino.h>
+#include <functional>
+#include <new>
+#include <utility>
+#include "InplaceFunction.h"
+
+#ifndef PICOWIFI_STATIC_ALLOCATION
+#define PICOWIFI_STATIC_ALLOCATION 0
+#endif
+
+// Callback type used throughout the library
+#if PICOWIFI_STATIC_ALLOCATION
+template <typename Signature>
+using CallbackFunction = InplaceFunction<Signature>;
+#else
+template <typename Signature>
+using CallbackFunction = std::function<Signature>;
+#endif
+
+template <typename T>
+class ComponentSlot {
+public:
+    ComponentSlot() : _object(nullptr) {}
+    ~ComponentSlot() { destroy(); }
+
+    ComponentSlot(const ComponentSlot&) = delete;
+    ComponentSlot& operator=(const ComponentSlot&) = delete;
+
+    // Replaces any existing object
+    template <typename... Args>
+    T* create(Args&&... args) {
+        destroy();
+#if PICOWIFI_STATIC_ALLOCATION
+        _object = new (_space) T(std::forward<Args>(args)...);
+#else
+        _object = new T(std::forward<Args>(args)...);
+#endif
+        return _object;
+    }
+
+    void destroy() {
+        if (!_object) return;
+#if PICOWIFI_STATIC_ALLOCATION
+        _object->~T();
+#else
+        delete _object;
+#endif
+        _object = nullptr;
+    }
+
+    T* get() const { return _object; }
+    T* operator->() const { return _object; }
+    T& operator*() const { return *_object; }
+    explicit operator bool() const { return _object != nullptr; }
+
+private:
+    T* _object;
+#if PICOWIFI_STATIC_ALLOCATION
+    alignas(T) uint8_t _space[sizeof(T)];
+#endif
+};
+
+#endif // COMPONENT_SLOT_H
@@ -2,35 +2,57 @@
  * ConfigPortal - Web Configuration Portal Implementation
  */
 
+#include "PicoWiFiFeatures.h"
+
+#if PICOWIFI_ENABLE_PORTAL
+
 #include "ConfigPortal.h"
 #include "PicoWiFiManager.h"
+#include "PortalAssets.h"
+#include "ChunkedResponse.h"
+#include "NetworkScanner.h"
+#include "PicoWiFiLog.h"
+
+#define PICOWIFI_LOG_TAG LogTag::PORTAL
 
 ConfigPortal::ConfigPortal(PicoWiFiManager* manager) 
     : _manager(manager)
-    , _server(nullptr)
-    , _dnsServer(nullptr)
     , _scanner(nullptr)
     , _active(false)
+    , _scanRequested(false)
+    , _keepStation(false)
+    , _connectRequested(false)
+    , _redirectLength(0)
+    , _probeCount(0)
+    , _firstProbeAt(0)
+    , _popupLatency(0)
+    , _provisionState(ProvisionState::IDLE)
+    , _resultDeliveredAt(0)
     , _apIP(192, 168, 4, 1)
     , _timeout(300000)
     , _startTime(0)
     , _title("Pico WiFi Setup") {
+    memset(_pendingSSID, 0, sizeof(_pendingSSID));
+    memset(_pendingPassword, 0, sizeof(_pendingPassword));
 }
 
 ConfigPortal::~ConfigPortal() {
-    if (_server) delete _server;
-    if (_dnsServer) delete _dnsServer;
+    _dnsServer.destroy();
+    _server.destroy();
 }
 
 bool ConfigPortal::start(const char* ssid, const char* password) {
-    Serial.println("Starting ConfigPortal...");
+    PICOWIFI_LOGI("Starting ConfigPortal...");
     
-    // Stop any existing connection
-    WiFi.disconnect();
-    delay(100);
-    
-    // Start AP mode
-    WiFi.mode(WIFI_AP);
+    if (_keepStation) {
+        // Leave the uplink (if any) alone and add the AP next to it
+        WiFi.mode(WIFI_AP_STA);
+    } else {
+        // Stop any existing connection
+        WiFi.disconnect();
+        delay(100);
+        WiFi.mode(WIFI_AP);
+    }
     
     bool result;
     if (password && strlen(password) > 0) {
@@ -40,33 +62,43 @@ bool ConfigPortal::start(const char* ssid, const char* password) {
     }
     
     if (!result) {
-        Serial.println("Failed to start AP");
+        PICOWIFI_LOGE("Failed to start AP");
         return false;
     }
     
     delay(1000);
     _apIP = WiFi.softAPIP();
+    buildRedirect();
     
     // Create web server
+    // Create the web server; routes are registered once, since each
+    // registration allocates a handler the server keeps until destroyed
     if (!_server) {
-        _server = new WebServer(80);
+        _server.create(80);
+        setupRoutes();
     }
     
-    // Setup routes
-    setupRoutes();
-    
     // Start DNS server for captive portal
     if (!_dnsServer) {
-        _dnsServer = new DNSServer();
+        _dnsServer.create();
     }
     _dnsServer->start(53, "*", _apIP);
     
     _server->begin();
     _active = true;
     _startTime = millis();
+    _connectRequested = false;
+    _provisionState = ProvisionState::IDLE;
+    _resultDeliveredAt = 0;
+    _probeCount = 0;
+    _firstProbeAt = 0;
+    _popupLatency = 0;
+    
+    // Have results ready by the time the first phone loads the page
+    requestScan();
     
-    Serial.printf("AP started: %s\n", ssid);
-    Serial.printf("IP: %s\n", _apIP.toString().c_str());
+    PICOWIFI_LOGI("AP started: %s", ssid);
+    PICOWIFI_LOGI("IP: %s", _apIP.toString().c_str());
     
     return true;
 }
@@ -81,22 +113,32 @@ void ConfigPortal::stop() {
             _dnsServer->stop();
         }
         WiFi.softAPdisconnect(true);
-        Serial.println("ConfigPortal stopped");
+        PICOWIFI_LOGI("ConfigPortal stopped");
     }
 }
 
 void ConfigPortal::handle() {
     if (_active && _server) {
-        // Handle DNS requests for captive portal
+        // Handle DNS requests for captive portal. Phones joining the AP fire
+        // bursts of lookups; answering one per pass leaves the rest queued
+        // behind whatever else the loop does. An empty socket costs little.
         if (_dnsServer) {
-            _dnsServer->processNextRequest();
+            for (uint8_t i = 0; i < DNS_BATCH; i++) {
+                _dnsServer->processNextRequest();
+            }
         }
         
         _server->handleClient();
         
+        // Start submitted connects only after their response has been sent
+        dispatchConnect();
+        
+        // Refresh scan results between requests
+        refreshScan();
+        
         // Check timeout
         if (_timeout > 0 && (millis() - _startTime > _timeout)) {
-            Serial.println("ConfigPortal timeout");
+            PICOWIFI_LOGI("ConfigPortal timeout");
             stop();
         }
     }
@@ -114,113 +156,131 @@ void ConfigPortal::setCustomHTML(const String& html) {
     _customHTML = html;
 }
 
+void ConfigPortal::refreshScan() {
+    if (!_scanRequested || !_scanner || _scanner->isScanInProgress()) {
+        return;
+    }
+    
+    _scanRequested = false;
+    
+    // An AP-only portal has no STA interface for the background scan; the
+    // blocking scan brings it up and the visitor is waiting for the list
+    if (!_scanner->startAsyncScan()) {
+        _scanner->startScan();
+    }
+}
+
+void ConfigPortal::dispatchConnect() {
+    if (!_connectRequested) {
+        return;
+    }
+    
+    _connectRequested = false;
+    if (_onConnect) {
+        _onConnect(String(_pendingSSID), String(_pendingPassword));
+    }
+    memset(_pendingPassword, 0, sizeof(_pendingPassword));
+}
+
+void ConfigPortal::setProvisionResult(ProvisionState state, IPAddress ip) {
+    _provisionState = state;
+    _provisionIP = ip;
+}
+
 void ConfigPortal::setupRoutes() {
     _server->on("/", [this]() { handleRoot(); });
+    _server->on("/portal.css", [this]() {
+        handleAsset(PORTAL_CSS_GZ, PORTAL_CSS_GZ_LEN, PORTAL_CSS_TYPE, true);
+    });
+    _server->on("/portal.js", [this]() {
+        handleAsset(PORTAL_JS_GZ, PORTAL_JS_GZ_LEN, PORTAL_JS_TYPE, true);
+    });
+    _server->on("/state.json", [this]() { handleState(); });
     _server->on("/scan", [this]() { handleScan(); });
     _server->on("/connect", HTTP_POST, [this]() { handleConnect(); });
+    _server->on("/result", [this]() { handleResult(); });
+    _server->on("/result.json", [this]() { handleResultJSON(); });
     _server->on("/info", [this]() { handleInfo(); });
     _server->on("/reset", [this]() { handleReset(); });
     
-    // Apple captive portal detection
-    _server->on("/hotspot-detect.html", [this]() { handleRoot(); });
-    _server->on("/library/test/success.html", [this]() { handleRoot(); });
-    _server->on("/captive", [this]() { handleRoot(); });
-    
-    // Microsoft Windows captive portal detection
-    _server->on("/ncsi.txt", [this]() { 
-        _server->send(200, "text/plain", "Microsoft NCSI"); 
-    });
-    _server->on("/connecttest.txt", [this]() { 
-        _server->send(200, "text/plain", "Microsoft Connect Test"); 
-    });
-    
-    // Android captive portal detection
-    _server->on("/generate_204", [this]() { 
-        _server->sendHeader("Location", "/");
-        _server->send(302, "text/plain", ""); 
-    });
+    // OS connectivity probes all get the prebuilt redirect, which makes every
+    // platform open its captive portal window
+    static const char* const PROBE_URIS[] = {
+        "/hotspot-detect.html",         // Apple
+        "/library/test/success.html",   // Apple (older)
+        "/captive",
+        "/generate_204",                // Android, Chrome OS
+        "/gen_204",
+        "/ncsi.txt",                    // Windows
+        "/connecttest.txt",             // Windows 10+
+        "/redirect",                    // Windows 10+
+        "/canonical.html",              // Firefox
+        "/success.txt"                  // Firefox
+    };
+    for (const char* uri : PROBE_URIS) {
+        _server->on(uri, [this]() { handleProbe(); });
+    }
     
     _server->onNotFound([this]() { handleNotFound(); });
 }
 
 void ConfigPortal::handleRoot() {
-    // Add proper headers for captive portal detection
-    _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-    _server->sendHeader("Pragma", "no-cache");
-    _server->sendHeader("Expires", "-1");
-    
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'>";
-    html += "<title>" + _title + "</title>";
-    html += "<meta name='viewport' content='width=device-width,initial-scale=1'>";
-    html += "<meta http-equiv='Cache-Control' content='no-cache, no-store, must-revalidate'>";
-    html += "<meta http-equiv='Pragma' content='no-cache'>";
-    html += "<meta http-equiv='Expires' content='0'>";
-    html += "<style>";
-    html += "body{font-family:-apple-system,BlinkMacSystemFont,'Segoe UI',Roboto,Arial,sans-serif;margin:20px;background:#f5f5f5}";
-    html += ".container{max-width:400px;margin:0 auto;background:white;padding:20px;border-radius:8px;box-shadow:0 2px 10px rgba(0,0,0,0.1)}";
-    html += "h1{color:#333;text-align:center;margin-bottom:30px}";
-    html += "h3{color:#666;margin-bottom:15px}";
-    html += ".network-item{background:#f8f9fa;margin:5px 0;padding:10px;border-radius:4px;cursor:pointer;border:1px solid #e9ecef}";
-    html += ".network-item:hover{background:#e9ecef}";
-    html += ".btn{background:#007cba;color:white;padding:12px 24px;border:none;border-radius:4px;cursor:pointer;width:100%;font-size:16px;margin:5px 0}";
-    html += ".btn:hover{background:#005a87}";
-    html += "input[type=text],input[type=password]{width:100%;padding:12px;margin:5px 0;border:1px solid #ccc;border-radius:4px;box-sizing:border-box;font-size:16px}";
-    html += ".btn-secondary{background:#6c757d;margin-right:10px;width:auto;display:inline-block}";
-    html += "</style></head><body>";
-    
-    html += "<div class='container'>";
-    html += "<h1>WiFi " + _title + "</h1>";
-    html += "<h3>選擇網路:</h3>";
-    
-    // Scan networks
-    int networks = WiFi.scanNetworks();
-    if (networks == 0) {
-        html += "<p style='text-align:center;color:#666'>未找到網路</p>";
-    } else {
-        for (int i = 0; i < networks && i < 10; i++) {
-            String ssid = WiFi.SSID(i);
-            int32_t rssi = WiFi.RSSI(i);
-            bool encrypted = (WiFi.encryptionType(i) != ENC_TYPE_NONE);
-            
-            // Signal strength indicator
-            String signalIcon = "●●●●";
-            String lockIcon = encrypted ? " [加密]" : " [開放]";
-            
-            if (rssi > -50) signalIcon = "●●●●";      // Excellent
-            else if (rssi > -65) signalIcon = "●●●○"; // Good
-            else if (rssi > -80) signalIcon = "●●○○"; // Fair
-            else signalIcon = "●○○○";                  // Weak
-            
-            html += "<div class='network-item' onclick='document.getElementById(\"ssid\").value=\"" + ssid + "\"'>";
-            html += signalIcon + " " + ssid + " (" + String(rssi) + " dBm)" + lockIcon;
-            html += "</div>";
-        }
+    if (_firstProbeAt != 0 && _popupLatency == 0) {
+        _popupLatency = (millis() - _firstProbeAt) | 1; // Never 0 once measured
     }
     
-    html += "<hr style='margin:20px 0'>";
-    html += "<form action='/connect' method='post'>";
-    html += "<p><input type='text' id='ssid' name='ssid' placeholder='網路名稱 (SSID)' required></p>";
-    html += "<p><input type='password' name='password' placeholder='密碼 (如需要)'></p>";
-    html += "<p><button type='submit' class='btn'>連接網路</button></p>";
-    html += "</form>";
-    
-    html += "<div style='text-align:center;margin-top:20px'>";
-    html += "<a href='/scan' class='btn btn-secondary'>重新掃描</a> ";
-    html += "<a href='/info' class='btn btn-secondary'>設備資訊</a> ";
-    html += "<a href='/reset' class='btn btn-secondary'>重置設備</a>";
-    html += "</div>";
-    
-    if (!_customHTML.isEmpty()) {
-        html += "<hr style='margin:20px 0'>" + _customHTML;
+    // The page itself is static; networks and title arrive via /state.json.
+    // It is not cached so captive portal checks always reach the device.
+    handleAsset(PORTAL_INDEX_HTML_GZ, PORTAL_INDEX_HTML_GZ_LEN, PORTAL_INDEX_HTML_TYPE, false);
+}
+
+void ConfigPortal::handleAsset(const uint8_t* data, size_t length, const char* type, bool cacheable) {
+    if (cacheable) {
+        // URLs carry PORTAL_ASSET_VERSION, so a rebuilt firmware busts the cache
+        _server->sendHeader("Cache-Control", "public, max-age=31536000, immutable");
+    } else {
+        _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
+        _server->sendHeader("Pragma", "no-cache");
+        _server->sendHeader("Expires", "-1");
     }
+    _server->sendHeader("Content-Encoding", "gzip");
+    _server->send_P(200, type, (PGM_P)data, length);
+}
+
+void ConfigPortal::handleState() {
+    _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
     
-    html += "</div></body></html>";
+    ChunkedResponse out(*_server, 200, "application/json");
+    out.print("{\"title\":");
+    out.printJSONString(_title.c_str());
+    out.print(",\"networks\":[");
     
-    _server->send(200, "text/html; charset=utf-8", html);
+    // Render from the scanner cache; stale results trigger a background rescan
+    if (_scanner) {
+        if (!_scanner->isCacheValid()) {
+            requestScan();
+        }
+        
+        NetworkList networks = _scanner->getCachedResults();
+        for (size_t i = 0; i < networks.size() && i < MAX_LISTED_NETWORKS; i++) {
+            const ScannedNetwork& network = networks[i];
+            if (i > 0) out.print(",");
+            out.print("{\"ssid\":");
+            out.printJSONString(network.ssid);
+            out.printf(",\"rssi\":%ld,\"enc\":%s}", (long)network.rssi,
+                       network.isSecure() ? "true" : "false");
+        }
+    }
+    
+    out.printf("],\"scanning\":%s,\"custom\":",
+               (_scanRequested || (_scanner && _scanner->isScanInProgress())) ? "true" : "false");
+    out.printJSONString(_customHTML.c_str());
+    out.print("}");
+    out.end();
 }
 
 void ConfigPortal::handleScan() {
+    requestScan();
     _server->sendHeader("Location", "/");
     _server->send(302, "text/plain", "");
 }
@@ -229,50 +289,136 @@ void ConfigPortal::handleConnect() {
     String ssid = _server->arg("ssid");
     String password = _server->arg("password");
     
-    if (ssid.length() == 0) {
-        _server->send(400, "text/html; charset=utf-8", "<h1>錯誤</h1><p>需要輸入網路名稱</p><a href='/'>返回</a>");
+    if (ssid.length() == 0 || ssid.length() >= sizeof(_pendingSSID) ||
+        password.length() >= sizeof(_pendingPassword)) {
+        _server->send(400, "text/html; charset=utf-8", "<h1>錯誤</h1><p>網路名稱或密碼無效</p><a href='/'>返回</a>");
         return;
     }
     
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'>";
-    html += "<title>連線中...</title>";
-    html += "<meta http-equiv='refresh' content='10;url=/result'>";
-    html += "</head><body><h1>正在連線到 " + ssid + "...</h1>";
-    html += "<p>請等待...</p></body></html>";
+    strncpy(_pendingSSID, ssid.c_str(), sizeof(_pendingSSID) - 1);
+    strncpy(_pendingPassword, password.c_str(), sizeof(_pendingPassword) - 1);
+    _connectRequested = true;
+    _provisionState = ProvisionState::CONNECTING;
+    _resultDeliveredAt = 0;
+    
+    ChunkedResponse out(*_server, 200, "text/html; charset=utf-8");
+    out.print("<!DOCTYPE html><html><head>"
+              "<meta charset='UTF-8'>"
+              "<title>連線中...</title>"
+              "<meta http-equiv='refresh' content='3;url=/result'>"
+              "</head><body><h1>正在連線到 ");
+    out.printHTMLEscaped(_pendingSSID);
+    out.print("...</h1><p>請等待...</p></body></html>");
+    out.end();
+}
+
+void ConfigPortal::handleResult() {
+    _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
     
-    _server->send(200, "text/html; charset=utf-8", html);
+    if (_provisionState == ProvisionState::IDLE) {
+        _server->sendHeader("Location", "/");
+        _server->send(302, "text/plain", "");
+        return;
+    }
     
-    // Trigger callback
-    if (_onConnect) {
-        _onConnect(ssid, password);
+    ChunkedResponse out(*_server, 200, "text/html; charset=utf-8");
+    out.print("<!DOCTYPE html><html><head>"
+              "<meta charset='UTF-8'>"
+              "<title>連線結果</title>");
+    
+    switch (_provisionState) {
+        case ProvisionState::CONNECTING:
+            out.print("<meta http-equiv='refresh' content='2'></head><body><h1>正在連線到 ");
+            out.printHTMLEscaped(_pendingSSID);
+            out.print("...</h1><p>請等待...</p>");
+            break;
+            
+        case ProvisionState::CONNECTED:
+            out.print("</head><body><h1>已連線到 ");
+            out.printHTMLEscaped(_pendingSSID);
+            out.printf("</h1><p>IP: %u.%u.%u.%u</p><p>設定熱點即將關閉。</p>",
+                       _provisionIP[0], _provisionIP[1], _provisionIP[2], _provisionIP[3]);
+            if (_resultDeliveredAt == 0) {
+                _resultDeliveredAt = millis() | 1; // Never 0
+            }
+            break;
+            
+        default:
+            out.print("</head><body><h1>無法連線到 ");
+            out.printHTMLEscaped(_pendingSSID);
+            out.print("</h1><p>請檢查密碼後再試一次。</p><a href='/'>返回</a>");
+            break;
+    }
+    
+    out.print("</body></html>");
+    out.end();
+}
+
+void ConfigPortal::handleResultJSON() {
+    static const char* const STATES[] = { "idle", "connecting", "connected", "failed" };
+    
+    _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
+    
+    ChunkedResponse out(*_server, 200, "application/json");
+    out.printf("{\"state\":\"%s\",\"ssid\":", STATES[(uint8_t)_provisionState]);
+    out.printJSONString(_pendingSSID);
+    out.printf(",\"ip\":\"%u.%u.%u.%u\"}", _provisionIP[0], _provisionIP[1], _provisionIP[2], _provisionIP[3]);
+    out.end();
+    
+    if (_provisionState == ProvisionState::CONNECTED && _resultDeliveredAt == 0) {
+        _resultDeliveredAt = millis() | 1;
     }
 }
 
 void ConfigPortal::handleInfo() {
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'>";
-    html += "<title>設備資訊</title></head><body>";
-    html += "<h1>設備資訊</h1>";
-    html += "<p><strong>晶片 ID:</strong> " + String(rp2040.hwrand32(), HEX) + "</p>";
-    html += "<p><strong>可用記憶體:</strong> " + String(rp2040.getFreeHeap()) + " bytes</p>";
-    html += "<p><strong>運行時間:</strong> " + String(millis() / 1000) + " 秒</p>";
-    html += "<p><strong>AP IP:</strong> " + _apIP.toString() + "</p>";
-    html += "<br><a href='/'>返回</a>";
-    html += "</body></html>";
-    
-    _server->send(200, "text/html; charset=utf-8", html);
+    ChunkedResponse out(*_server, 200, "text/html; charset=utf-8");
+    out.print("<!DOCTYPE html><html><head>"
+              "<meta charset='UTF-8'>"
+              "<title>設備資訊</title></head><body>"
+              "<h1>設備資訊</h1>");
+    out.printf("<p><strong>晶片 ID:</strong> %lx</p>", (unsigned long)rp2040.hwrand32());
+    out.printf("<p><strong>可用記憶體:</strong> %lu bytes</p>", (unsigned long)rp2040.getFreeHeap());
+    out.printf("<p><strong>運行時間:</strong> %lu 秒</p>", (unsigned long)(millis() / 1000));
+    out.printf("<p><strong>AP IP:</strong> %u.%u.%u.%u</p>", _apIP[0], _apIP[1], _apIP[2], _apIP[3]);
+    
+    if (_manager) {
+        ConnectTiming timing;
+        _manager->getConnectTiming(timing);
+        const ConnectTimeline& last = timing.getLast();
+        
+        out.printf("<h2>連線時間</h2><p>成功 %lu 次，失敗 %lu 次</p>",
+                   (unsigned long)timing.getConnects(), (unsigned long)timing.getFailures());
+        out.print("<table border='1' cellpadding='4'>"
+                  "<tr><th>階段</th><th>上次</th><th>最小</th><th>平均</th><th>p95</th><th>次數</th></tr>");
+        for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+            ConnectPhase phase = (ConnectPhase)i;
+            const LatencyHistogram& histogram = timing.getHistogram(phase);
+            out.printf("<tr><td>%s</td><td>%lu</td><td>%lu</td><td>%lu</td><td>%lu</td><td>%lu</td></tr>",
+                       ConnectTiming::getPhaseName(phase), (unsigned long)last.phase[i],
+                       (unsigned long)histogram.getMin(), (unsigned long)histogram.getAverage(),
+                       (unsigned long)histogram.getPercentile(95), (unsigned long)histogram.getCount());
+        }
+        out.print("</table><p>單位: 毫秒</p>");
+    }
+    
+    out.printf("<p><strong>偵測請求:</strong> %lu，彈出延遲: %lu ms</p>",
+               (unsigned long)_probeCount, (unsigned long)_popupLatency);
+    
+    out.print("<br><a href='/'>返回</a>"
+              "</body></html>");
+    out.end();
 }
 
 void ConfigPortal::handleReset() {
-    String html = "<!DOCTYPE html><html><head>";
-    html += "<meta charset='UTF-8'>";
-    html += "<title>重置中</title></head><body>";
-    html += "<h1>重置中...</h1>";
-    html += "<p>設備將在 3 秒後重新啟動。</p>";
-    html += "</body></html>";
-    
-    _server->send(200, "text/html; charset=utf-8", html);
+    {
+        ChunkedResponse out(*_server, 200, "text/html; charset=utf-8");
+        out.print("<!DOCTYPE html><html><head>"
+                  "<meta charset='UTF-8'>"
+                  "<title>重置中</title></head><body>"
+                  "<h1>重置中...</h1>"
+                  "<p>設備將在 3 秒後重新啟動。</p>"
+                  "</body></html>");
+    }
     delay(2000);
     
     if (_onReset) {
@@ -281,21 +427,32 @@ void ConfigPortal::handleReset() {
 }
 
 void ConfigPortal::handleNotFound() {
-    String uri = _server->uri();
-    
-    // Special handling for common captive portal detection URLs
-    if (uri.equals("/hotspot-detect.html") || 
-        uri.equals("/library/test/success.html") ||
-        uri.equals("/captive") ||
-        uri.equals("/generate_204")) {
-        handleRoot();
-        return;
+    // Everything else (apps phoning home, typed URLs) lands on the portal too
+    sendRedirect();
+}
+
+void ConfigPortal::handleProbe() {
+    _probeCount++;
+    if (_firstProbeAt == 0) {
+        _firstProbeAt = millis() | 1;
     }
-    
-    // For all other requests, redirect to root with proper headers
-    _server->sendHeader("Location", "http://" + _apIP.toString() + "/");
-    _server->sendHeader("Cache-Control", "no-cache, no-store, must-revalidate");
-    _server->sendHeader("Pragma", "no-cache");
-    _server->sendHeader("Expires", "-1");
-    _server->send(302, "text/plain", "Redirecting to captive portal");
-}
\ No newline at end of file
+    sendRedirect();
+}
+
+void ConfigPortal::buildRedirect() {
+    int length = snprintf(_redirectResponse, sizeof(_redirectResponse),
+                          "HTTP/1.1 302 Found\r\n"
+                          "Location: http://%u.%u.%u.%u/\r\n"
+                          "Cache-Control: no-cache, no-store, must-revalidate\r\n"
+                          "Content-Length: 0\r\n"
+                          "Connection: close\r\n\r\n",
+                          _apIP[0], _apIP[1], _apIP[2], _apIP[3]);
+    _redirectLength = (length > 0 && (size_t)length < sizeof(_redirectResponse)) ? length : 0;
+}
+
+void ConfigPortal::sendRedirect() {
+    // Written straight to the socket: no header Strings, no formatting
+    _server->client().write((const uint8_t*)_redirectResponse, _redirectLength);
+}
+
+#endif // PICOWIFI_ENABLE_PORTAL
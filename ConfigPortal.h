@@ -11,12 +11,20 @@
 #include <Arduino.h>
 #include <WebServer.h>
 #include <DNSServer.h>
-#include <functional>
+#include "ComponentSlot.h"
 
 // Forward declarations
 class PicoWiFiManager;
 class NetworkScanner;
 
+// Outcome of credentials submitted through the portal, shown on /result
+enum class ProvisionState : uint8_t {
+    IDLE,
+    CONNECTING,
+    CONNECTED,
+    FAILED
+};
+
 struct NetworkInfo {
     String ssid;
     int32_t rssi;
@@ -41,21 +49,58 @@ public:
     void setTimeout(uint32_t seconds);
     void setTitle(const String& title);
     void setCustomHTML(const String& html);
+    void setScanner(NetworkScanner* scanner) { _scanner = scanner; }
+    
+    // Run the AP next to the station interface (WIFI_AP_STA) so credentials
+    // can be tried while the portal stays reachable
+    void setKeepStation(bool keep) { _keepStation = keep; }
+    
+    // Provisioning result, reported by the manager
+    void setProvisionResult(ProvisionState state, IPAddress ip = IPAddress());
+    ProvisionState getProvisionState() const { return _provisionState; }
+    uint32_t getResultDeliveredAt() const { return _resultDeliveredAt; }  // 0 until /result showed success
+    
+    // Captive portal detection: probes answered and the time from the first
+    // probe to the first portal page load (0 until it happened)
+    uint32_t getProbeCount() const { return _probeCount; }
+    uint32_t getPopupLatency() const { return _popupLatency; }
+    
+    // Queue a background rescan; it runs from handle(), never inside a request
+    void requestScan() { _scanRequested = true; }
     
     // Callbacks
-    typedef std::function<void(const String& ssid, const String& password)> ConnectCallback;
-    typedef std::function<void()> ResetCallback;
+    typedef CallbackFunction<void(const String& ssid, const String& password)> ConnectCallback;
+    typedef CallbackFunction<void()> ResetCallback;
     
     void onConnect(ConnectCallback callback) { _onConnect = callback; }
     void onReset(ResetCallback callback) { _onReset = callback; }
 
 private:
     PicoWiFiManager* _manager;
-    WebServer* _server;
-    DNSServer* _dnsServer;
+    ComponentSlot<WebServer> _server;
+    ComponentSlot<DNSServer> _dnsServer;
     NetworkScanner* _scanner;
     
     bool _active;
+    bool _scanRequested;
+    bool _keepStation;
+    
+    // Submitted credentials, handed to _onConnect from handle() once the
+    // response has gone out
+    bool _connectRequested;
+    char _pendingSSID[33];
+    char _pendingPassword[65];
+    
+    // Complete 302 to the portal, built once the AP address is known
+    char _redirectResponse[192];
+    size_t _redirectLength;
+    uint32_t _probeCount;
+    uint32_t _firstProbeAt;
+    uint32_t _popupLatency;
+    
+    ProvisionState _provisionState;
+    IPAddress _provisionIP;
+    uint32_t _resultDeliveredAt;
     IPAddress _apIP;
     uint32_t _timeout;
     uint32_t _startTime;
@@ -68,40 +113,35 @@ private:
     
     // HTTP handlers
     void handleRoot();
+    void handleAsset(const uint8_t* data, size_t length, const char* type, bool cacheable);
+    void handleState();
     void handleWiFi();
     void handleScan();
     void handleConnect();
+    void handleResult();
+    void handleResultJSON();
     void handleInfo();
     void handleReset();
     void handleNotFound();
+    void handleProbe();
     void handleExit();
     
     // Setup
     void setupRoutes();
+    void refreshScan();
+    void dispatchConnect();
     
-    // HTML generators
-    String generateHeader();
-    String generateFooter();
-    String generateCSS();
-    String generateJS();
-    String generateNetworkList();
-    String generateInfoPage();
+    void buildRedirect();
+    void sendRedirect();
+    
+    static const uint8_t MAX_LISTED_NETWORKS = 10;
+    static const uint8_t DNS_BATCH = 8;  // Queries answered per handle()
     
     // Utilities
     String getSignalIcon(int32_t rssi);
     String getSecurityIcon(bool encrypted);
     String formatRSSI(int32_t rssi);
     bool captivePortalRedirect();
-    
-    // Template strings
-    static const char* HTML_HEAD;
-    static const char* HTML_CSS;
-    static const char* HTML_JS;
-    static const char* HTML_ROOT;
-    static const char* HTML_WIFI_FORM;
-    static const char* HTML_INFO;
-    static const char* HTML_SUCCESS;
-    static const char* HTML_FAIL;
 };
 
 #endif // CONFIG_PORTAL_H
\ No newline at end of file
@@ -0,0 +1,163 @@
+/**
+ * ConnectTiming - Implementation
+ */
+
+#include "ConnectTiming.h"
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+void LatencyHistogram::add(uint32_t ms) {
+    uint8_t bucket = bucketFor(ms);
+
+    // Halve everything before a bucket overflows, which keeps the shape and
+    // gradually favours recent samples
+    if (_buckets[bucket] == 0xFFFF) {
+        for (uint8_t i = 0; i < BUCKETS; i++) {
+            _buckets[i] = (_buckets[i] + 1) / 2;
+        }
+    }
+    _buckets[bucket]++;
+
+    if (_count == 0 || ms < _min) _min = ms;
+    if (ms > _max) _max = ms;
+    _count++;
+    _sum += ms;
+}
+
+void LatencyHistogram::clear() {
+    _count = 0;
+    _min = 0;
+    _max = 0;
+    _sum = 0;
+    memset(_buckets, 0, sizeof(_buckets));
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percent) const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        total += _buckets[i];
+    }
+    if (total == 0) return 0;
+
+    uint32_t rank = (total * percent + 99) / 100;
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        seen += _buckets[i];
+        if (seen >= rank) {
+            uint32_t upper = bucketUpperBound(i);
+            return upper < _max ? upper : _max;
+        }
+    }
+    return _max;
+}
+
+uint8_t LatencyHistogram::bucketFor(uint32_t ms) {
+    if (ms < 4) return ms;
+
+    // Exponent and the two bits below the leading one select the bucket
+    uint8_t exponent = 31 - __builtin_clz(ms);
+    uint8_t bucket = 4 * (exponent - 1) + ((ms >> (exponent - 2)) & 3);
+    return bucket < BUCKETS ? bucket : BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketUpperBound(uint8_t bucket) {
+    if (bucket < 4) return bucket;
+    if (bucket == BUCKETS - 1) return UINT32_MAX;
+
+    uint8_t exponent = bucket / 4 + 1;
+    uint32_t width = 1UL << (exponent - 2);
+    return (4 + bucket % 4) * width + width - 1;
+}
+
+ConnectTiming::ConnectTiming()
+    : _failures(0) {
+}
+
+void ConnectTiming::addPhase(ConnectPhase phase, uint32_t ms) {
+    _current.phase[(uint8_t)phase] += ms;
+    if (phase == ConnectPhase::RADIO_ON) {
+        _current.radioWasOff = true;
+    }
+}
+
+void ConnectTiming::completed(uint32_t now, uint32_t total, bool fast, bool reconnect,
+                              PowerSaveMode powerMode) {
+    // The power-up comes before the request's clock starts
+    total += _current.phase[(uint8_t)ConnectPhase::RADIO_ON];
+    _current.phase[(uint8_t)ConnectPhase::TOTAL] = total;
+    _current.completedAt = now;
+    _current.fast = fast;
+    _current.reconnect = reconnect;
+    _current.powerMode = powerMode;
+    if ((uint8_t)powerMode < POWER_SAVE_MODE_COUNT) {
+        LatencyHistogram* ready = _current.radioWasOff ? _readyFromOff : _readyByMode;
+        ready[(uint8_t)powerMode].add(total);
+    }
+
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        if (_current.phase[i] != 0 || i == (uint8_t)ConnectPhase::TOTAL) {
+            _histograms[i].add(_current.phase[i]);
+        }
+    }
+
+    _last = _current;
+    _current = ConnectTimeline();
+}
+
+void ConnectTiming::failed() {
+    _failures++;
+    _current = ConnectTimeline();
+}
+
+bool ConnectTiming::firstPacket(uint32_t now) {
+    if (_last.completedAt == 0 || _last.firstPacketSeen) {
+        return false;
+    }
+
+    uint32_t elapsed = now - _last.completedAt;
+    _last.phase[(uint8_t)ConnectPhase::FIRST_PACKET] = elapsed;
+    _last.firstPacketSeen = true;
+    _histograms[(uint8_t)ConnectPhase::FIRST_PACKET].add(elapsed);
+    return true;
+}
+
+void ConnectTiming::clear() {
+    _current = ConnectTimeline();
+    _last = ConnectTimeline();
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        _histograms[i].clear();
+    }
+    for (uint8_t i = 0; i < POWER_SAVE_MODE_COUNT; i++) {
+        _readyByMode[i].clear();
+        _readyFromOff[i].clear();
+    }
+    _failures = 0;
+}
+
+const LatencyHistogram& ConnectTiming::getHistogram(ConnectPhase phase) const {
+    uint8_t index = (uint8_t)phase;
+    return _histograms[index < CONNECT_PHASE_COUNT ? index : (uint8_t)ConnectPhase::TOTAL];
+}
+
+const LatencyHistogram& ConnectTiming::getReadyHistogram(PowerSaveMode mode, bool fromRadioOff) const {
+    uint8_t index = (uint8_t)mode;
+    const LatencyHistogram* ready = fromRadioOff ? _readyFromOff : _readyByMode;
+    return ready[index < POWER_SAVE_MODE_COUNT ? index : (uint8_t)PowerSaveMode::BALANCED];
+}
+
+const char* ConnectTiming::getPhaseName(ConnectPhase phase) {
+    switch (phase) {
+        case ConnectPhase::RADIO_ON: return "radio_on";
+        case ConnectPhase::SCAN: return "scan";
+        case ConnectPhase::MODE_SET: return "mode_set";
+        case ConnectPhase::ASSOCIATE: return "associate";
+        case ConnectPhase::DHCP: return "dhcp";
+        case ConnectPhase::FIRST_PACKET: return "first_packet";
+        case ConnectPhase::TOTAL: return "total";
+        default: return "unknown";
+    }
+}
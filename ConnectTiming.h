@@ -0,0 +1,100 @@
+/**
+ * ConnectTiming - Per-phase connection latency records and histograms
+ *
+ * Every connect and reconnect is broken into the phases of the connection
+ * state machine. The last attempt is kept in full; each phase also feeds a
+ * fixed-size histogram so min/avg/p95 can be compared across firmware
+ * versions and access points without storing individual samples.
+ */
+
+#ifndef CONNECT_TIMING_H
+#define CONNECT_TIMING_H
+
+#include <Arduino.h>
+#include "PowerPolicy.h"
+
+enum class ConnectPhase : uint8_t {
+    RADIO_ON,      // Powering the radio back up after a duty-cycle sleep
+    SCAN,          // Looking for saved networks in range
+    MODE_SET,      // Radio settling before the join
+    ASSOCIATE,     // Join issued until associated (all tries, fast connect included)
+    DHCP,          // Associated until an address is assigned
+    FIRST_PACKET,  // Connected until the sketch reports its first packet
+    TOTAL,         // Request until connected, RADIO_ON included; FIRST_PACKET not
+    COUNT
+};
+
+static const uint8_t CONNECT_PHASE_COUNT = (uint8_t)ConnectPhase::COUNT;
+
+// Log-linear buckets: exact below 8 ms, then four per power of two (at most
+// 25% wide) up to 32 s; longer samples land in the last bucket
+class LatencyHistogram {
+public:
+    static const uint8_t BUCKETS = 56;
+
+    LatencyHistogram();
+
+    void add(uint32_t ms);
+    void clear();
+
+    uint32_t getCount() const { return _count; }
+    uint32_t getMin() const { return _count ? _min : 0; }
+    uint32_t getMax() const { return _max; }
+    uint32_t getAverage() const { return _count ? (uint32_t)(_sum / _count) : 0; }
+    uint64_t getSum() const { return _sum; }
+
+    // Upper edge of the bucket holding the percentile, capped at the maximum
+    uint32_t getPercentile(uint8_t percent) const;
+
+private:
+    uint32_t _count;
+    uint32_t _min;
+    uint32_t _max;
+    uint64_t _sum;
+    uint16_t _buckets[BUCKETS];
+
+    static uint8_t bucketFor(uint32_t ms);
+    static uint32_t bucketUpperBound(uint8_t bucket);
+};
+
+struct ConnectTimeline {
+    uint32_t phase[CONNECT_PHASE_COUNT] = {};  // ms per phase, 0 if skipped
+    uint32_t completedAt = 0;                  // millis() when connected
+    bool fast = false;                         // Joined from the fast-connect cache
+    bool reconnect = false;                    // Started by the reconnect scheduler
+    bool firstPacketSeen = false;
+    bool radioWasOff = false;                  // Started from a powered-down radio
+    PowerSaveMode powerMode = PowerSaveMode::BALANCED;  // Radio power-save mode in effect
+};
+
+class ConnectTiming {
+public:
+    ConnectTiming();
+
+    // Recording, driven by the connection state machine
+    void addPhase(ConnectPhase phase, uint32_t ms);
+    void completed(uint32_t now, uint32_t total, bool fast, bool reconnect, PowerSaveMode powerMode);
+    void failed();
+    bool firstPacket(uint32_t now);  // false unless a connect awaits its first packet
+    void clear();
+
+    const ConnectTimeline& getLast() const { return _last; }
+    const LatencyHistogram& getHistogram(ConnectPhase phase) const;
+    // Request-to-connected times split by power-save mode, and by whether
+    // the radio had to be powered up first (wake cost included)
+    const LatencyHistogram& getReadyHistogram(PowerSaveMode mode, bool fromRadioOff = false) const;
+    uint32_t getConnects() const { return _histograms[(uint8_t)ConnectPhase::TOTAL].getCount(); }
+    uint32_t getFailures() const { return _failures; }
+
+    static const char* getPhaseName(ConnectPhase phase);
+
+private:
+    ConnectTimeline _current;
+    ConnectTimeline _last;
+    LatencyHistogram _histograms[CONNECT_PHASE_COUNT];
+    LatencyHistogram _readyByMode[POWER_SAVE_MODE_COUNT];
+    LatencyHistogram _readyFromOff[POWER_SAVE_MODE_COUNT];
+    uint32_t _failures;
+};
+
+#endif // CONNECT_TIMING_H
@@ -0,0 +1,53 @@
+/**
+ * Crc32 - Table-driven CRC-32 (IEEE 802.3, reflected, as used by zlib)
+ *
+ * The 256-entry table is built at compile time and lives in flash, so
+ * there is no startup cost and no RAM taken.
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <Arduino.h>
+
+static constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+static constexpr uint32_t CRC32_INITIAL = 0xFFFFFFFF;
+
+struct Crc32Table {
+    uint32_t entries[256];
+
+    constexpr Crc32Table() : entries() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (uint8_t bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLYNOMIAL : crc >> 1;
+            }
+            entries[i] = crc;
+        }
+    }
+};
+
+inline constexpr Crc32Table CRC32_TABLE{};
+
+// Feed data in pieces: start from CRC32_INITIAL and pass the result of the
+// previous call; finish with crc32Final()
+inline uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        crc = CRC32_TABLE.entries[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+inline uint32_t crc32Final(uint32_t crc) {
+    return crc ^ 0xFFFFFFFF;
+}
+
+inline uint32_t crc32(const uint8_t* data, size_t length) {
+    return crc32Final(crc32Update(CRC32_INITIAL, data, length));
+}
+
+// Check value from the CRC catalogue, verified at compile time
+static_assert(CRC32_TABLE.entries[1] == 0x77073096 && CRC32_TABLE.entries[255] == 0x2D02EF8D,
+              "CRC32 table generated incorrectly");
+
+#endif // CRC32_H
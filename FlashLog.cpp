@@ -0,0 +1,281 @@
+/**
+ * FlashLog - Append-only flash record store implementation
+ */
+
+#include "FlashLog.h"
+#include <pico/multicore.h>
+#include "PicoWiFiHAL.h"
+
+FlashLockout::FlashLockout()
+    : _active(multicore_lockout_victim_is_initialized(get_core_num() ^ 1)) {
+    if (_active) multicore_lockout_start_blocking();
+}
+
+FlashLockout::~FlashLockout() {
+    if (_active) multicore_lockout_end_blocking();
+}
+
+FlashLog::FlashLog()
+    : _start(0)
+    , _sectorCount(0)
+    , _current(0)
+    , _writePage(0)
+    , _sequence(0)
+    , _eraseCount(0) {
+    memset(_index, 0, sizeof(_index));
+}
+
+bool FlashLog::begin(uintptr_t start, uint8_t sectors) {
+    _sectorCount = 0;
+
+    if (sectors < 2 || (start % FLASH_SECTOR_SIZE) != 0) {
+        return false;
+    }
+
+    _start = start;
+    _sectorCount = sectors;
+
+    // The sector sealed last holds the complete current state
+    int newest = -1;
+    uint32_t newestSequence = 0;
+    for (uint8_t sector = 0; sector < _sectorCount; sector++) {
+        uint32_t sequence;
+        if (scanSector(sector, sequence) &&
+            (newest < 0 || (int32_t)(sequence - newestSequence) > 0)) {
+            newest = sector;
+            newestSequence = sequence;
+        }
+    }
+
+    if (newest < 0) {
+        return format();
+    }
+
+    _current = newest;
+    _sequence = newestSequence;
+    replaySector(_current);
+    return true;
+}
+
+bool FlashLog::read(uint8_t key, void* data, size_t length) const {
+    if (key >= MAX_KEYS || !_index[key] || _index[key]->length != length) {
+        return false;
+    }
+
+    memcpy(data, _index[key] + 1, length);
+    return true;
+}
+
+bool FlashLog::contains(uint8_t key) const {
+    return key < MAX_KEYS && _index[key] != nullptr;
+}
+
+bool FlashLog::append(uint8_t key, const void* data, size_t length) {
+    if (!isReady() || key >= MAX_KEYS || length > 0xFFFF) {
+        return false;
+    }
+
+    // Rewriting identical bytes would only burn a page
+    const RecordHeader* current = _index[key];
+    if (current && current->length == length && memcmp(current + 1, data, length) == 0) {
+        return true;
+    }
+
+    uint16_t pages = pagesFor(length);
+    if (_writePage + pages > PAGES_PER_SECTOR && !compact(pages)) {
+        return false;
+    }
+
+    const RecordHeader* written = writeRecord(_current, _writePage, key, (const uint8_t*)data, length);
+    if (!written) {
+        return false;
+    }
+
+    _index[key] = written;
+    return true;
+}
+
+bool FlashLog::format() {
+    if (_sectorCount == 0) return false;
+
+    for (uint8_t sector = 0; sector < _sectorCount; sector++) {
+        erase(sector);
+    }
+
+    memset(_index, 0, sizeof(_index));
+    _current = 0;
+    _writePage = 0;
+
+    if (!writeRecord(_current, _writePage, SEAL_KEY, nullptr, 0)) {
+        _sectorCount = 0;
+        return false;
+    }
+    return true;
+}
+
+// Private methods
+const uint8_t* FlashLog::pageAddress(uint8_t sector, uint16_t page) const {
+    return (const uint8_t*)(_start + (uintptr_t)sector * FLASH_SECTOR_SIZE + (uintptr_t)page * FLASH_PAGE_SIZE);
+}
+
+uint16_t FlashLog::pagesFor(size_t length) {
+    return (sizeof(RecordHeader) + length + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
+}
+
+bool FlashLog::isErased(const uint8_t* page) {
+    const uint32_t* words = (const uint32_t*)page;
+    for (size_t i = 0; i < FLASH_PAGE_SIZE / sizeof(uint32_t); i++) {
+        if (words[i] != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+uint32_t FlashLog::checksum(const RecordHeader& header, const uint8_t* payload) {
+    // CRC32 over the header (minus the checksum itself) and the payload
+    uint32_t crc = crc32Update(CRC32_INITIAL, (const uint8_t*)&header, offsetof(RecordHeader, checksum));
+    crc = crc32Update(crc, payload, header.length);
+    return crc32Final(crc);
+}
+
+bool FlashLog::isValid(const RecordHeader* header, uint16_t pagesLeft) const {
+    if (header->magic != RECORD_MAGIC) return false;
+    if (header->key >= MAX_KEYS && header->key != SEAL_KEY) return false;
+    if (pagesFor(header->length) > pagesLeft) return false;
+
+    // A torn write leaves a record whose checksum doesn't match
+    return header->checksum == checksum(*header, (const uint8_t*)(header + 1));
+}
+
+bool FlashLog::scanSector(uint8_t sector, uint32_t& sealSequence) const {
+    for (uint16_t page = 0; page < PAGES_PER_SECTOR;) {
+        const uint8_t* address = pageAddress(sector, page);
+        if (isErased(address)) {
+            break;
+        }
+
+        const RecordHeader* header = (const RecordHeader*)address;
+        if (!isValid(header, PAGES_PER_SECTOR - page)) {
+            page++;
+            continue;
+        }
+
+        if (header->key == SEAL_KEY) {
+            sealSequence = header->sequence;
+            return true;
+        }
+        page += pagesFor(header->length);
+    }
+    return false;
+}
+
+void FlashLog::replaySector(uint8_t sector) {
+    memset(_index, 0, sizeof(_index));
+    _writePage = PAGES_PER_SECTOR;
+
+    for (uint16_t page = 0; page < PAGES_PER_SECTOR;) {
+        const uint8_t* address = pageAddress(sector, page);
+        if (isErased(address)) {
+            _writePage = page;
+            break;
+        }
+
+        const RecordHeader* header = (const RecordHeader*)address;
+        if (!isValid(header, PAGES_PER_SECTOR - page)) {
+            page++; // Skip the torn page; it can't be programmed again
+            continue;
+        }
+
+        if (header->key < MAX_KEYS) {
+            _index[header->key] = header;
+        }
+        if ((int32_t)(header->sequence - _sequence) > 0) {
+            _sequence = header->sequence;
+        }
+        page += pagesFor(header->length);
+    }
+}
+
+bool FlashLog::compact(uint16_t pagesNeeded) {
+    // Every live record sits in the active sector, so the next one in the
+    // ring only holds history and can be erased
+    uint8_t next = (_current + 1) % _sectorCount;
+    erase(next);
+
+    const RecordHeader* index[MAX_KEYS] = {};
+    uint16_t page = 0;
+
+    for (uint8_t key = 0; key < MAX_KEYS; key++) {
+        const RecordHeader* live = _index[key];
+        if (!live) continue;
+
+        // Leave a page for the seal
+        if (page + pagesFor(live->length) >= PAGES_PER_SECTOR) {
+            return false;
+        }
+
+        index[key] = writeRecord(next, page, key, (const uint8_t*)(live + 1), live->length);
+        if (!index[key]) {
+            return false;
+        }
+    }
+
+    // Until the seal lands the old sector stays authoritative
+    if (!writeRecord(next, page, SEAL_KEY, nullptr, 0)) {
+        return false;
+    }
+
+    _current = next;
+    _writePage = page;
+    memcpy(_index, index, sizeof(_index));
+
+    return _writePage + pagesNeeded <= PAGES_PER_SECTOR;
+}
+
+const FlashLog::RecordHeader* FlashLog::writeRecord(uint8_t sector, uint16_t& page, uint8_t key,
+                                                    const uint8_t* data, size_t length) {
+    RecordHeader header;
+    header.magic = RECORD_MAGIC;
+    header.sequence = _sequence + 1;
+    header.length = length;
+    header.key = key;
+    header.reserved = 0;
+    header.checksum = checksum(header, data);
+
+    uint16_t pages = pagesFor(length);
+    const uint8_t* address = pageAddress(sector, page);
+    program((uintptr_t)address, (const uint8_t*)&header, sizeof(header), data, length);
+
+    // The page is used either way; a failed read-back is simply skipped later
+    page += pages;
+    _sequence = header.sequence;
+
+    const RecordHeader* written = (const RecordHeader*)address;
+    return isValid(written, pages) ? written : nullptr;
+}
+
+void FlashLog::erase(uint8_t sector) {
+    eraseSector((uintptr_t)pageAddress(sector, 0));
+    _eraseCount++;
+}
+
+void FlashLog::eraseSector(uintptr_t address) {
+    PicoWiFiHAL::flash().eraseSector(address);
+}
+
+void FlashLog::program(uintptr_t address, const uint8_t* head, size_t headLength,
+                       const uint8_t* body, size_t bodyLength) {
+    // Flash can't be read while it is programmed, so every page is staged
+    // in RAM first (the source may itself live in flash)
+    static uint8_t buffer[FLASH_PAGE_SIZE]; // Kept off the (core 1) stack
+
+    size_t total = headLength + bodyLength;
+    for (size_t position = 0; position < total; address += FLASH_PAGE_SIZE) {
+        memset(buffer, 0xFF, sizeof(buffer));
+
+        for (size_t n = 0; n < FLASH_PAGE_SIZE && position < total; n++, position++) {
+            buffer[n] = position < headLength ? head[position] : body[position - headLength];
+        }
+
+        PicoWiFiHAL::flash().programPage(address, buffer);
+    }
+}
@@ -0,0 +1,102 @@
+/**
+ * FlashLog - Append-only record store over a ring of flash sectors
+ *
+ * Each save programs one 256-byte page instead of erasing and rewriting a
+ * whole 4 KB sector. Records are keyed; the newest record of a key wins.
+ * When the active sector fills up, the live records are copied into the
+ * next sector of the ring, which is then sealed, so erases are spread
+ * evenly over all sectors and a power cut never loses the previous state.
+ */
+
+#ifndef FLASH_LOG_H
+#define FLASH_LOG_H
+
+#include <Arduino.h>
+#include <hardware/flash.h>
+#include "Crc32.h"
+
+// Keeps the other core from executing out of flash while it is erased or
+// programmed. Only needed when that core runs library code (dual-core mode).
+class FlashLockout {
+public:
+    FlashLockout();
+    ~FlashLockout();
+
+private:
+    bool _active;
+};
+
+class FlashLog {
+public:
+    static const uint8_t MAX_KEYS = 16;
+
+    FlashLog();
+
+    // start must be sector aligned (inside the FlashDriver region); needs at
+    // least 2 sectors
+    bool begin(uintptr_t start, uint8_t sectors);
+    bool isReady() const { return _sectorCount != 0; }
+
+    // Copies the newest record of key; false if absent or of another size
+    bool read(uint8_t key, void* data, size_t length) const;
+    bool contains(uint8_t key) const;
+
+    // Appends a record unless the newest one already holds the same bytes
+    bool append(uint8_t key, const void* data, size_t length);
+
+    // Erases the whole ring and starts over empty
+    bool format();
+
+    // Diagnostics
+    uint8_t getActiveSector() const { return _current; }
+    uint16_t getFreePages() const { return PAGES_PER_SECTOR - _writePage; }
+    uint32_t getSequence() const { return _sequence; }
+    uint32_t getEraseCount() const { return _eraseCount; }
+    size_t getSize() const { return (size_t)_sectorCount * FLASH_SECTOR_SIZE; }
+
+    // Raw flash access shared with other flash-backed stores, through
+    // PicoWiFiHAL::flash(). Programming pads the last page with 0xFF.
+    static void eraseSector(uintptr_t address);
+    static void program(uintptr_t address, const uint8_t* head, size_t headLength,
+                        const uint8_t* body, size_t bodyLength);
+
+private:
+    struct RecordHeader {
+        uint32_t magic;
+        uint32_t sequence;
+        uint16_t length;
+        uint8_t key;
+        uint8_t reserved;
+        uint32_t checksum;
+    };
+
+    static const uint32_t RECORD_MAGIC = 0x474C5750;  // "PWLG"
+    static const uint8_t SEAL_KEY = 0xFF;             // Marks a complete sector
+    static const uint16_t PAGES_PER_SECTOR = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+
+    uintptr_t _start;
+    uint8_t _sectorCount;
+    uint8_t _current;
+    uint16_t _writePage;
+    uint32_t _sequence;
+    uint32_t _eraseCount;
+    const RecordHeader* _index[MAX_KEYS];
+
+    // Layout helpers
+    const uint8_t* pageAddress(uint8_t sector, uint16_t page) const;
+    static uint16_t pagesFor(size_t length);
+    static bool isErased(const uint8_t* page);
+    static uint32_t checksum(const RecordHeader& header, const uint8_t* payload);
+    bool isValid(const RecordHeader* header, uint16_t pagesLeft) const;
+
+    // Sector handling
+    bool scanSector(uint8_t sector, uint32_t& firstSequence) const;
+    void replaySector(uint8_t sector);
+    bool compact(uint16_t pagesNeeded);
+
+    const RecordHeader* writeRecord(uint8_t sector, uint16_t& page, uint8_t key,
+                                    const uint8_t* data, size_t length);
+    void erase(uint8_t sector);
+};
+
+#endif // FLASH_LOG_H
@@ -0,0 +1,104 @@
+/**
+ * InplaceFunction - Fixed-size, never-allocating callable wrapper
+ *
+ * A drop-in for std::function in callback slots. The callable is stored
+ * inside the object; one that doesn't fit fails to compile instead of
+ * silently moving to the heap. The default capacity holds a lambda that
+ * captures this plus three more pointers.
+ */
+
+#ifndef INPLACE_FUNCTION_H
+#define INPLACE_FUNCTION_H
+
+#include <Arduino.h>
+#include <new>
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+template <typename Signature, size_t Capacity = 4 * sizeof(void*)>
+class InplaceFunction;
+
+template <typename R, typename... Args, size_t Capacity>
+class InplaceFunction<R(Args...), Capacity> {
+public:
+    InplaceFunction() : _invoke(nullptr), _manage(nullptr) {}
+    InplaceFunction(std::nullptr_t) : InplaceFunction() {}
+
+    template <typename F, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, InplaceFunction>::value>::type>
+    InplaceFunction(F&& callable) : InplaceFunction() {
+        typedef typename std::decay<F>::type Callable;
+        static_assert(sizeof(Callable) <= Capacity,
+                      "Callable too large for InplaceFunction: capture less or raise the capacity");
+        static_assert(alignof(Callable) <= alignof(max_align_t), "Callable over-aligned");
+
+        new (_storage) Callable(std::forward<F>(callable));
+        _invoke = &invoke<Callable>;
+        _manage = &manage<Callable>;
+    }
+
+    InplaceFunction(const InplaceFunction& other) : InplaceFunction() {
+        copyFrom(other);
+    }
+
+    InplaceFunction& operator=(const InplaceFunction& other) {
+        if (this != &other) {
+            reset();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    InplaceFunction& operator=(std::nullptr_t) {
+        reset();
+        return *this;
+    }
+
+    ~InplaceFunction() { reset(); }
+
+    explicit operator bool() const { return _invoke != nullptr; }
+
+    R operator()(Args... args) const {
+        return _invoke(_storage, std::forward<Args>(args)...);
+    }
+
+private:
+    enum class Operation : uint8_t { COPY, DESTROY };
+
+    alignas(max_align_t) mutable uint8_t _storage[Capacity];
+    R (*_invoke)(void* storage, Args&&... args);
+    void (*_manage)(Operation operation, void* target, const void* source);
+
+    template <typename Callable>
+    static R invoke(void* storage, Args&&... args) {
+        return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...);
+    }
+
+    template <typename Callable>
+    static void manage(Operation operation, void* target, const void* source) {
+        if (operation == Operation::COPY) {
+            new (target) Callable(*static_cast<const Callable*>(source));
+        } else {
+            static_cast<Callable*>(target)->~Callable();
+        }
+    }
+
+    void copyFrom(const InplaceFunction& other) {
+        if (other._manage) {
+            other._manage(Operation::COPY, _storage, other._storage);
+            _invoke = other._invoke;
+            _manage = other._manage;
+        }
+    }
+
+    void reset() {
+        if (_manage) {
+            _manage(Operation::DESTROY, _storage, nullptr);
+        }
+        _invoke = nullptr;
+        _manage = nullptr;
+    }
+};
+
+#endif // INPLACE_FUNCTION_H
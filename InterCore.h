@@ -0,0 +1,118 @@
+/**
+ * InterCore - Lock-free primitives for sharing state between Pico cores
+ *
+ * SpscQueue: fixed-size single-producer/single-consumer ring buffer
+ * SeqLock:   single-writer snapshot that readers copy without locking
+ *
+ * Both only need plain atomic loads and stores, which are lock-free on
+ * the Cortex-M0+ (RP2040) as well as the Cortex-M33 (RP2350).
+ */
+
+#ifndef INTER_CORE_H
+#define INTER_CORE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <type_traits>
+
+template <typename T, size_t N>
+class SpscQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+    SpscQueue() : _head(0), _tail(0), _dropped(0) {}
+    
+    // Producer side. Returns false (and counts the drop) when full.
+    bool push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t tail = _tail.load(std::memory_order_acquire);
+        
+        if (head - tail >= N) {
+            _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+        
+        _items[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    // Consumer side. Returns false when empty.
+    bool pop(T& item) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        uint32_t head = _head.load(std::memory_order_acquire);
+        
+        if (head == tail) {
+            return false;
+        }
+        
+        item = _items[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    bool isEmpty() const {
+        return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+    }
+    
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    
+    uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T _items[N];
+    std::atomic<uint32_t> _head;
+    std::atomic<uint32_t> _tail;
+    std::atomic<uint32_t> _dropped;
+};
+
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock values are copied byte-wise");
+
+public:
+    SeqLock() : _sequence(0), _value() {}
+    
+    // Writer side (one writer only)
+    void write(const T& value) {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        
+        _value = value;
+        
+        std::atomic_thread_fence(std::memory_order_release);
+        _sequence.store(sequence + 2, std::memory_order_relaxed);
+    }
+    
+    // Reader side. Returns false if the writer kept the value busy for
+    // maxRetries attempts; out is left untouched in that case.
+    bool read(T& out, uint8_t maxRetries = 16) const {
+        for (uint8_t attempt = 0; attempt < maxRetries; attempt++) {
+            uint32_t before = _sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                continue; // Write in progress
+            }
+            
+            T copy = _value;
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == before) {
+                out = copy;
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    uint32_t getSequence() const { return _sequence.load(std::memory_order_acquire); }
+
+private:
+    std::atomic<uint32_t> _sequence;
+    T _value;
+};
+
+#endif // INTER_CORE_H
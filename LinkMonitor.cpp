@@ -0,0 +1,60 @@
+/**
+ * LinkMonitor - Implementation
+ */
+
+#include "LinkMonitor.h"
+
+LinkMonitor::LinkMonitor()
+    : _average(0)
+    , _primed(false)
+    , _lastSample(0)
+    , _degradedSince(0)
+    , _lastScan(0) {
+}
+
+void LinkMonitor::reset() {
+    _average = 0;
+    _primed = false;
+    _quality.rssi = 0;
+    _quality.degraded = false;
+    _degradedSince = 0;
+}
+
+bool LinkMonitor::sample(uint32_t now, int32_t rssi) {
+    _lastSample = now;
+
+    // The driver reports 0 while it has no measurement
+    if (rssi >= 0) {
+        return false;
+    }
+
+    if (!_primed) {
+        _average = rssi * 16;
+        _primed = true;
+    } else {
+        _average += (rssi * 16 - _average) * _config.smoothingPercent / 100;
+    }
+    _quality.rssi = (int8_t)(_average / 16);
+
+    if (!_quality.degraded && _quality.rssi < _config.weakThreshold) {
+        _quality.degraded = true;
+        _degradedSince = now;
+    } else if (_quality.degraded && _quality.rssi >= _config.weakThreshold + _config.hysteresis) {
+        _quality.degraded = false;
+    }
+
+    if (!_quality.degraded || now - _degradedSince < _config.degradedTime) {
+        return false;
+    }
+    if (_quality.roamScans > 0 && now - _lastScan < _config.scanInterval) {
+        return false;
+    }
+
+    _lastScan = now;
+    _quality.roamScans++;
+    return true;
+}
+
+bool LinkMonitor::isBetter(int32_t candidateRSSI) const {
+    return candidateRSSI >= _quality.rssi + _config.minImprovement;
+}
@@ -0,0 +1,65 @@
+/**
+ * LinkMonitor - RSSI smoothing and roaming decisions for PicoWiFiManager
+ *
+ * Samples are smoothed with an exponentially weighted moving average so a
+ * single faded beacon doesn't count as a bad link. The link is degraded
+ * once the average drops below weakThreshold and recovers only after it
+ * climbs hysteresis dB above it; a roaming scan is requested when the
+ * degradation has lasted degradedTime.
+ */
+
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <Arduino.h>
+
+struct RoamingConfig {
+    bool enabled = false;
+    uint16_t sampleInterval = 1000;  // ms between RSSI samples
+    uint8_t smoothingPercent = 20;   // Weight of a new sample in the average
+    int8_t weakThreshold = -75;      // dBm: below this the link is degraded...
+    uint8_t hysteresis = 5;          // ...until it is this many dB above it again
+    uint16_t degradedTime = 5000;    // ms of sustained degradation before scanning
+    uint8_t minImprovement = 8;      // dB a candidate AP must beat the current one by
+    uint32_t scanInterval = 30000;   // Minimum ms between roaming scans
+};
+
+struct LinkQuality {
+    int8_t rssi = 0;                 // Filtered; 0 when unknown
+    bool degraded = false;
+    uint32_t roamScans = 0;
+    uint32_t roams = 0;
+};
+
+class LinkMonitor {
+public:
+    LinkMonitor();
+
+    void setConfig(const RoamingConfig& config) { _config = config; }
+    const RoamingConfig& getConfig() const { return _config; }
+
+    // Start over on a new association
+    void reset();
+
+    // Feed one sample; returns true when a roaming scan should start
+    bool sample(uint32_t now, int32_t rssi);
+    bool isSampleDue(uint32_t now) const { return now - _lastSample >= _config.sampleInterval; }
+
+    // A candidate is worth a reassociation only if clearly stronger
+    bool isBetter(int32_t candidateRSSI) const;
+
+    void countRoam() { _quality.roams++; }
+
+    const LinkQuality& getQuality() const { return _quality; }
+
+private:
+    RoamingConfig _config;
+    LinkQuality _quality;
+    int32_t _average;        // dBm scaled by 16
+    bool _primed;
+    uint32_t _lastSample;
+    uint32_t _degradedSince;
+    uint32_t _lastScan;
+};
+
+#endif // LINK_MONITOR_H
@@ -0,0 +1,100 @@
+/**
+ * MemoryMonitor - Implementation
+ */
+
+#include "MemoryMonitor.h"
+#include <pico/stdlib.h>
+
+// Unlikely to be left behind by real stack frames
+static const uint32_t STACK_PAINT = 0xDEADBEEF;
+
+size_t MemoryMonitor::_peakUsed[2] = {0, 0};
+HeapUsage MemoryMonitor::_usage[MEMORY_SUBSYSTEM_COUNT];
+
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+HeapScope* HeapScope::_active[2] = {nullptr, nullptr};
+#endif
+
+size_t MemoryMonitor::sample() {
+    size_t used = rp2040.getUsedHeap();
+    uint8_t core = (uint8_t)get_core_num() & 1;
+    if (used > _peakUsed[core]) {
+        _peakUsed[core] = used;
+    }
+
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+    for (HeapScope* scope = HeapScope::_active[core]; scope; scope = scope->_outer) {
+        if (used > scope->_start && used - scope->_start > scope->_peak) {
+            scope->_peak = used - scope->_start;
+        }
+    }
+#endif
+    return used;
+}
+
+size_t MemoryMonitor::getPeakUsed() {
+    return _peakUsed[0] > _peakUsed[1] ? _peakUsed[0] : _peakUsed[1];
+}
+
+size_t MemoryMonitor::getMinFree() {
+    size_t total = rp2040.getTotalHeap();
+    size_t peak = getPeakUsed();
+    return total > peak ? total - peak : 0;
+}
+
+const HeapUsage& MemoryMonitor::getUsage(MemorySubsystem subsystem) {
+    uint8_t index = (uint8_t)subsystem;
+    return _usage[index < MEMORY_SUBSYSTEM_COUNT ? index : 0];
+}
+
+const char* MemoryMonitor::getSubsystemName(MemorySubsystem subsystem) {
+    switch (subsystem) {
+        case MemorySubsystem::PORTAL: return "portal";
+        case MemorySubsystem::SCAN: return "scan";
+        case MemorySubsystem::STORAGE: return "storage";
+        case MemorySubsystem::CALLBACKS: return "callbacks";
+        default: return "unknown";
+    }
+}
+
+void MemoryMonitor::paintStack(uint32_t* stack, size_t words) {
+    for (size_t i = 0; i < words; i++) {
+        stack[i] = STACK_PAINT;
+    }
+}
+
+size_t MemoryMonitor::getStackUsed(const uint32_t* stack, size_t words) {
+    // The lowest overwritten word marks the deepest frame
+    size_t untouched = 0;
+    while (untouched < words && stack[untouched] == STACK_PAINT) {
+        untouched++;
+    }
+    return (words - untouched) * sizeof(uint32_t);
+}
+
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+
+HeapScope::HeapScope(MemorySubsystem subsystem)
+    : _subsystem(subsystem)
+    , _core((uint8_t)get_core_num() & 1)
+    , _start(0)
+    , _peak(0)
+    , _outer(_active[_core]) {
+    _start = MemoryMonitor::sample();
+    _active[_core] = this;
+}
+
+HeapScope::~HeapScope() {
+    size_t used = MemoryMonitor::sample();
+    _active[_core] = _outer;
+
+    HeapUsage& usage = MemoryMonitor::_usage[(uint8_t)_subsystem];
+    usage.calls++;
+    usage.lastChange = (int32_t)used - (int32_t)_start;
+    usage.retained += usage.lastChange;
+    if (_peak > usage.peak) {
+        usage.peak = _peak;
+    }
+}
+
+#endif // PICOWIFI_ENABLE_DIAGNOSTICS
@@ -0,0 +1,104 @@
+/**
+ * MemoryMonitor - Heap high-water marks, per-subsystem accounting and
+ * stack watermarks
+ *
+ * The allocator keeps no history, so the monitor samples the used heap at
+ * points where it is likely to be highest: every loop() pass, each
+ * ChunkedResponse flush and the start and end of every HeapScope. A short
+ * spike between two samples is not seen; the peak is a lower bound.
+ *
+ *     {
+ *         HeapScope scope(MemorySubsystem::STORAGE);
+ *         ...                    // Growth is charged to STORAGE
+ *     }
+ *
+ * Scopes nest; an inner scope also counts towards the outer ones. The heap
+ * is shared, so in dual-core mode allocations made on the other core while
+ * a scope is open are charged to it as well. Without
+ * PICOWIFI_ENABLE_DIAGNOSTICS scopes compile to nothing; the heap and stack
+ * marks are still kept.
+ */
+
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include <Arduino.h>
+#include "PicoWiFiFeatures.h"
+
+enum class MemorySubsystem : uint8_t {
+    PORTAL,        // Portal request handling and page rendering
+    SCAN,          // Blocking scans and processing of background results
+    STORAGE,       // Loading and committing stored networks
+    CALLBACKS,     // Sketch callbacks run from the event dispatcher
+    COUNT
+};
+
+static const uint8_t MEMORY_SUBSYSTEM_COUNT = (uint8_t)MemorySubsystem::COUNT;
+
+struct HeapUsage {
+    uint32_t calls = 0;          // Scopes closed
+    int32_t lastChange = 0;      // Bytes still held when the last scope closed
+    int32_t retained = 0;        // Sum of lastChange over all scopes; growth here is a leak
+    uint32_t peak = 0;           // Largest growth seen inside one scope
+};
+
+class MemoryMonitor {
+public:
+    // Updates the high-water marks and returns the used heap; cheap enough
+    // to call every loop() pass
+    static size_t sample();
+
+    // Since boot, as far as sampled
+    static size_t getPeakUsed();
+    static size_t getMinFree();
+
+    static const HeapUsage& getUsage(MemorySubsystem subsystem);
+    static const char* getSubsystemName(MemorySubsystem subsystem);
+
+    // Fills a stack that has not run yet with a pattern; getStackUsed()
+    // then returns the deepest point it reached, in bytes. Stacks grow
+    // down from the end of the array.
+    static void paintStack(uint32_t* stack, size_t words);
+    static size_t getStackUsed(const uint32_t* stack, size_t words);
+
+private:
+    friend class HeapScope;
+
+    // Written only by the core with that index; readers take the larger
+    static size_t _peakUsed[2];
+    static HeapUsage _usage[MEMORY_SUBSYSTEM_COUNT];
+};
+
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+
+class HeapScope {
+public:
+    explicit HeapScope(MemorySubsystem subsystem);
+    ~HeapScope();
+
+    HeapScope(const HeapScope&) = delete;
+    HeapScope& operator=(const HeapScope&) = delete;
+
+private:
+    friend class MemoryMonitor;
+
+    MemorySubsystem _subsystem;
+    uint8_t _core;
+    size_t _start;
+    size_t _peak;
+    HeapScope* _outer;
+
+    // Innermost open scope per core, for sample()
+    static HeapScope* _active[2];
+};
+
+#else
+
+class HeapScope {
+public:
+    explicit HeapScope(MemorySubsystem) {}
+};
+
+#endif // PICOWIFI_ENABLE_DIAGNOSTICS
+
+#endif // MEMORY_MONITOR_H
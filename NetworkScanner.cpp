@@ -2,13 +2,27 @@
  * NetworkScanner - WiFi Network Scanner Implementation
  */
 
+#include "PicoWiFiFeatures.h"
+
+#if PICOWIFI_ENABLE_SCANNER
+
 #include "NetworkScanner.h"
 #include <algorithm>
+#include "PicoWiFiHAL.h"
+#include "PicoWiFiLog.h"
+#include "MemoryMonitor.h"
+
+#define PICOWIFI_LOG_TAG LogTag::SCANNER
+
 
 NetworkScanner::NetworkScanner() 
-    : _lastScanTime(0)
+    : _networkCount(0)
+    , _lastScanTime(0)
     , _scanInProgress(false)
-    , _asyncScanStarted(false) {
+    , _asyncScanStarted(false)
+    , _scanAbandoned(false)
+    , _scanStartTime(0)
+    , _pendingCount(0) {
     _config = ScanConfig(); // Use defaults
 }
 
@@ -20,65 +34,135 @@ void NetworkScanner::setConfig(const ScanConfig& config) {
 }
 
 bool NetworkScanner::startScan() {
-    if (_scanInProgress) {
+    // A timed-out background scan still owns the radio until it finishes
+    update();
+    if (_scanInProgress || _asyncScanStarted) {
         return false;
     }
     
     _scanInProgress = true;
+    _scanStartTime = millis();
     _lastError = "";
     
     return performScan();
 }
 
 bool NetworkScanner::startAsyncScan() {
-    // For simplicity, use synchronous scan
-    // Pico may not support async WiFi scanning
-    return startScan();
+    if (!_config.async) {
+        return startScan();
+    }
+    
+    update();
+    if (_scanInProgress || _asyncScanStarted) {
+        return false;
+    }
+    
+    clearError();
+    _pendingCount = 0;
+    
+    // Results arrive through scanResultSink(); update() collects them
+    int err = PicoWiFiHAL::wifi().startAsyncScan(scanResultSink, this);
+    
+    if (err != 0) {
+        // The driver refuses to scan without the STA interface up. Callers
+        // are on paths that must not block, so there is no blocking fallback
+        PICOWIFI_LOGW("Async scan unavailable (%d)", err);
+        setError("Async scan unavailable");
+        return false;
+    }
+    
+    PICOWIFI_LOGD("Async WiFi scan started");
+    _scanInProgress = true;
+    _asyncScanStarted = true;
+    _scanStartTime = millis();
+    return true;
 }
 
 bool NetworkScanner::isScanComplete() {
+    update();
     return !_scanInProgress;
 }
 
 bool NetworkScanner::isScanInProgress() {
+    update();
     return _scanInProgress;
 }
 
-std::vector<ScannedNetwork> NetworkScanner::getResults(bool forceRescan) {
+void NetworkScanner::update() {
+    if (!_asyncScanStarted) {
+        return;
+    }
+    
+    if (PicoWiFiHAL::wifi().isAsyncScanActive()) {
+        if (!_scanAbandoned && millis() - _scanStartTime > ASYNC_SCAN_TIMEOUT) {
+            // The driver's scan can't be cancelled. Waiters give up now, but
+            // no new scan starts until this one has ended
+            _scanAbandoned = true;
+            _scanInProgress = false;
+            _stats.failures++;
+            setError("Scan timed out");
+        }
+        return;
+    }
+    
+    _asyncScanStarted = false;
+    if (_scanAbandoned) {
+        _scanAbandoned = false;
+        return;
+    }
+    processScanResults();
+}
+
+NetworkList NetworkScanner::getResults(bool forceRescan) {
     if (forceRescan || !isCacheValid()) {
         startScan();
     }
     
-    return _networks;
+    return getCachedResults();
+}
+
+NetworkList NetworkScanner::getCachedResults() const {
+    NetworkList list;
+    list.data = _networks;
+    list.count = _networkCount;
+    return list;
 }
 
 int NetworkScanner::getNetworkCount() {
-    return _networks.size();
+    return _networkCount;
 }
 
 ScannedNetwork NetworkScanner::getNetwork(int index) {
-    if (index >= 0 && index < _networks.size()) {
+    if (index >= 0 && index < _networkCount) {
         return _networks[index];
     }
     return ScannedNetwork();
 }
 
-bool NetworkScanner::findNetwork(const String& ssid, ScannedNetwork& network) {
-    for (const auto& net : _networks) {
-        if (net.ssid.equals(ssid)) {
-            network = net;
-            return true;
+bool NetworkScanner::findNetwork(const char* ssid, ScannedNetwork& network) {
+    if (!ssid) return false;
+    
+    // With duplicates kept, several access points of one ESS may match
+    const ScannedNetwork* best = nullptr;
+    for (uint8_t i = 0; i < _networkCount; i++) {
+        if (strcmp(_networks[i].ssid, ssid) == 0 &&
+            (!best || _networks[i].rssi > best->rssi)) {
+            best = &_networks[i];
         }
     }
-    return false;
+    
+    if (!best) return false;
+    
+    network = *best;
+    return true;
 }
 
-bool NetworkScanner::isNetworkVisible(const String& ssid) {
+bool NetworkScanner::isNetworkVisible(const char* ssid) {
     ScannedNetwork dummy;
     return findNetwork(ssid, dummy);
 }
 
-int32_t NetworkScanner::getNetworkRSSI(const String& ssid) {
+int32_t NetworkScanner::getNetworkRSSI(const char* ssid) {
     ScannedNetwork network;
     if (findNetwork(ssid, network)) {
         return network.rssi;
@@ -86,43 +170,52 @@ int32_t NetworkScanner::getNetworkRSSI(const String& ssid) {
     return -100; // Very weak signal if not found
 }
 
-void NetworkScanner::filterResults(std::vector<ScannedNetwork>& networks) {
-    auto it = networks.begin();
-    while (it != networks.end()) {
-        if (!shouldIncludeNetwork(*it)) {
-            it = networks.erase(it);
-        } else {
-            ++it;
-        }
-    }
+size_t NetworkScanner::filterResults(ScannedNetwork* networks, size_t count) {
+    ScannedNetwork* end = std::remove_if(networks, networks + count,
+        [this](const ScannedNetwork& network) {
+            return !shouldIncludeNetwork(network);
+        });
+    
+    return end - networks;
 }
 
-void NetworkScanner::sortResults(std::vector<ScannedNetwork>& networks) {
+void NetworkScanner::sortResults(ScannedNetwork* networks, size_t count) {
     if (_config.sortBySignal) {
-        std::sort(networks.begin(), networks.end(), compareBySignal);
+        std::sort(networks, networks + count, compareBySignal);
     } else {
-        std::sort(networks.begin(), networks.end(), compareBySSID);
+        std::sort(networks, networks + count, compareBySSID);
     }
 }
 
-void NetworkScanner::removeDuplicates(std::vector<ScannedNetwork>& networks) {
-    if (!_config.removeDuplicates) return;
+size_t NetworkScanner::removeDuplicates(ScannedNetwork* networks, size_t count) {
+    if (!_config.removeDuplicates) return count;
     
-    auto it = std::unique(networks.begin(), networks.end(),
-        [](const ScannedNetwork& a, const ScannedNetwork& b) {
-            return a.ssid.equals(b.ssid);
-        });
+    // Duplicates need not be adjacent; collapse each SSID onto its strongest AP
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t j = 0;
+        while (j < kept && strcmp(networks[j].ssid, networks[i].ssid) != 0) {
+            j++;
+        }
+        
+        if (j == kept) {
+            networks[kept++] = networks[i];
+        } else if (networks[i].rssi > networks[j].rssi) {
+            networks[j] = networks[i];
+        }
+    }
     
-    networks.erase(it, networks.end());
+    return kept;
 }
 
 void NetworkScanner::clearCache() {
-    _networks.clear();
+    _networkCount = 0;
     _lastScanTime = 0;
 }
 
 bool NetworkScanner::isCacheValid() {
-    return (millis() - _lastScanTime) < _config.cacheTimeout;
+    // Nothing has been scanned yet during the first cacheTimeout after boot
+    return _lastScanTime != 0 && (millis() - _lastScanTime) < _config.cacheTimeout;
 }
 
 uint32_t NetworkScanner::getCacheAge() {
@@ -138,91 +231,149 @@ String NetworkScanner::getLastError() {
 }
 
 void NetworkScanner::printResults() {
-    Serial.printf("=== Network Scan Results (%d networks) ===\n", _networks.size());
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+    Serial.printf("=== Network Scan Results (%d networks) ===\n", _networkCount);
     
-    for (int i = 0; i < _networks.size(); i++) {
+    for (int i = 0; i < _networkCount; i++) {
         const ScannedNetwork& net = _networks[i];
         Serial.printf("%2d: %-20s %4d dBm %3d%% Ch%2d %s %s\n",
             i + 1,
-            net.ssid.c_str(),
+            net.ssid,
             net.rssi,
             net.getSignalQuality(),
             net.channel,
-            net.getSecurityString().c_str(),
+            net.getSecurityString(),
             net.hidden ? "(Hidden)" : ""
         );
     }
     
     Serial.println("==========================================");
+#endif
 }
 
 void NetworkScanner::printDiagnostics() {
+#if PICOWIFI_ENABLE_DIAGNOSTICS
     Serial.println("=== NetworkScanner Diagnostics ===");
     Serial.printf("Scan in progress: %s\n", _scanInProgress ? "Yes" : "No");
-    Serial.printf("Networks found: %d\n", _networks.size());
+    Serial.printf("Networks found: %d\n", _networkCount);
     Serial.printf("Cache valid: %s\n", isCacheValid() ? "Yes" : "No");
     Serial.printf("Cache age: %lu ms\n", getCacheAge());
+    Serial.printf("Scans: %lu (%lu failed), last took %lu ms\n", (unsigned long)_stats.scans,
+                  (unsigned long)_stats.failures, (unsigned long)_stats.lastDuration);
     Serial.printf("Last error: %s\n", _lastError.c_str());
     Serial.println("==================================");
+#endif
 }
 
 // Private methods
 bool NetworkScanner::performScan() {
-    debugPrint("Starting WiFi scan...");
+    HeapScope scope(MemorySubsystem::SCAN);
+    
+    PICOWIFI_LOGD("Starting WiFi scan...");
     
-    int networkCount = WiFi.scanNetworks(_config.showHidden);
+    // Hidden networks are filtered in shouldIncludeNetwork()
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    int networkCount = wifi.scanNetworks();
     
     if (networkCount < 0) {
+        _stats.failures++;
         setError("Scan failed");
         _scanInProgress = false;
         return false;
     }
     
-    debugPrintf("Found %d networks", networkCount);
+    PICOWIFI_LOGD("Found %d networks", networkCount);
+    _stats.lastAccessPoints = networkCount < 255 ? networkCount : 255;
     
-    _networks.clear();
+    _networkCount = 0;
     
-    for (int i = 0; i < networkCount && _networks.size() < _config.maxResults; i++) {
-        ScannedNetwork network;
-        network.ssid = WiFi.SSID(i);
-        network.rssi = WiFi.RSSI(i);
-        network.channel = WiFi.channel(i);
-        network.encType = WiFi.encryptionType(i);
-        uint8_t bssid[6];
-        WiFi.BSSID(bssid);
-        network.bssid = String("");
-        for (int j = 0; j < 6; j++) {
-            if (j > 0) network.bssid += ":";
-            if (bssid[j] < 16) network.bssid += "0";
-            network.bssid += String(bssid[j], HEX);
+    for (int i = 0; i < networkCount && _networkCount < MAX_SCAN_NETWORKS; i++) {
+        ScannedNetwork& network = _networks[_networkCount];
+        if (wifi.getScanResult(i, network) && shouldIncludeNetwork(network)) {
+            _networkCount++;
         }
-        network.bssid.toUpperCase();
-        network.hidden = (network.ssid.length() == 0);
-        
-        if (shouldIncludeNetwork(network)) {
-            _networks.push_back(network);
+    }
+    
+    finishScan();
+    return true;
+}
+
+void NetworkScanner::processScanResults() {
+    HeapScope scope(MemorySubsystem::SCAN);
+    
+    _networkCount = 0;
+    
+    // The driver reports the scan inactive only after its last callback,
+    // so _pending is stable here
+    uint8_t count = _pendingCount;
+    
+    for (uint8_t i = 0; i < count; i++) {
+        if (shouldIncludeNetwork(_pending[i])) {
+            _networks[_networkCount++] = _pending[i];
         }
     }
     
+    PICOWIFI_LOGD("Async scan found %d access points", count);
+    _stats.lastAccessPoints = count;
+    finishScan();
+}
+
+void NetworkScanner::finishScan() {
     // Post-process results
     if (_config.removeDuplicates) {
-        removeDuplicates(_networks);
+        _networkCount = removeDuplicates(_networks, _networkCount);
     }
     
     if (_config.sortBySignal) {
-        sortResults(_networks);
+        sortResults(_networks, _networkCount);
+    }
+    
+    // Truncate last so the strongest access points survive
+    if (_networkCount > _config.maxResults) {
+        _networkCount = _config.maxResults;
     }
     
     _lastScanTime = millis();
     _scanInProgress = false;
     
-    debugPrintf("Scan complete: %d networks after filtering", _networks.size());
+    _stats.scans++;
+    _stats.lastDuration = _lastScanTime - _scanStartTime;
+    _stats.totalDuration += _stats.lastDuration;
+    
+    PICOWIFI_LOGI("Scan complete: %d networks after filtering", _networkCount);
     
     if (_onScanComplete) {
-        _onScanComplete(_networks.size());
+        _onScanComplete(_networkCount);
+    }
+}
+
+void NetworkScanner::accumulateResult(const ScannedNetwork& result) {
+    if (_scanAbandoned) {
+        return;
     }
     
-    return true;
+    // Each BSS is reported once per beacon/probe response; merge by BSSID
+    for (uint8_t i = 0; i < _pendingCount; i++) {
+        if (memcmp(_pending[i].bssid, result.bssid, sizeof(result.bssid)) == 0) {
+            if (result.rssi > _pending[i].rssi) {
+                _pending[i].rssi = result.rssi;
+            }
+            return;
+        }
+    }
+    
+    if (_pendingCount >= MAX_SCAN_NETWORKS) {
+        return;
+    }
+    
+    _pending[_pendingCount] = result;
+    _pendingCount++;
+}
+
+void NetworkScanner::scanResultSink(void* context, const ScannedNetwork& result) {
+    if (context) {
+        static_cast<NetworkScanner*>(context)->accumulateResult(result);
+    }
 }
 
 bool NetworkScanner::shouldIncludeNetwork(const ScannedNetwork& network) {
@@ -244,14 +395,15 @@ bool NetworkScanner::shouldIncludeNetwork(const ScannedNetwork& network) {
     return true;
 }
 
-bool NetworkScanner::validateSSID(const String& ssid) {
-    if (ssid.length() == 0 || ssid.length() > 32) {
+bool NetworkScanner::validateSSID(const char* ssid) {
+    size_t length = strnlen(ssid, 33);
+    if (length == 0 || length > 32) {
         return false;
     }
     
     // Check for valid characters (printable ASCII)
-    for (unsigned int i = 0; i < ssid.length(); i++) {
-        char c = ssid.charAt(i);
+    for (size_t i = 0; i < length; i++) {
+        char c = ssid[i];
         if (c < 32 || c > 126) {
             return false;
         }
@@ -262,7 +414,7 @@ bool NetworkScanner::validateSSID(const String& ssid) {
 
 void NetworkScanner::setError(const String& error) {
     _lastError = error;
-    debugPrint("Error: " + error);
+    PICOWIFI_LOGW("Error: %s", error.c_str());
     
     if (_onScanError) {
         _onScanError(error);
@@ -272,27 +424,13 @@ void NetworkScanner::setError(const String& error) {
 void NetworkScanner::clearError() {
     _lastError = "";
 }
-
-void NetworkScanner::debugPrint(const String& message) {
-    Serial.printf("[NetworkScanner] %s\n", message.c_str());
-}
-
-void NetworkScanner::debugPrintf(const char* format, ...) {
-    va_list args;
-    va_start(args, format);
-    Serial.printf("[NetworkScanner] ");
-    Serial.printf(format, args);
-    Serial.println();
-    va_end(args);
-}
-
 // Static comparison functions
 bool NetworkScanner::compareBySignal(const ScannedNetwork& a, const ScannedNetwork& b) {
     return a.rssi > b.rssi; // Stronger signal first
 }
 
 bool NetworkScanner::compareBySSID(const ScannedNetwork& a, const ScannedNetwork& b) {
-    return a.ssid < b.ssid; // Alphabetical order
+    return strcmp(a.ssid, b.ssid) < 0; // Alphabetical order
 }
 
 // Utility functions
@@ -339,4 +477,6 @@ namespace NetworkUtils {
             default: return "Unknown";
         }
     }
-}
\ No newline at end of file
+}
+
+#endif // PICOWIFI_ENABLE_SCANNER
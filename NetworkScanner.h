@@ -10,24 +10,19 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <vector>
-#include <memory>
+#include "ComponentSlot.h"
+#include "PicoWiFiFeatures.h"
 
-// Network information structure
+// Network information structure (plain data, no heap members)
 struct ScannedNetwork {
-    String ssid;
-    int32_t rssi;
-    uint8_t channel;
-    uint8_t encType;
-    String bssid;
-    bool hidden;
-    
-    ScannedNetwork() : rssi(-100), channel(0), encType(ENC_TYPE_NONE), hidden(false) {}
-    
-    ScannedNetwork(const String& s, int32_t r, uint8_t c, uint8_t e, const String& b, bool h = false)
-        : ssid(s), rssi(r), channel(c), encType(e), bssid(b), hidden(h) {}
-    
-    String getSecurityString() const {
+    char ssid[33] = {0};
+    uint8_t bssid[6] = {0};
+    int8_t rssi = -100;
+    uint8_t channel = 0;
+    uint8_t encType = ENC_TYPE_NONE;
+    bool hidden = false;
+    
+    const char* getSecurityString() const {
         switch (encType) {
             case ENC_TYPE_NONE: return "Open";
             case ENC_TYPE_WEP: return "WEP";
@@ -47,6 +42,40 @@ struct ScannedNetwork {
         if (rssi >= -50) return 100;
         return 2 * (rssi + 100);
     }
+    
+    // Formats the BSSID as "AA:BB:CC:DD:EE:FF" (buffer needs 18 bytes)
+    void formatBSSID(char* buffer, size_t size) const {
+        snprintf(buffer, size, "%02X:%02X:%02X:%02X:%02X:%02X",
+                 bssid[0], bssid[1], bssid[2], bssid[3], bssid[4], bssid[5]);
+    }
+    
+    String getBSSIDString() const {
+        char buffer[18];
+        formatBSSID(buffer, sizeof(buffer));
+        return String(buffer);
+    }
+};
+
+// Running scan counters for diagnostics
+struct ScanStats {
+    uint32_t scans = 0;              // Completed scans, sync and async
+    uint32_t failures = 0;           // Driver errors and timeouts
+    uint32_t lastDuration = 0;       // ms
+    uint32_t totalDuration = 0;      // ms over all completed scans
+    uint8_t lastAccessPoints = 0;    // Before filtering
+};
+
+// Read-only view over scan results owned by NetworkScanner. It stays valid
+// until the next scan completes.
+struct NetworkList {
+    const ScannedNetwork* data = nullptr;
+    size_t count = 0;
+    
+    const ScannedNetwork* begin() const { return data; }
+    const ScannedNetwork* end() const { return data + count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const ScannedNetwork& operator[](size_t index) const { return data[index]; }
 };
 
 // Scan configuration
@@ -66,6 +95,9 @@ struct ScanConfig {
 
 class NetworkScanner {
 public:
+    static const int MAX_SCAN_NETWORKS = 50;
+    static const uint32_t ASYNC_SCAN_TIMEOUT = 10000;
+    
     NetworkScanner();
     ~NetworkScanner();
     
@@ -75,30 +107,38 @@ public:
     
     // Scanning operations
     bool startScan();
+    // Never blocks (unless config.async is off); false while a scan runs or
+    // if the driver refuses, e.g. with the STA interface down
     bool startAsyncScan();
     bool isScanComplete();
     bool isScanInProgress();
     
-    // Results retrieval
-    std::vector<ScannedNetwork> getResults(bool forceRescan = false);
+    // Collects async scan results; call regularly (PicoWiFiManager::loop() does)
+    void update();
+    
+    // Results retrieval (views into the internal result array, no copies)
+    NetworkList getResults(bool forceRescan = false);
+    NetworkList getCachedResults() const;
     int getNetworkCount();
     ScannedNetwork getNetwork(int index);
     
-    // Network lookup
-    bool findNetwork(const String& ssid, ScannedNetwork& network);
-    bool isNetworkVisible(const String& ssid);
-    int32_t getNetworkRSSI(const String& ssid);
+    // Network lookup (returns the strongest BSSID advertising the SSID)
+    bool findNetwork(const char* ssid, ScannedNetwork& network);
+    bool isNetworkVisible(const char* ssid);
+    int32_t getNetworkRSSI(const char* ssid);
     
-    // Filtering and sorting
-    void filterResults(std::vector<ScannedNetwork>& networks);
-    void sortResults(std::vector<ScannedNetwork>& networks);
-    void removeDuplicates(std::vector<ScannedNetwork>& networks);
+    // Filtering and sorting (in place; return the new count)
+    size_t filterResults(ScannedNetwork* networks, size_t count);
+    void sortResults(ScannedNetwork* networks, size_t count);
+    size_t removeDuplicates(ScannedNetwork* networks, size_t count);  // Keeps the strongest BSSID per SSID
     
     // Cache management
     void clearCache();
     bool isCacheValid();
     uint32_t getCacheAge();
     
+    const ScanStats& getStats() const { return _stats; }
+    
     // Status and diagnostics
     bool isAvailable();
     String getLastError();
@@ -106,20 +146,28 @@ public:
     void printDiagnostics();
     
     // Callbacks
-    typedef std::function<void(int networkCount)> ScanCompleteCallback;
-    typedef std::function<void(const String& error)> ScanErrorCallback;
+    typedef CallbackFunction<void(int networkCount)> ScanCompleteCallback;
+    typedef CallbackFunction<void(const String& error)> ScanErrorCallback;
     
     void onScanComplete(ScanCompleteCallback callback) { _onScanComplete = callback; }
     void onScanError(ScanErrorCallback callback) { _onScanError = callback; }
 
 private:
     ScanConfig _config;
-    std::vector<ScannedNetwork> _networks;
+    ScannedNetwork _networks[MAX_SCAN_NETWORKS];
+    uint8_t _networkCount;
     uint32_t _lastScanTime;
     bool _scanInProgress;
-    bool _asyncScanStarted;
+    bool _asyncScanStarted;          // Until the driver's scan has finished
+    volatile bool _scanAbandoned;    // Timed out; late results are dropped
+    uint32_t _scanStartTime;
+    ScanStats _stats;
     String _lastError;
     
+    // Raw BSS entries filled in by the driver's scan callback
+    ScannedNetwork _pending[MAX_SCAN_NETWORKS];
+    volatile uint8_t _pendingCount;
+    
     // Callbacks
     ScanCompleteCallback _onScanComplete;
     ScanErrorCallback _onScanError;
@@ -127,7 +175,10 @@ private:
     // Internal operations
     bool performScan();
     void processScanResults();
-    bool validateSSID(const String& ssid);
+    void finishScan();
+    void accumulateResult(const ScannedNetwork& result);
+    static void scanResultSink(void* context, const ScannedNetwork& result);
+    bool validateSSID(const char* ssid);
     bool shouldIncludeNetwork(const ScannedNetwork& network);
     
     // Signal quality helpers
@@ -140,13 +191,8 @@ private:
     void setError(const String& error);
     void clearError();
     
-    // Debug helpers
-    void debugPrint(const String& message);
-    void debugPrintf(const char* format, ...);
-    
     static const uint32_t DEFAULT_CACHE_TIMEOUT = 30000;
     static const int DEFAULT_MIN_SIGNAL_QUALITY = 10;
-    static const int MAX_SCAN_NETWORKS = 50;
 };
 
 // Utility functions for network analysis
@@ -0,0 +1,63 @@
+/**
+ * PicoWiFiFeatures - Compile-time feature selection for PicoWiFiManager
+ *
+ * Every PICOWIFI_ENABLE_* option defaults to 1. Setting one to 0 removes
+ * the feature's code, strings and buffers from the build, together with the
+ * libraries only it needs (WebServer, DNSServer). A device provisioned at
+ * the factory can drop the portal and scanner entirely.
+ *
+ * Like PICOWIFI_STATIC_ALLOCATION these options change class layouts: set
+ * them for the whole build (compiler flags), never with a #define in a
+ * single sketch file. PicoWiFiFeatures mirrors them as constexpr flags for
+ * if constexpr in sketches.
+ */
+
+#ifndef PICOWIFI_FEATURES_H
+#define PICOWIFI_FEATURES_H
+
+#include <Arduino.h>
+
+// Config portal with captive DNS (needs the scanner)
+#ifndef PICOWIFI_ENABLE_PORTAL
+#define PICOWIFI_ENABLE_PORTAL 1
+#endif
+
+// NetworkScanner: in-range network selection, BSSID pinning, roaming
+#ifndef PICOWIFI_ENABLE_SCANNER
+#define PICOWIFI_ENABLE_SCANNER 1
+#endif
+
+// /metrics and /status.json while connected
+#ifndef PICOWIFI_ENABLE_STATUS_SERVER
+#define PICOWIFI_ENABLE_STATUS_SERVER 1
+#endif
+
+// SerialProvisioner: binary credential push for production lines
+#ifndef PICOWIFI_ENABLE_SERIAL_PROVISIONING
+#define PICOWIFI_ENABLE_SERIAL_PROVISIONING 1
+#endif
+
+// Log messages (PicoWiFiLog); 0 removes every level
+#ifndef PICOWIFI_ENABLE_DEBUG
+#define PICOWIFI_ENABLE_DEBUG 1
+#endif
+
+// printDiagnostics() and printResults() reports, per-subsystem heap accounting
+#ifndef PICOWIFI_ENABLE_DIAGNOSTICS
+#define PICOWIFI_ENABLE_DIAGNOSTICS 1
+#endif
+
+#if PICOWIFI_ENABLE_PORTAL && !PICOWIFI_ENABLE_SCANNER
+#error "PICOWIFI_ENABLE_PORTAL needs PICOWIFI_ENABLE_SCANNER"
+#endif
+
+struct PicoWiFiFeatures {
+    static constexpr bool portal = PICOWIFI_ENABLE_PORTAL;
+    static constexpr bool scanner = PICOWIFI_ENABLE_SCANNER;
+    static constexpr bool statusServer = PICOWIFI_ENABLE_STATUS_SERVER;
+    static constexpr bool serialProvisioning = PICOWIFI_ENABLE_SERIAL_PROVISIONING;
+    static constexpr bool debug = PICOWIFI_ENABLE_DEBUG;
+    static constexpr bool diagnostics = PICOWIFI_ENABLE_DIAGNOSTICS;
+};
+
+#endif // PICOWIFI_FEATURES_H
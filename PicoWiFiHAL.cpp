@@ -0,0 +1,212 @@
+/**
+ * PicoWiFiHAL - Implementation
+ */
+
+#include "PicoWiFiHAL.h"
+#include <EEPROM.h>
+#include <hardware/sync.h>
+#include <pico/cyw43_arch.h>
+#include "FlashLog.h"
+#include "NetworkScanner.h"
+
+// Filesystem region bounds from the arduino-pico linker script
+extern uint8_t _FS_start;
+extern uint8_t _FS_end;
+
+static CYW43WiFiDriver defaultWiFi;
+static PicoFlashDriver defaultFlash;
+static PicoEEPROMDriver defaultEEPROM;
+
+WiFiDriver* PicoWiFiHAL::_wifi = &defaultWiFi;
+FlashDriver* PicoWiFiHAL::_flash = &defaultFlash;
+EEPROMDriver* PicoWiFiHAL::_eeprom = &defaultEEPROM;
+
+void PicoWiFiHAL::setWiFiDriver(WiFiDriver* driver) {
+    _wifi = driver ? driver : &defaultWiFi;
+}
+
+void PicoWiFiHAL::setFlashDriver(FlashDriver* driver) {
+    _flash = driver ? driver : &defaultFlash;
+}
+
+void PicoWiFiHAL::setEEPROMDriver(EEPROMDriver* driver) {
+    _eeprom = driver ? driver : &defaultEEPROM;
+}
+
+// CYW43WiFiDriver
+
+void CYW43WiFiDriver::setMode(WiFiMode_t mode) {
+    WiFi.mode(mode);
+}
+
+void CYW43WiFiDriver::config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet) {
+    WiFi.config(ip, dns, gateway, subnet);
+}
+
+void CYW43WiFiDriver::beginNoBlock(const char* ssid, const char* password, const uint8_t* bssid) {
+    WiFi.beginNoBlock(ssid, password, bssid);
+}
+
+void CYW43WiFiDriver::disconnect() {
+    WiFi.disconnect();
+}
+
+uint8_t CYW43WiFiDriver::status() {
+    return WiFi.status();
+}
+
+void CYW43WiFiDriver::powerOff() {
+    // Takes the station interface down; the chip idles until the next mode
+    WiFi.end();
+}
+
+void CYW43WiFiDriver::powerOn() {
+    WiFi.mode(WIFI_STA);
+}
+
+IPAddress CYW43WiFiDriver::localIP() {
+    return WiFi.localIP();
+}
+
+IPAddress CYW43WiFiDriver::gatewayIP() {
+    return WiFi.gatewayIP();
+}
+
+IPAddress CYW43WiFiDriver::subnetMask() {
+    return WiFi.subnetMask();
+}
+
+IPAddress CYW43WiFiDriver::dnsIP() {
+    return WiFi.dnsIP();
+}
+
+const char* CYW43WiFiDriver::SSID() {
+    return WiFi.SSID();
+}
+
+int32_t CYW43WiFiDriver::RSSI() {
+    return WiFi.RSSI();
+}
+
+uint8_t CYW43WiFiDriver::channel() {
+    return WiFi.channel();
+}
+
+void CYW43WiFiDriver::BSSID(uint8_t* bssid) {
+    WiFi.BSSID(bssid);
+}
+
+void CYW43WiFiDriver::macAddress(uint8_t* mac) {
+    WiFi.macAddress(mac);
+}
+
+int CYW43WiFiDriver::scanNetworks() {
+    // The argument is the async flag, not "show hidden"
+    return WiFi.scanNetworks();
+}
+
+bool CYW43WiFiDriver::getScanResult(uint8_t index, ScannedNetwork& network) {
+    network = ScannedNetwork();
+    const char* ssid = WiFi.SSID(index);
+    if (!ssid) return false;
+
+    strncpy(network.ssid, ssid, sizeof(network.ssid) - 1);
+    network.rssi = (int8_t)WiFi.RSSI(index);
+    network.channel = WiFi.channel(index);
+    network.encType = WiFi.encryptionType(index);
+    WiFi.BSSID(index, network.bssid);
+    network.hidden = (network.ssid[0] == '\0');
+    return true;
+}
+
+static uint8_t authModeToEncType(uint8_t authMode) {
+    // CYW43 scan auth bits: 0x01 WEP, 0x02 WPA, 0x04 WPA2
+    if (authMode == 0) return ENC_TYPE_NONE;
+    if ((authMode & 0x06) == 0x06) return ENC_TYPE_AUTO;
+    if (authMode & 0x04) return ENC_TYPE_CCMP;
+    if (authMode & 0x02) return ENC_TYPE_TKIP;
+    return ENC_TYPE_WEP;
+}
+
+static int scanResultCallback(void* env, const cyw43_ev_scan_result_t* result) {
+    if (!env || !result) return 0;
+
+    ScannedNetwork entry;
+    size_t ssidLength = result->ssid_len;
+    if (ssidLength > sizeof(entry.ssid) - 1) ssidLength = sizeof(entry.ssid) - 1;
+    memcpy(entry.ssid, result->ssid, ssidLength);
+    entry.ssid[ssidLength] = '\0';
+    memcpy(entry.bssid, result->bssid, sizeof(entry.bssid));
+    entry.rssi = (int8_t)result->rssi;
+    entry.channel = (uint8_t)result->channel;
+    entry.encType = authModeToEncType(result->auth_mode);
+    entry.hidden = (ssidLength == 0);
+
+    static_cast<CYW43WiFiDriver*>(env)->deliver(entry);
+    return 0;
+}
+
+int CYW43WiFiDriver::startAsyncScan(ScanResultSink sink, void* context) {
+    _sink = sink;
+    _sinkContext = context;
+
+    cyw43_wifi_scan_options_t options;
+    memset(&options, 0, sizeof(options));
+
+    cyw43_arch_lwip_begin();
+    int err = cyw43_wifi_scan(&cyw43_state, &options, this, scanResultCallback);
+    cyw43_arch_lwip_end();
+    return err;
+}
+
+bool CYW43WiFiDriver::isAsyncScanActive() {
+    return cyw43_wifi_scan_active(&cyw43_state);
+}
+
+void CYW43WiFiDriver::deliver(const ScannedNetwork& network) {
+    if (_sink) _sink(_sinkContext, network);
+}
+
+// PicoFlashDriver
+
+uintptr_t PicoFlashDriver::getRegionStart() {
+    return (uintptr_t)&_FS_start;
+}
+
+uintptr_t PicoFlashDriver::getRegionEnd() {
+    return (uintptr_t)&_FS_end;
+}
+
+void PicoFlashDriver::eraseSector(uintptr_t address) {
+    FlashLockout lockout;
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_erase((uint32_t)(address - XIP_BASE), FLASH_SECTOR_SIZE);
+    restore_interrupts(interrupts);
+}
+
+void PicoFlashDriver::programPage(uintptr_t address, const uint8_t* page) {
+    FlashLockout lockout;
+    uint32_t interrupts = save_and_disable_interrupts();
+    flash_range_program((uint32_t)(address - XIP_BASE), page, FLASH_PAGE_SIZE);
+    restore_interrupts(interrupts);
+}
+
+// PicoEEPROMDriver
+
+void PicoEEPROMDriver::begin(size_t size) {
+    EEPROM.begin(size);
+}
+
+void PicoEEPROMDriver::end() {
+    EEPROM.end();
+}
+
+uint8_t* PicoEEPROMDriver::getData() {
+    return EEPROM.getDataPtr();
+}
+
+bool PicoEEPROMDriver::commit() {
+    // EEPROM emulation rewrites its flash sector
+    FlashLockout lockout;
+    return EEPROM.commit();
+}
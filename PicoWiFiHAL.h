@@ -0,0 +1,156 @@
+/**
+ * PicoWiFiHAL - Hardware interfaces under PicoWiFiManager
+ *
+ * PicoWiFiManager, NetworkScanner and StorageManager reach the radio and
+ * flash only through these interfaces:
+ *
+ * WiFiDriver:   station connect/status and scanning (CYW43WiFiDriver)
+ * FlashDriver:  sector erase and page program of the filesystem region
+ *               (PicoFlashDriver); reads go straight to memory
+ * EEPROMDriver: RAM image plus commit, for EEPROM emulation
+ *               (PicoEEPROMDriver)
+ *
+ * The defaults drive the Pico 2 W. SimulatedWiFi.h and SimulatedStorage.h
+ * provide scripted replacements for benchmarks and fault injection.
+ * Install replacements before PicoWiFiManager::begin() and keep them alive
+ * as long as the library runs. The softAP side of the portal still uses
+ * the Arduino WiFi object directly.
+ */
+
+#ifndef PICOWIFI_HAL_H
+#define PICOWIFI_HAL_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+struct ScannedNetwork;
+
+// Receives one BSS of a background scan (may run in driver context)
+typedef void (*ScanResultSink)(void* context, const ScannedNetwork& network);
+
+class WiFiDriver {
+public:
+    virtual ~WiFiDriver() {}
+
+    // Station
+    virtual void setMode(WiFiMode_t mode) = 0;
+    virtual void config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet) = 0;
+    virtual void beginNoBlock(const char* ssid, const char* password, const uint8_t* bssid) = 0;
+    virtual void disconnect() = 0;
+    virtual uint8_t status() = 0;              // wl_status_t
+
+    // Radio power; powerOff() drops the association and the next join or
+    // scan needs powerOn() first
+    virtual void powerOff() = 0;
+    virtual void powerOn() = 0;
+
+    // Current association
+    virtual IPAddress localIP() = 0;
+    virtual IPAddress gatewayIP() = 0;
+    virtual IPAddress subnetMask() = 0;
+    virtual IPAddress dnsIP() = 0;
+    virtual const char* SSID() = 0;
+    virtual int32_t RSSI() = 0;
+    virtual uint8_t channel() = 0;
+    virtual void BSSID(uint8_t* bssid) = 0;    // 6 bytes
+    virtual void macAddress(uint8_t* mac) = 0; // 6 bytes
+
+    // Blocking scan; results are read back by index
+    virtual int scanNetworks() = 0;
+    virtual bool getScanResult(uint8_t index, ScannedNetwork& network) = 0;
+
+    // Background scan: every BSS goes to sink, and isAsyncScanActive()
+    // turns false only after the last one. Returns 0 or a driver error.
+    virtual int startAsyncScan(ScanResultSink sink, void* context) = 0;
+    virtual bool isAsyncScanActive() = 0;
+};
+
+class FlashDriver {
+public:
+    virtual ~FlashDriver() {}
+
+    // Area the flash-backed stores may use, sector aligned and memory mapped
+    virtual uintptr_t getRegionStart() = 0;
+    virtual uintptr_t getRegionEnd() = 0;
+
+    // address is inside the region; program writes FLASH_PAGE_SIZE bytes
+    virtual void eraseSector(uintptr_t address) = 0;
+    virtual void programPage(uintptr_t address, const uint8_t* page) = 0;
+};
+
+class EEPROMDriver {
+public:
+    virtual ~EEPROMDriver() {}
+
+    virtual void begin(size_t size) = 0;       // Loads the stored image
+    virtual void end() = 0;
+    virtual uint8_t* getData() = 0;            // RAM image, size bytes
+    virtual bool commit() = 0;                 // Stores the image
+};
+
+// Arduino-pico / CYW43 implementations
+class CYW43WiFiDriver : public WiFiDriver {
+public:
+    void setMode(WiFiMode_t mode) override;
+    void config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet) override;
+    void beginNoBlock(const char* ssid, const char* password, const uint8_t* bssid) override;
+    void disconnect() override;
+    uint8_t status() override;
+    void powerOff() override;
+    void powerOn() override;
+    IPAddress localIP() override;
+    IPAddress gatewayIP() override;
+    IPAddress subnetMask() override;
+    IPAddress dnsIP() override;
+    const char* SSID() override;
+    int32_t RSSI() override;
+    uint8_t channel() override;
+    void BSSID(uint8_t* bssid) override;
+    void macAddress(uint8_t* mac) override;
+    int scanNetworks() override;
+    bool getScanResult(uint8_t index, ScannedNetwork& network) override;
+    int startAsyncScan(ScanResultSink sink, void* context) override;
+    bool isAsyncScanActive() override;
+
+    // Called from the CYW43 scan callback
+    void deliver(const ScannedNetwork& network);
+
+private:
+    ScanResultSink _sink = nullptr;
+    void* _sinkContext = nullptr;
+};
+
+class PicoFlashDriver : public FlashDriver {
+public:
+    uintptr_t getRegionStart() override;
+    uintptr_t getRegionEnd() override;
+    void eraseSector(uintptr_t address) override;
+    void programPage(uintptr_t address, const uint8_t* page) override;
+};
+
+class PicoEEPROMDriver : public EEPROMDriver {
+public:
+    void begin(size_t size) override;
+    void end() override;
+    uint8_t* getData() override;
+    bool commit() override;
+};
+
+class PicoWiFiHAL {
+public:
+    static WiFiDriver& wifi() { return *_wifi; }
+    static FlashDriver& flash() { return *_flash; }
+    static EEPROMDriver& eeprom() { return *_eeprom; }
+
+    // nullptr puts the hardware driver back
+    static void setWiFiDriver(WiFiDriver* driver);
+    static void setFlashDriver(FlashDriver* driver);
+    static void setEEPROMDriver(EEPROMDriver* driver);
+
+private:
+    static WiFiDriver* _wifi;
+    static FlashDriver* _flash;
+    static EEPROMDriver* _eeprom;
+};
+
+#endif // PICOWIFI_HAL_H
@@ -0,0 +1,257 @@
+/**
+ * PicoWiFiLog - Implementation
+ */
+
+#include "PicoWiFiLog.h"
+#include <pico/stdlib.h>
+#include <ctype.h>
+#include <stddef.h>
+
+PicoWiFiLog::LogQueue PicoWiFiLog::_queues[2];
+Print* PicoWiFiLog::_output = &Serial;
+volatile bool PicoWiFiLog::_enabled = true;
+volatile LogLevel PicoWiFiLog::_level = (LogLevel)PICOWIFI_LOG_LEVEL;
+uint32_t PicoWiFiLog::_reportedDrops = 0;
+
+// Longest line drain() prints; the rest is cut
+static const size_t LOG_LINE_SIZE = 160;
+
+void PicoWiFiLog::commit(LogRecord& record) {
+    record.core = (uint8_t)get_core_num();
+    // A full queue counts the record as dropped; drain() reports it
+    _queues[record.core & 1].push(record);
+}
+
+void PicoWiFiLog::put(LogRecord& record, const void* data, size_t size) {
+    if (record.length + size > LOG_PAYLOAD_SIZE) {
+        // Later arguments must not land where this one was expected
+        record.length = LOG_PAYLOAD_SIZE;
+        return;
+    }
+    memcpy(record.payload + record.length, data, size);
+    record.length += size;
+}
+
+void PicoWiFiLog::encode(LogRecord& record, const char* text) {
+    if (!text) text = "(null)";
+    size_t room = LOG_PAYLOAD_SIZE - record.length;
+    if (room == 0) return;
+
+    // Length byte, then the characters without terminator
+    size_t length = strnlen(text, room - 1);
+    record.payload[record.length++] = (uint8_t)length;
+    memcpy(record.payload + record.length, text, length);
+    record.length += length;
+}
+
+static bool takeArgument(const LogRecord& record, size_t& offset, void* value, size_t size) {
+    if (offset + size > record.length) return false;
+    memcpy(value, record.payload + offset, size);
+    offset += size;
+    return true;
+}
+
+size_t PicoWiFiLog::format(const LogRecord& record, char* buffer, size_t size) {
+    if (size == 0) return 0;
+
+    size_t out = 0;
+    size_t offset = 0;
+    const char* p = record.format;
+
+    while (*p && out + 1 < size) {
+        if (*p != '%') {
+            buffer[out++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            buffer[out++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Rebuild the conversion without its length modifier; the payload
+        // stores 4-byte words or 8-byte values whatever the source type was
+        char spec[20];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && (strchr("-+ #0", *p) || isdigit((unsigned char)*p) || *p == '.')) {
+            if (specLength < sizeof(spec) - 4) spec[specLength++] = *p;
+            p++;
+        }
+
+        bool wide = false;
+        while (*p && strchr("hlzjtL", *p)) {
+            if (*p == 'l' && p[1] == 'l') {
+                wide = true;
+                p++;
+            } else if (*p == 'l') {
+                wide = sizeof(long) > sizeof(uint32_t);
+            } else if (*p == 'z') {
+                wide = sizeof(size_t) > sizeof(uint32_t);
+            } else if (*p == 'j') {
+                wide = true;
+            } else if (*p == 't') {
+                wide = sizeof(ptrdiff_t) > sizeof(uint32_t);
+            }
+            p++;
+        }
+
+        char type = *p;
+        if (!type) break;
+        p++;
+
+        if (wide && strchr("diuxXo", type)) {
+            spec[specLength++] = 'l';
+            spec[specLength++] = 'l';
+        }
+        spec[specLength++] = type;
+        spec[specLength] = '\0';
+
+        char* dest = buffer + out;
+        size_t room = size - out;
+        int written = -1;
+
+        switch (type) {
+            case 'd':
+            case 'i':
+            case 'c':
+                if (wide && type != 'c') {
+                    int64_t value;
+                    if (takeArgument(record, offset, &value, sizeof(value))) {
+                        written = snprintf(dest, room, spec, (long long)value);
+                    }
+                } else {
+                    int32_t value;
+                    if (takeArgument(record, offset, &value, sizeof(value))) {
+                        written = snprintf(dest, room, spec, (int)value);
+                    }
+                }
+                break;
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'o':
+                if (wide) {
+                    uint64_t value;
+                    if (takeArgument(record, offset, &value, sizeof(value))) {
+                        written = snprintf(dest, room, spec, (unsigned long long)value);
+                    }
+                } else {
+                    uint32_t value;
+                    if (takeArgument(record, offset, &value, sizeof(value))) {
+                        written = snprintf(dest, room, spec, (unsigned)value);
+                    }
+                }
+                break;
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G': {
+                double value;
+                if (takeArgument(record, offset, &value, sizeof(value))) {
+                    written = snprintf(dest, room, spec, value);
+                }
+                break;
+            }
+
+            case 's': {
+                uint8_t length;
+                char text[LOG_PAYLOAD_SIZE];
+                if (takeArgument(record, offset, &length, sizeof(length)) &&
+                    takeArgument(record, offset, text, length)) {
+                    text[length] = '\0';
+                    written = snprintf(dest, room, spec, text);
+                }
+                break;
+            }
+
+            case 'p': {
+                uintptr_t value;
+                if (takeArgument(record, offset, &value, sizeof(value))) {
+                    written = snprintf(dest, room, "%p", (void*)value);
+                }
+                break;
+            }
+
+            default:
+                // Unknown conversion: print it as written
+                written = snprintf(dest, room, "%s", spec);
+                break;
+        }
+
+        if (written < 0) {
+            // Argument did not fit in the record
+            written = snprintf(dest, room, "?");
+        }
+        out += ((size_t)written < room) ? (size_t)written : room - 1;
+    }
+
+    buffer[out] = '\0';
+    return out;
+}
+
+size_t PicoWiFiLog::drain(size_t maxRecords) {
+    // Core 0 is the only consumer of both queues
+    if (get_core_num() != 0) return 0;
+
+    size_t drained = 0;
+    LogRecord record;
+    char line[LOG_LINE_SIZE];
+
+    uint32_t dropped = getDropped();
+    if (dropped != _reportedDrops && _output) {
+        _output->printf("[PicoWiFiLog] %lu messages dropped\n", (unsigned long)(dropped - _reportedDrops));
+        _reportedDrops = dropped;
+    }
+
+    // Alternate cores; the timestamps give the true order
+    bool pending = true;
+    while (pending && drained < maxRecords) {
+        pending = false;
+        for (uint8_t core = 0; core < 2 && drained < maxRecords; core++) {
+            if (!_queues[core].pop(record)) continue;
+            pending = true;
+            drained++;
+            if (!_output) continue;
+
+            int prefix = snprintf(line, sizeof(line), "%6lu.%03lu %c [%s%s] ",
+                                  (unsigned long)(record.timestamp / 1000),
+                                  (unsigned long)(record.timestamp % 1000),
+                                  getLevelName(record.level)[0], getTagName(record.tag),
+                                  record.core ? "/1" : "");
+            if (prefix < 0 || (size_t)prefix >= sizeof(line)) prefix = 0;
+            format(record, line + prefix, sizeof(line) - prefix);
+            _output->println(line);
+        }
+    }
+    return drained;
+}
+
+uint32_t PicoWiFiLog::getDropped() {
+    return _queues[0].getDropped() + _queues[1].getDropped();
+}
+
+const char* PicoWiFiLog::getLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::DEBUG: return "DEBUG";
+        default: return "NONE";
+    }
+}
+
+const char* PicoWiFiLog::getTagName(LogTag tag) {
+    switch (tag) {
+        case LogTag::MANAGER: return "PicoWiFiManager";
+        case LogTag::STORAGE: return "StorageManager";
+        case LogTag::SCANNER: return "NetworkScanner";
+        case LogTag::PORTAL: return "ConfigPortal";
+        case LogTag::PROVISIONER: return "SerialProvisioner";
+        default: return "?";
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * PicoWiFiLog - Deferred, level-filtered logging for PicoWiFiManager
+ *
+ * A log call copies a fixed-size binary record (timestamp, level, tag, the
+ * address of the format literal and the raw argument values) into a
+ * lock-free queue owned by the calling core. Nothing is formatted or
+ * written to Serial there: drain() turns records into text later, from
+ * PicoWiFiManager::loop() on core 0, so connect and scan paths only pay for
+ * a few dozen bytes of copying.
+ *
+ * Levels above PICOWIFI_LOG_LEVEL compile to nothing, arguments included.
+ * Use the PICOWIFI_LOGE/W/I/D macros; each source file names itself with
+ * PICOWIFI_LOG_TAG. Not for use from interrupt handlers.
+ */
+
+#ifndef PICOWIFI_LOG_H
+#define PICOWIFI_LOG_H
+
+#include <Arduino.h>
+#include <string.h>
+#include <type_traits>
+#include "PicoWiFiFeatures.h"
+#include "InterCore.h"
+
+#define PICOWIFI_LOG_NONE 0
+#define PICOWIFI_LOG_ERROR 1
+#define PICOWIFI_LOG_WARN 2
+#define PICOWIFI_LOG_INFO 3
+#define PICOWIFI_LOG_DEBUG 4
+
+// Most verbose level compiled in
+#if !PICOWIFI_ENABLE_DEBUG
+#undef PICOWIFI_LOG_LEVEL
+#define PICOWIFI_LOG_LEVEL PICOWIFI_LOG_NONE
+#elif !defined(PICOWIFI_LOG_LEVEL)
+#define PICOWIFI_LOG_LEVEL PICOWIFI_LOG_INFO
+#endif
+
+// Records buffered per core (power of two)
+#ifndef PICOWIFI_LOG_RECORDS
+#define PICOWIFI_LOG_RECORDS 16
+#endif
+
+enum class LogLevel : uint8_t {
+    NONE = PICOWIFI_LOG_NONE,
+    ERROR = PICOWIFI_LOG_ERROR,
+    WARN = PICOWIFI_LOG_WARN,
+    INFO = PICOWIFI_LOG_INFO,
+    DEBUG = PICOWIFI_LOG_DEBUG
+};
+
+enum class LogTag : uint8_t {
+    MANAGER,
+    STORAGE,
+    SCANNER,
+    PORTAL,
+    PROVISIONER,
+    COUNT
+};
+
+// Packed argument bytes per record; longer strings are cut to fit
+static const size_t LOG_PAYLOAD_SIZE = 44;
+
+struct LogRecord {
+    uint32_t timestamp;          // millis()
+    const char* format;          // Literal, so only its address is kept
+    LogLevel level;
+    LogTag tag;
+    uint8_t core;
+    uint8_t length;              // Payload bytes used
+    uint8_t payload[LOG_PAYLOAD_SIZE];
+};
+
+class PicoWiFiLog {
+public:
+    // Runtime switches, on top of the compile-time level
+    static void setEnabled(bool enabled) { _enabled = enabled; }
+    static bool isEnabled() { return _enabled; }
+    static void setLevel(LogLevel level) { _level = level; }
+    static LogLevel getLevel() { return _level; }
+
+    // Where drain() prints (Serial by default)
+    static void setOutput(Print* output) { _output = output; }
+
+    static bool isLogging(LogLevel level) {
+        return _enabled && (uint8_t)level <= (uint8_t)_level;
+    }
+
+    template <typename... Args>
+    static void write(LogLevel level, LogTag tag, const char* format, const Args&... args) {
+        if (!isLogging(level)) return;
+
+        LogRecord record;
+        record.timestamp = millis();
+        record.format = format;
+        record.level = level;
+        record.tag = tag;
+        record.length = 0;
+        int expand[] = {0, (encode(record, args), 0)...};
+        (void)expand;
+        commit(record);
+    }
+
+    // Formats and prints up to maxRecords queued records (no-op on core 1)
+    static size_t drain(size_t maxRecords = SIZE_MAX);
+    static void flush() { drain(); }
+
+    static uint32_t getDropped();
+    static const char* getLevelName(LogLevel level);
+    static const char* getTagName(LogTag tag);
+
+    // Turns a record into text (without newline); returns the length
+    static size_t format(const LogRecord& record, char* buffer, size_t size);
+
+    // Never called: lets the compiler check the format against its arguments
+    __attribute__((format(printf, 1, 2))) static void checkFormat(const char*, ...) {}
+
+private:
+    typedef SpscQueue<LogRecord, PICOWIFI_LOG_RECORDS> LogQueue;
+
+    // Stamps the core and queues the record for drain()
+    static void commit(LogRecord& record);
+
+    static void put(LogRecord& record, const void* data, size_t size);
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    encode(LogRecord& record, const T& value) {
+        if (sizeof(T) <= sizeof(uint32_t)) {
+            uint32_t word = std::is_signed<T>::value ? (uint32_t)(int32_t)value : (uint32_t)value;
+            put(record, &word, sizeof(word));
+        } else {
+            uint64_t wide = (uint64_t)value;
+            put(record, &wide, sizeof(wide));
+        }
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    encode(LogRecord& record, const T& value) {
+        double wide = value;
+        put(record, &wide, sizeof(wide));
+    }
+
+    static void encode(LogRecord& record, const char* text);
+    static void encode(LogRecord& record, char* text) { encode(record, (const char*)text); }
+    static void encode(LogRecord& record, const void* pointer) {
+        uintptr_t address = (uintptr_t)pointer;
+        put(record, &address, sizeof(address));
+    }
+    template <size_t N>
+    static void encode(LogRecord& record, const char (&text)[N]) { encode(record, (const char*)text); }
+    template <size_t N>
+    static void encode(LogRecord& record, char (&text)[N]) { encode(record, (const char*)text); }
+
+    // A String would be copied at the call site; pass c_str() instead
+    static void encode(LogRecord& record, const String& text) = delete;
+
+    static LogQueue _queues[2];
+    static Print* _output;
+    static volatile bool _enabled;
+    static volatile LogLevel _level;
+    static uint32_t _reportedDrops;
+};
+
+// Each source file sets PICOWIFI_LOG_TAG to its LogTag before logging
+#define PICOWIFI_LOG_AT(level, ...) do { \
+        if (false) PicoWiFiLog::checkFormat(__VA_ARGS__); \
+        PicoWiFiLog::write(level, PICOWIFI_LOG_TAG, __VA_ARGS__); \
+    } while (0)
+
+#if PICOWIFI_LOG_LEVEL >= PICOWIFI_LOG_ERROR
+#define PICOWIFI_LOGE(...) PICOWIFI_LOG_AT(LogLevel::ERROR, __VA_ARGS__)
+#else
+#define PICOWIFI_LOGE(...) ((void)0)
+#endif
+
+#if PICOWIFI_LOG_LEVEL >= PICOWIFI_LOG_WARN
+#define PICOWIFI_LOGW(...) PICOWIFI_LOG_AT(LogLevel::WARN, __VA_ARGS__)
+#else
+#define PICOWIFI_LOGW(...) ((void)0)
+#endif
+
+#if PICOWIFI_LOG_LEVEL >= PICOWIFI_LOG_INFO
+#define PICOWIFI_LOGI(...) PICOWIFI_LOG_AT(LogLevel::INFO, __VA_ARGS__)
+#else
+#define PICOWIFI_LOGI(...) ((void)0)
+#endif
+
+#if PICOWIFI_LOG_LEVEL >= PICOWIFI_LOG_DEBUG
+#define PICOWIFI_LOGD(...) PICOWIFI_LOG_AT(LogLevel::DEBUG, __VA_ARGS__)
+#else
+#define PICOWIFI_LOGD(...) ((void)0)
+#endif
+
+#endif // PICOWIFI_LOG_H
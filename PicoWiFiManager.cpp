@@ -6,38 +6,80 @@
 
 #include "PicoWiFiManager.h"
 #include <pico/stdlib.h>
+#include <pico/multicore.h>
+
+#define PICOWIFI_LOG_TAG LogTag::MANAGER
 
 // Static instance for dual-core support
 PicoWiFiManager* PicoWiFiManager::_instance = nullptr;
 
+// Dedicated core 1 stack (the SDK default is only 2 KB)
+uint32_t PicoWiFiManager::_core1Stack[CORE1_STACK_SIZE / sizeof(uint32_t)];
+bool PicoWiFiManager::_core1StackPainted = false;
+
 PicoWiFiManager::PicoWiFiManager() : PicoWiFiManager(PicoWiFiConfig()) {
 }
 
 PicoWiFiManager::PicoWiFiManager(const PicoWiFiConfig& config) 
     : _config(config)
     , _status(ConnectionStatus::DISCONNECTED)
-    , _portal(nullptr)
-    , _storage(nullptr)
-    , _scanner(nullptr)
-    , _server(nullptr)
     , _isInitialized(false)
     , _configMode(false)
     , _dualCoreEnabled(false)
-    , _debugEnabled(config.enableSerial)
+    , _core1Running(false)
+    , _core1Active(false)
+    , _commandQueueReady(false)
+    , _nextCommandId(0)
+    , _connectDone(0)
+    , _connectDoneOK(false)
+    , _connectCommand(0)
     , _startTime(0)
-    , _lastReconnectAttempt(0)
-    , _reconnectAttempts(0)
-    , _lastLEDUpdate(0)
-    , _ledState(false) {
+    , _connectState(ConnectState::IDLE)
+    , _connectStart(0)
+    , _connectStepStart(0)
+    , _saveOnConnect(false)
+    , _disconnectRequested(false)
+    , _connectChannel(0)
+    , _connectPinned(false)
+    , _fastConnectAttempt(false)
+    , _leaseApplied(false)
+    , _connectOrigin(0)
+    , _lastConnectDuration(0)
+    , _lastConnectFast(false)
+    , _portalCloseAt(0)
+    , _roamScanPending(false)
+    , _radioPowered(true)
+    , _led()
+    , _lastSnapshotRefresh(0) {
     
+    memset(_connectSSID, 0, sizeof(_connectSSID));
+    memset(_connectPassword, 0, sizeof(_connectPassword));
+    memset(_connectBSSID, 0, sizeof(_connectBSSID));
+    _reconnect.setPolicy(_config.reconnectPolicy);
+    _power.setPolicy(_config.powerPolicy);
+    _link.setConfig(_config.roaming);
     _instance = this;
 }
 
 PicoWiFiManager::~PicoWiFiManager() {
-    if (_portal) delete _portal;
-    if (_storage) delete _storage;
-    if (_scanner) delete _scanner;
-    if (_server) delete _server;
+    stopCore1();
+    
+#if PICOWIFI_ENABLE_PORTAL
+    _portal.destroy();
+#endif
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+    _provisioner.destroy();
+#endif
+    _storage.destroy();
+#if PICOWIFI_ENABLE_SCANNER
+    _scanner.destroy();
+#endif
+#if PICOWIFI_ENABLE_STATUS_SERVER
+    _statusServer.destroy();
+#endif
+    _button.end();
+    _led.end();
+    if (_commandQueueReady) queue_free(&_commandQueue);
     
     if (_instance == this) {
         _instance = nullptr;
@@ -49,44 +91,58 @@ bool PicoWiFiManager::begin() {
     
     _startTime = millis();
     
-    debugPrint("PicoWiFiManager starting...");
+    PICOWIFI_LOGI("PicoWiFiManager starting...");
     
     // Initialize GPIO
-    pinMode(_config.ledPin, OUTPUT);
-    pinMode(_config.resetPin, INPUT_PULLUP);
+    _led.begin(_config.ledPin);
+    _button.begin(_config.resetPin);
     
     // Initialize storage
-    _storage = new StorageManager();
-    if (!_storage->begin()) {
-        debugPrint("Failed to initialize storage");
+    _storage.create();
+    if (!_storage->begin(STORAGE_EEPROM_SIZE, _config.storageBackend)) {
+        PICOWIFI_LOGE("Failed to initialize storage");
         return false;
     }
     
+#if PICOWIFI_ENABLE_SCANNER
     // Initialize network scanner
-    _scanner = new NetworkScanner();
+    _scanner.create();
+#endif
     
+#if PICOWIFI_ENABLE_PORTAL
     // Initialize config portal
-    _portal = new ConfigPortal(this);
+    _portal.create(this);
+    _portal->setScanner(_scanner.get());
+    _portal->setKeepStation(_config.apStaProvisioning);
     
     // Set up callbacks
     _portal->onConnect([this](const String& ssid, const String& password) {
-        debugPrintf("Portal connect request: %s", ssid.c_str());
-        if (connectWiFi(ssid.c_str(), password.c_str())) {
-            _storage->saveWiFiCredentials(ssid.c_str(), password.c_str());
-            stopConfigPortal();
-            setStatus(ConnectionStatus::CONNECTED);
+        PICOWIFI_LOGI("Portal connect request: %s", ssid.c_str());
+        // Credentials are saved and the portal closed once pollConnect() succeeds
+        if (connectAsync(ssid.c_str(), password.c_str())) {
+            _saveOnConnect = true;
         }
     });
     
     _portal->onReset([this]() {
-        debugPrint("Reset requested from portal");
+        PICOWIFI_LOGI("Reset requested from portal");
         reset();
     });
+#endif
+    
+    if (_config.serialProvisioning) {
+        startSerialProvisioning();
+    }
     
     setStatus(ConnectionStatus::DISCONNECTED);
     _isInitialized = true;
     
-    debugPrint("PicoWiFiManager initialized successfully");
+    if (_dualCoreEnabled) {
+        startCore1();
+    }
+    
+    PICOWIFI_LOGI("PicoWiFiManager initialized successfully");
+    PicoWiFiLog::flush();
     return true;
 }
 
@@ -95,12 +151,18 @@ bool PicoWiFiManager::autoConnect() {
         return false;
     }
     
-    WiFiCredentials credentials;
-    if (_storage->loadWiFiCredentials(credentials) && credentials.valid) {
-        debugPrintf("Attempting auto-connect to: %s", credentials.ssid);
-        return autoConnect(credentials.ssid, credentials.password);
+    if (!_storage->hasWiFiCredentials()) {
+        PICOWIFI_LOGI("No saved credentials, starting config portal");
+        return startConfigPortal();
+    }
+    
+    PICOWIFI_LOGI("Attempting auto-connect (%d saved networks)", _storage->getNetworkCount());
+    
+    if (connectWiFi()) {
+        PICOWIFI_LOGI("Auto-connect successful");
+        return true;
     } else {
-        debugPrint("No saved credentials, starting config portal");
+        PICOWIFI_LOGW("Auto-connect failed, starting config portal");
         return startConfigPortal();
     }
 }
@@ -110,13 +172,13 @@ bool PicoWiFiManager::autoConnect(const char* ssid, const char* password) {
         return false;
     }
     
-    debugPrintf("Auto-connecting to: %s", ssid);
+    PICOWIFI_LOGI("Auto-connecting to: %s", ssid);
     
     if (connectWiFi(ssid, password)) {
-        debugPrint("Auto-connect successful");
+        PICOWIFI_LOGI("Auto-connect successful");
         return true;
     } else {
-        debugPrint("Auto-connect failed, starting config portal");
+        PICOWIFI_LOGW("Auto-connect failed, starting config portal");
         return startConfigPortal();
     }
 }
@@ -124,26 +186,86 @@ bool PicoWiFiManager::autoConnect(const char* ssid, const char* password) {
 void PicoWiFiManager::loop() {
     if (!_isInitialized) return;
     
-    // Handle web server
-    if (_server) {
-        _server->handleClient();
+    // In dual-core mode core 1 owns the WiFi stack; core 0 only runs callbacks
+    if (get_core_num() == 0 && (_core1Running || _core1Active)) {
+        dispatchEvents();
+    } else {
+        service();
+    }
+    
+    // Log messages are formatted here, away from the connect and scan paths
+    PicoWiFiLog::drain(LOG_DRAIN_PER_LOOP);
+    MemoryMonitor::sample();
+}
+
+void PicoWiFiManager::service() {
+    // Apply requests made from core 0
+    if (_core1Running) {
+        processCommands();
+    }
+    
+#if PICOWIFI_ENABLE_STATUS_SERVER
+    // Handle the monitoring server
+    if (_statusServer) {
+        _statusServer->handle();
     }
+#endif
     
+#if PICOWIFI_ENABLE_SCANNER
+    // Collect background scan results
+    if (_scanner) {
+        _scanner->update();
+    }
+#endif
+    
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+    // Credentials pushed over serial
+    if (_provisioner) {
+        _provisioner->handle();
+    }
+#endif
+    
+#if PICOWIFI_ENABLE_PORTAL
     // Handle config portal
     if (_portal && _portal->isActive()) {
-        _portal->handle();
+        {
+            HeapScope scope(MemorySubsystem::PORTAL);
+            _portal->handle();
+        }
+        closePortalWhenDone();
     }
+#endif
     
     // Check reset button
     checkResetButton();
     
+    // Advance any pending connection attempt
+    if (isConnectPending()) {
+        pollConnect();
+    }
+    
     // Handle reconnection if needed
     if (!_configMode && _config.autoReconnect) {
         handleReconnection();
     }
     
-    // Update LED
-    updateLED();
+#if PICOWIFI_ENABLE_SCANNER
+    // Watch link quality and roam before the link drops
+    if (_config.roaming.enabled) {
+        updateLinkMonitor();
+    }
+#endif
+    
+    
+    // Refresh the state seen by core 0
+    if (_core1Running) {
+        uint32_t now = millis();
+        bool refreshRadio = now - _lastSnapshotRefresh >= SNAPSHOT_REFRESH_MS;
+        if (refreshRadio) {
+            _lastSnapshotRefresh = now;
+            publishSnapshot(true);
+        }
+    }
     
     // Yield for other tasks
     yield();
@@ -154,181 +276,806 @@ bool PicoWiFiManager::startConfigPortal() {
 }
 
 bool PicoWiFiManager::startConfigPortal(const char* ssid, const char* password) {
-    debugPrintf("Starting config portal: %s", ssid);
+#if !PICOWIFI_ENABLE_PORTAL
+    (void)ssid;
+    (void)password;
+    PICOWIFI_LOGW("Config portal not built (PICOWIFI_ENABLE_PORTAL=0)");
+    return false;
+#else
+    if (shouldForwardToCore1()) {
+        return postCommand(CommandType::START_PORTAL, ssid, password);
+    }
+    
+    PICOWIFI_LOGI("Starting config portal: %s", ssid);
     
-    if (_onConfigStart) _onConfigStart();
+    postEvent(EventType::CONFIG_START);
+    
+#if PICOWIFI_ENABLE_STATUS_SERVER
+    // The portal serves its own pages on port 80
+    if (_statusServer) {
+        _statusServer->stop();
+    }
+#endif
     
     _configMode = true;
     setStatus(ConnectionStatus::CONFIG_MODE);
     
     if (_portal->start(ssid, password)) {
-        debugPrintf("Config portal started at %s", _portal->getAPIP().toString().c_str());
+        PICOWIFI_LOGI("Config portal started at %s", _portal->getAPIP().toString().c_str());
         return true;
     } else {
-        debugPrint("Failed to start config portal");
+        PICOWIFI_LOGE("Failed to start config portal");
         _configMode = false;
         setStatus(ConnectionStatus::ERROR);
         return false;
     }
+#endif
 }
 
 void PicoWiFiManager::stopConfigPortal() {
+    if (shouldForwardToCore1()) {
+        postCommand(CommandType::STOP_PORTAL);
+        return;
+    }
+    
     if (!_configMode) return;
     
-    debugPrint("Stopping config portal");
+#if PICOWIFI_ENABLE_PORTAL
+    PICOWIFI_LOGI("Stopping config portal");
     _portal->stop();
+#endif
     _configMode = false;
+    _portalCloseAt = 0;
+    
+    postEvent(EventType::CONFIG_END);
     
-    if (_onConfigEnd) _onConfigEnd();
+    // Dropping the AP can take the station down too; handleReconnection()
+    // rejoins through the fast-connect cache if it did
+    if (_config.statusServer && PicoWiFiHAL::wifi().status() == WL_CONNECTED) {
+        startStatusServer();
+    }
+}
+
+bool PicoWiFiManager::connectWiFi() {
+    return connectAsync() && waitForConnect(_nextCommandId);
 }
 
 bool PicoWiFiManager::connectWiFi(const char* ssid, const char* password) {
+    return connectAsync(ssid, password) && waitForConnect(_nextCommandId);
+}
+
+bool PicoWiFiManager::waitForConnect(uint32_t command) {
+    // Blocking wrapper around the state machine, used by autoConnect()
+    if (shouldForwardToCore1()) {
+        // Core 1 drives the attempt and reports how this request ended. The
+        // longest it can take is a pre-connect scan, a fast connect and the
+        // full connect after it; past that the request was lost
+        uint32_t limit = (2UL * _config.connectTimeout +
+                          (_config.fastConnect ? _config.fastConnectTimeout : 0)) * 1000UL;
+        uint32_t start = millis();
+        while (_connectDone != command) {
+            if (!_core1Running || millis() - start >= limit) {
+                PICOWIFI_LOGW("No result from core 1 for connect request %lu", (unsigned long)command);
+                return false;
+            }
+            dispatchEvents();
+            PicoWiFiLog::drain(LOG_DRAIN_PER_LOOP);
+            delay(10);
+        }
+        return _connectDoneOK;
+    }
+    
+    while (isConnectPending()) {
+        pollConnect();
+        PicoWiFiLog::drain(LOG_DRAIN_PER_LOOP);
+        delay(10);
+    }
+    
+    return _connectState == ConnectState::CONNECTED;
+}
+
+bool PicoWiFiManager::connectAsync() {
+    if (!_storage || !_storage->hasWiFiCredentials()) {
+        PICOWIFI_LOGW("No saved credentials for async connect");
+        return false;
+    }
+    
+    if (shouldForwardToCore1()) {
+        return postCommand(CommandType::CONNECT_SAVED);
+    }
+    
+    wakeRadio();
+    
+#if PICOWIFI_ENABLE_SCANNER
+    // With several networks saved, find out which are in range first so a
+    // dead primary costs one scan instead of a string of failed joins. The
+    // scan needs the STA interface up, which MODE_SET would only do later;
+    // if the driver still refuses, the last network that worked is tried
+    if (_storage->getNetworkCount() > 1 && _scanner && !_scanner->isCacheValid() &&
+        (_scanner->isScanInProgress() || startPreconnectScan())) {
+        _saveOnConnect = false;
+        _disconnectRequested = false;
+        _fastConnectAttempt = false;
+        _connectStart = millis();
+        _connectOrigin = _connectStart;
+        setStatus(ConnectionStatus::CONNECTING);
+        setConnectState(ConnectState::SCANNING);
+        return true;
+    }
+#endif
+    
+    return connectSavedNetwork();
+}
+
+#if PICOWIFI_ENABLE_SCANNER
+bool PicoWiFiManager::startPreconnectScan() {
+    PicoWiFiHAL::wifi().setMode(keepPortalDuringConnect() ? WIFI_AP_STA : WIFI_STA);
+    return _scanner->startAsyncScan();
+}
+#endif
+
+bool PicoWiFiManager::connectSavedNetwork() {
+    WiFiCredentials credentials;
+    if (!selectSavedNetwork(credentials)) {
+        PICOWIFI_LOGW("No saved credentials for async connect");
+        return false;
+    }
+    return connectAsync(credentials.ssid, credentials.password);
+}
+
+bool PicoWiFiManager::selectSavedNetwork(WiFiCredentials& best) {
+#if PICOWIFI_ENABLE_SCANNER
+    bool found = false;
+    int8_t bestRSSI = -128;
+    
+    // Highest priority among the networks in range, then the strongest
+    if (_scanner && _scanner->isCacheValid()) {
+        WiFiCredentials candidate;
+        ScannedNetwork network;
+        
+        for (uint8_t i = 0; _storage->getNetwork(i, candidate); i++) {
+            if (!_scanner->findNetwork(candidate.ssid, network)) {
+                continue;
+            }
+            
+            if (!found || candidate.priority > best.priority ||
+                (candidate.priority == best.priority && network.rssi > bestRSSI)) {
+                best = candidate;
+                bestRSSI = network.rssi;
+                found = true;
+            }
+        }
+    }
+    
+    if (found) {
+        PICOWIFI_LOGI("Selected saved network %s (%d dBm)", best.ssid, bestRSSI);
+        return true;
+    }
+#endif
+    
+    // Nothing in range, or no scan to go by: the network that last worked
+    return _storage->loadWiFiCredentials(best);
+}
+
+bool PicoWiFiManager::connectAsync(const char* ssid, const char* password) {
     if (!ssid || strlen(ssid) == 0) {
-        debugPrint("Invalid SSID provided");
+        PICOWIFI_LOGW("Invalid SSID provided");
         return false;
     }
     
-    debugPrintf("Connecting to: %s", ssid);
-    setStatus(ConnectionStatus::CONNECTING);
+    // Pick the access point on the core that owns the scanner and radio
+    if (shouldForwardToCore1()) {
+        return postCommand(CommandType::CONNECT, ssid, password);
+    }
+    
+    wakeRadio();
     
-    // Stop any existing connection
-    WiFi.disconnect();
-    delay(100);
+    // Go straight to the last-good AP of a saved network; pollConnect()
+    // falls back to a full connect if it doesn't answer in time
+    if (_config.fastConnect && _storage && _storage->loadFastConnect(ssid, _fastCache)) {
+        if (!connectAsync(ssid, password, _fastCache.bssid, _fastCache.channel)) {
+            return false;
+        }
+        _fastConnectAttempt = true;
+        PICOWIFI_LOGD("Trying fast connect from cache");
+        return true;
+    }
     
-    // Set WiFi mode
-    WiFi.mode(WIFI_STA);
-    delay(100);
+#if PICOWIFI_ENABLE_SCANNER
+    ScannedNetwork best;
+    if (findBestBSSID(ssid, best)) {
+        return connectAsync(ssid, password, best.bssid, best.channel);
+    }
+#endif
     
-    // Apply static IP if configured
-    if (_config.useStaticIP) {
-        // Arduino-Pico WiFi.config parameter order: local_ip, dns_server, gateway, subnet
-        WiFi.config(_config.staticIP, _config.primaryDNS, _config.gateway, _config.subnet);
-        debugPrint("Static IP configuration applied");
+    return connectAsync(ssid, password, nullptr, 0);
+}
+
+#if PICOWIFI_ENABLE_SCANNER
+bool PicoWiFiManager::findBestBSSID(const char* ssid, ScannedNetwork& network) {
+    // Pin to the strongest access point of a multi-AP ESS when one was seen
+    // recently, which also spares the driver its own rescan
+    return _config.pinStrongestBSSID && _scanner && _scanner->isCacheValid() &&
+           _scanner->findNetwork(ssid, network);
+}
+#endif
+
+bool PicoWiFiManager::connectAsync(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel) {
+    if (!ssid || strlen(ssid) == 0) {
+        PICOWIFI_LOGW("Invalid SSID provided");
+        return false;
     }
     
-    // Begin connection
-    if (password && strlen(password) > 0) {
-        WiFi.begin(ssid, password);
+    if (shouldForwardToCore1()) {
+        return postCommand(CommandType::CONNECT, ssid, password, bssid, channel);
+    }
+    
+    wakeRadio();
+    
+    strncpy(_connectSSID, ssid, sizeof(_connectSSID) - 1);
+    _connectSSID[sizeof(_connectSSID) - 1] = '\0';
+    
+    if (password) {
+        strncpy(_connectPassword, password, sizeof(_connectPassword) - 1);
+        _connectPassword[sizeof(_connectPassword) - 1] = '\0';
     } else {
-        WiFi.begin(ssid);
+        memset(_connectPassword, 0, sizeof(_connectPassword));
     }
     
-    // Wait for connection
-    uint32_t startTime = millis();
-    while (WiFi.status() != WL_CONNECTED && 
-           (millis() - startTime) < (_config.connectTimeout * 1000)) {
-        delay(100);
-        updateLED(); // Show connecting status
+    _connectPinned = (bssid != nullptr);
+    if (_connectPinned) {
+        memcpy(_connectBSSID, bssid, sizeof(_connectBSSID));
+    } else {
+        memset(_connectBSSID, 0, sizeof(_connectBSSID));
     }
+    _connectChannel = channel;
     
-    if (WiFi.status() == WL_CONNECTED) {
-        debugPrintf("Connected! IP: %s", WiFi.localIP().toString().c_str());
-        setStatus(ConnectionStatus::CONNECTED);
-        _reconnectAttempts = 0;
+    if (_connectPinned) {
+        PICOWIFI_LOGI("Connecting to: %s via %02X:%02X:%02X:%02X:%02X:%02X (ch %d)", _connectSSID,
+                       _connectBSSID[0], _connectBSSID[1], _connectBSSID[2],
+                       _connectBSSID[3], _connectBSSID[4], _connectBSSID[5], _connectChannel);
+    } else {
+        PICOWIFI_LOGI("Connecting to: %s", _connectSSID);
+    }
+    _saveOnConnect = false;
+    _disconnectRequested = false;
+    _fastConnectAttempt = false;
+    _connectStart = millis();
+    _connectOrigin = _connectStart;
+    setStatus(ConnectionStatus::CONNECTING);
+    
+    // Stop any existing connection; the radio settles in MODE_SET. With the
+    // portal in AP+STA mode the AP has to stay up, so the join replaces the
+    // old association instead
+    if (!keepPortalDuringConnect()) {
+        PicoWiFiHAL::wifi().disconnect();
+    }
+    setConnectState(ConnectState::MODE_SET);
+    return true;
+}
+
+ConnectState PicoWiFiManager::pollConnect() {
+    if (!isConnectPending()) {
+        return _connectState;
+    }
+    
+    uint32_t now = millis();
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    uint32_t timeout = _fastConnectAttempt ? _config.fastConnectTimeout : _config.connectTimeout;
+    
+    if (now - _connectStart >= timeout * 1000UL) {
+        PICOWIFI_LOGW("Connection timed out");
+        setConnectState(ConnectState::FAILED);
+    }
+    
+    switch (_connectState) {
+        case ConnectState::SCANNING: {
+#if PICOWIFI_ENABLE_SCANNER
+            _scanner->update(); // loop() isn't running during autoConnect()
+            if (_scanner->isScanInProgress()) {
+                break;
+            }
+#endif
+            
+            uint32_t origin = _connectOrigin;
+            if (connectSavedNetwork()) {
+                _connectOrigin = origin;
+            } else {
+                setConnectState(ConnectState::FAILED);
+            }
+            break;
+        }
+            
+        case ConnectState::MODE_SET:
+            if (now - _connectStepStart < CONNECT_SETTLE_MS) {
+                break;
+            }
+            
+            wifi.setMode(keepPortalDuringConnect() ? WIFI_AP_STA : WIFI_STA);
+            
+            // Apply static IP if configured
+            if (_config.useStaticIP) {
+                // Arduino-Pico WiFi.config parameter order: local_ip, dns_server, gateway, subnet
+                wifi.config(_config.staticIP, _config.primaryDNS, _config.gateway, _config.subnet);
+                PICOWIFI_LOGD("Static IP configuration applied");
+            } else if (_fastConnectAttempt && _config.fastConnectReuseLease && _fastCache.ip != 0) {
+                wifi.config(IPAddress(_fastCache.ip), IPAddress(_fastCache.dns),
+                            IPAddress(_fastCache.gateway), IPAddress(_fastCache.subnet));
+                _leaseApplied = true;
+                PICOWIFI_LOGD("Reusing cached DHCP lease");
+            } else if (_leaseApplied) {
+                // An all-zero config hands the interface back to DHCP
+                wifi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+                _leaseApplied = false;
+            }
+            
+            // Issue the join without waiting for the result
+            wifi.beginNoBlock(_connectSSID, strlen(_connectPassword) > 0 ? _connectPassword : nullptr,
+                              _connectPinned ? _connectBSSID : nullptr);
+            setConnectState(ConnectState::ASSOCIATING);
+            break;
+            
+        case ConnectState::ASSOCIATING: {
+            uint8_t wifiStatus = wifi.status();
+            if (wifiStatus == WL_CONNECTED) {
+                setConnectState(ConnectState::DHCP);
+            } else if (wifiStatus == WL_CONNECT_FAILED || wifiStatus == WL_NO_SSID_AVAIL) {
+                PICOWIFI_LOGW("Association rejected");
+                setConnectState(ConnectState::FAILED);
+            }
+            break;
+        }
+            
+        case ConnectState::DHCP:
+            if (wifi.localIP() != INADDR_NONE) {
+                setConnectState(ConnectState::CONNECTED);
+            }
+            break;
+            
+        default:
+            break;
+    }
+    
+    if (_connectState == ConnectState::FAILED && _fastConnectAttempt) {
+        fallbackToFullConnect();
+    }
+    
+    if (_connectState == ConnectState::CONNECTED) {
+        _lastConnectDuration = now - _connectOrigin;
+        _lastConnectFast = _fastConnectAttempt;
+        PICOWIFI_LOGI("Connected! IP: %s", wifi.localIP().toString().c_str());
+        PICOWIFI_LOGI("Connect took %lu ms (%s)", (unsigned long)_lastConnectDuration,
+                       _lastConnectFast ? "fast connect" : "full connect");
+        _timing.completed(now, _lastConnectDuration, _lastConnectFast, _reconnect.isActive(),
+                          _power.getPolicy().mode);
+        publishTiming();
+        if (_reconnect.isActive()) {
+            _reconnect.recovered(now);
+            PICOWIFI_LOGI("Link recovered after %lu ms", (unsigned long)_reconnect.getStats().lastRecoveryTime);
+        }
         
-        if (_onConnect) _onConnect();
-        return true;
+        if (_saveOnConnect) {
+            _saveOnConnect = false;
+            _storage->saveWiFiCredentials(_connectSSID, _connectPassword);
+            
+#if PICOWIFI_ENABLE_PORTAL
+            if (keepPortalDuringConnect()) {
+                // Leave the AP up until the phone has seen the result
+                _portal->setProvisionResult(ProvisionState::CONNECTED, wifi.localIP());
+                _portalCloseAt = now + PROVISION_CLOSE_MS;
+            } else {
+                stopConfigPortal();
+            }
+#else
+            stopConfigPortal();
+#endif
+        }
+        
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+        if (_provisioner && _provisioner->isAwaitingConnect()) {
+            _provisioner->reportConnect(true, (uint32_t)wifi.localIP(), _lastConnectDuration, _lastConnectFast);
+            // Provisioned on the line, so the portal has nothing left to do
+            stopConfigPortal();
+        }
+#endif
+        
+        recordSuccessfulConnect();
+        _link.reset();
+        applyPowerPolicy();
+        
+#if PICOWIFI_ENABLE_STATUS_SERVER
+        if (_config.statusServer && !_configMode) {
+            startStatusServer();
+        }
+#endif
+        
+        setStatus(ConnectionStatus::CONNECTED);
+        postEvent(EventType::CONNECTED);
+    } else if (_connectState == ConnectState::FAILED) {
+        PICOWIFI_LOGW("Connection failed");
+#if PICOWIFI_ENABLE_PORTAL
+        if (_saveOnConnect && _configMode) {
+            _portal->setProvisionResult(ProvisionState::FAILED);
+        }
+#endif
+        _saveOnConnect = false;
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+        if (_provisioner) {
+            _provisioner->reportConnect(false, 0, now - _connectOrigin, false);
+        }
+#endif
+        _timing.failed();
+        publishTiming();
+        setStatus(_configMode ? ConnectionStatus::CONFIG_MODE : ConnectionStatus::DISCONNECTED);
+    }
+    
+    if (!isConnectPending()) {
+        finishConnectCommand(_connectState == ConnectState::CONNECTED);
+    }
+    
+    return _connectState;
+}
+
+ConnectState PicoWiFiManager::getConnectState() const {
+    return _connectState;
+}
+
+uint32_t PicoWiFiManager::getLastConnectDuration() const {
+    return _lastConnectDuration;
+}
+
+bool PicoWiFiManager::wasFastConnect() const {
+    return _lastConnectFast;
+}
+
+void PicoWiFiManager::fallbackToFullConnect() {
+    PICOWIFI_LOGW("Fast connect failed after %lu ms, falling back to full connect",
+                   (unsigned long)(millis() - _connectStart));
+    
+    // connectAsync() resets the attempt; keep what belongs to the request
+    char ssid[sizeof(_connectSSID)];
+    char password[sizeof(_connectPassword)];
+    memcpy(ssid, _connectSSID, sizeof(ssid));
+    memcpy(password, _connectPassword, sizeof(password));
+    bool saveOnConnect = _saveOnConnect;
+    uint32_t origin = _connectOrigin;
+    
+#if PICOWIFI_ENABLE_SCANNER
+    ScannedNetwork best;
+    if (findBestBSSID(ssid, best)) {
+        connectAsync(ssid, password, best.bssid, best.channel);
     } else {
-        debugPrint("Connection failed");
-        setStatus(ConnectionStatus::DISCONNECTED);
-        return false;
+        connectAsync(ssid, password, nullptr, 0);
     }
+#else
+    connectAsync(ssid, password, nullptr, 0);
+#endif
+    
+    _saveOnConnect = saveOnConnect;
+    _connectOrigin = origin;
 }
 
-void PicoWiFiManager::handleReconnection() {
-    if (WiFi.status() == WL_CONNECTED || _configMode) {
+void PicoWiFiManager::recordSuccessfulConnect() {
+    if (!_storage) return;
+    
+    // Unsaved networks are ignored by markConnected()
+    if (!_config.fastConnect) {
+        _storage->markConnected(_connectSSID);
         return;
     }
     
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    FastConnectCache cache;
+    cache.valid = 1;
+    cache.channel = wifi.channel();
+    wifi.BSSID(cache.bssid);
+    
+    // A static configuration is applied anyway; only cache real leases
+    if (!_config.useStaticIP) {
+        cache.ip = (uint32_t)wifi.localIP();
+        cache.gateway = (uint32_t)wifi.gatewayIP();
+        cache.subnet = (uint32_t)wifi.subnetMask();
+        cache.dns = (uint32_t)wifi.dnsIP();
+    }
+    
+    _storage->markConnected(_connectSSID, &cache);
+}
+
+bool PicoWiFiManager::isConnectPending() const {
+    return _connectState == ConnectState::SCANNING ||
+           _connectState == ConnectState::MODE_SET ||
+           _connectState == ConnectState::ASSOCIATING ||
+           _connectState == ConnectState::DHCP;
+}
+
+void PicoWiFiManager::handleReconnection() {
     uint32_t now = millis();
-    if (now - _lastReconnectAttempt < 10000) { // Wait 10 seconds between attempts
+    
+    if (PicoWiFiHAL::wifi().status() == WL_CONNECTED) {
+        // The driver may rejoin on its own between our attempts
+        if (_reconnect.isActive() && !isConnectPending()) {
+            _reconnect.recovered(now);
+        }
         return;
     }
     
-    if (_reconnectAttempts >= _config.maxReconnectAttempts) {
-        debugPrint("Max reconnection attempts reached, starting config portal");
+    if (_configMode || isConnectPending() || _disconnectRequested) {
+        return;
+    }
+    
+    if (!_reconnect.isActive()) {
+        _reconnect.begin(now);
+        PICOWIFI_LOGW("Link lost, reconnecting in %lu ms", (unsigned long)_reconnect.getCurrentDelay());
+        return;
+    }
+    
+    if (_reconnect.isInFlight()) {
+        _reconnect.attemptFailed(now);
+        PICOWIFI_LOGD("Next reconnection attempt in %lu ms", (unsigned long)_reconnect.getCurrentDelay());
+    }
+    
+    if (!_reconnect.isDue(now)) {
+        return;
+    }
+    
+    if (_config.reconnectPolicy.fallbackToPortal &&
+        _reconnect.getAttempts() >= _config.maxReconnectAttempts) {
+        PICOWIFI_LOGW("Max reconnection attempts reached, starting config portal");
+        _reconnect.countPortalFallback();
+        _reconnect.cancel();
         startConfigPortal();
         return;
     }
     
-    debugPrintf("Reconnection attempt %d/%d", _reconnectAttempts + 1, _config.maxReconnectAttempts);
-    _lastReconnectAttempt = now;
-    _reconnectAttempts++;
+    _reconnect.attemptStarted(now);
+    if (_config.reconnectPolicy.fallbackToPortal) {
+        PICOWIFI_LOGI("Reconnection attempt %d/%d", _reconnect.getAttempts(), _config.maxReconnectAttempts);
+    } else {
+        PICOWIFI_LOGI("Reconnection attempt %d", _reconnect.getAttempts());
+    }
     
-    WiFiCredentials credentials;
-    if (_storage->loadWiFiCredentials(credentials) && credentials.valid) {
-        connectWiFi(credentials.ssid, credentials.password);
+    connectAsync();
+}
+
+#if PICOWIFI_ENABLE_SCANNER
+void PicoWiFiManager::updateLinkMonitor() {
+    if (_configMode || isConnectPending() || !_scanner || PicoWiFiHAL::wifi().status() != WL_CONNECTED) {
+        _roamScanPending = false;
+        return;
+    }
+    
+    if (_roamScanPending) {
+        if (!_scanner->isScanInProgress()) {
+            _roamScanPending = false;
+            roamIfBetter();
+        }
+        return;
+    }
+    
+    uint32_t now = millis();
+    if (!_link.isSampleDue(now)) {
+        return;
+    }
+    
+    if (_link.sample(now, PicoWiFiHAL::wifi().RSSI()) && _scanner->startAsyncScan()) {
+        PICOWIFI_LOGW("Link degraded (%d dBm), scanning for a stronger AP", _link.getQuality().rssi);
+        _roamScanPending = true;
     }
 }
 
-void PicoWiFiManager::updateLED() {
-    if (_config.ledPin == 255) return; // LED disabled
+void PicoWiFiManager::roamIfBetter() {
+    // Only networks joined through connectAsync() have their password at hand
+    const char* current = PicoWiFiHAL::wifi().SSID();
+    if (!current || strcmp(current, _connectSSID) != 0) {
+        return;
+    }
+    
+    ScannedNetwork best;
+    if (!_scanner->findNetwork(_connectSSID, best)) {
+        return;
+    }
+    
+    uint8_t associated[6];
+    PicoWiFiHAL::wifi().BSSID(associated);
+    if (memcmp(best.bssid, associated, sizeof(associated)) == 0 || !_link.isBetter(best.rssi)) {
+        PICOWIFI_LOGD("No stronger AP in range");
+        return;
+    }
+    
+    PICOWIFI_LOGI("Roaming to %02X:%02X:%02X:%02X:%02X:%02X (%d dBm, was %d dBm)",
+                   best.bssid[0], best.bssid[1], best.bssid[2], best.bssid[3], best.bssid[4], best.bssid[5],
+                   best.rssi, _link.getQuality().rssi);
+    _link.countRoam();
+    
+    // connectAsync() copies into the buffers these come from
+    char ssid[sizeof(_connectSSID)];
+    char password[sizeof(_connectPassword)];
+    memcpy(ssid, _connectSSID, sizeof(ssid));
+    memcpy(password, _connectPassword, sizeof(password));
+    connectAsync(ssid, password, best.bssid, best.channel);
+}
+#endif
+
+bool PicoWiFiManager::keepPortalDuringConnect() const {
+#if PICOWIFI_ENABLE_PORTAL
+    return _configMode && _config.apStaProvisioning && _portal && _portal->isActive();
+#else
+    return false;
+#endif
+}
+
+#if PICOWIFI_ENABLE_PORTAL
+void PicoWiFiManager::closePortalWhenDone() {
+    if (_portalCloseAt == 0) {
+        return;
+    }
     
     uint32_t now = millis();
-    uint32_t interval;
+    uint32_t delivered = _portal->getResultDeliveredAt();
+    if ((delivered != 0 && now - delivered >= PROVISION_LINGER_MS) ||
+        (int32_t)(now - _portalCloseAt) >= 0) {
+        PICOWIFI_LOGI("Provisioning complete");
+        stopConfigPortal();
+    }
+}
+#endif
+
+void PicoWiFiManager::applyPowerPolicy() {
+    // Applied after every join so it also covers a radio that was re-initialized
+    if (_power.apply()) {
+        PICOWIFI_LOGI("Radio power save: %s", PowerController::getModeName(_power.getPolicy().mode));
+    } else {
+        PICOWIFI_LOGW("Failed to set radio power save: %s", PowerController::getModeName(_power.getPolicy().mode));
+    }
+}
+
+void PicoWiFiManager::wakeRadio() {
+    if (_radioPowered) {
+        return;
+    }
+    
+    // Runs before the connect's clock starts; ConnectTiming adds it to the
+    // ready time of the connect that needed it
+    uint32_t start = millis();
+    PicoWiFiHAL::wifi().powerOn();
+    _radioPowered = true;
+    uint32_t elapsed = millis() - start;
+    _timing.addPhase(ConnectPhase::RADIO_ON, elapsed);
+    PICOWIFI_LOGD("Radio powered up in %lu ms", (unsigned long)elapsed);
+}
+
+void PicoWiFiManager::powerDownRadio() {
+    if (shouldForwardToCore1()) {
+        postCommand(CommandType::RADIO_OFF);
+        return;
+    }
+    
+    if (!_radioPowered) {
+        return;
+    }
+    PicoWiFiHAL::wifi().powerOff();
+    _radioPowered = false;
+    PICOWIFI_LOGD("Radio powered down");
+}
+
+void PicoWiFiManager::startSerialProvisioning() {
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+    if (!_provisioner) {
+        _provisioner.create(_storage.get());
+        // Saved already, so connect without _saveOnConnect
+        _provisioner->onProvisioned([this](const WiFiCredentials& credentials) {
+            return connectAsync(credentials.ssid, credentials.password);
+        });
+    }
+    _provisioner->begin(_config.provisioningStream ? _config.provisioningStream : &Serial);
+#else
+    PICOWIFI_LOGW("Serial provisioning not built (PICOWIFI_ENABLE_SERIAL_PROVISIONING=0)");
+#endif
+}
+
+void PicoWiFiManager::startStatusServer() {
+#if PICOWIFI_ENABLE_STATUS_SERVER
+    if (!_statusServer) {
+        _statusServer.create(this);
+#if PICOWIFI_ENABLE_SCANNER
+        _statusServer->setScanner(_scanner.get());
+#endif
+    }
     
+    if (!_statusServer->isActive() && _statusServer->start(_config.statusServerPort)) {
+        PICOWIFI_LOGI("Status server at http://%s:%u/metrics", PicoWiFiHAL::wifi().localIP().toString().c_str(),
+                       _config.statusServerPort);
+    }
+#endif
+}
+
+void PicoWiFiManager::updateLED() {
+    // The pattern itself runs from a timer; this only picks it on status changes
     switch (_status) {
         case ConnectionStatus::CONNECTED:
-            digitalWrite(_config.ledPin, HIGH);
-            return;
+            _led.setMode(LEDMode::ON);
+            break;
             
         case ConnectionStatus::CONNECTING:
-            interval = 200; // Fast blink
+            _led.setMode(LEDMode::SLOW_BLINK);
             break;
             
         case ConnectionStatus::CONFIG_MODE:
-            interval = 100; // Very fast blink
+            _led.setMode(LEDMode::FAST_BLINK);
             break;
             
         case ConnectionStatus::ERROR:
-            interval = 1000; // Slow blink
+            _led.setMode(LEDMode::PULSE);
             break;
             
         default:
-            digitalWrite(_config.ledPin, LOW);
-            return;
-    }
-    
-    if (now - _lastLEDUpdate >= interval) {
-        _ledState = !_ledState;
-        digitalWrite(_config.ledPin, _ledState);
-        _lastLEDUpdate = now;
+            _led.setMode(LEDMode::OFF);
+            break;
     }
 }
 
 void PicoWiFiManager::setStatus(ConnectionStatus status) {
     if (_status != status) {
         _status = status;
-        debugPrintf("Status changed to: %s", getStatusString().c_str());
+        PICOWIFI_LOGI("Status changed to: %s", getStatusString().c_str());
+        updateLED();
+        
+        postEvent(EventType::STATUS_CHANGE, (uint8_t)status);
+    }
+}
+
+void PicoWiFiManager::setConnectState(ConnectState state) {
+    if (_connectState != state) {
+        uint32_t now = millis();
         
-        if (_onStatusChange) {
-            _onStatusChange(status);
+        // Charge the time spent in the step being left to its phase
+        switch (_connectState) {
+            case ConnectState::SCANNING:
+                _timing.addPhase(ConnectPhase::SCAN, now - _connectStepStart);
+                break;
+            case ConnectState::MODE_SET:
+                _timing.addPhase(ConnectPhase::MODE_SET, now - _connectStepStart);
+                break;
+            case ConnectState::ASSOCIATING:
+                _timing.addPhase(ConnectPhase::ASSOCIATE, now - _connectStepStart);
+                break;
+            case ConnectState::DHCP:
+                _timing.addPhase(ConnectPhase::DHCP, now - _connectStepStart);
+                break;
+            default:
+                break;
         }
+        
+        _connectState = state;
+        _connectStepStart = now;
+        PICOWIFI_LOGD("Connect state: %s", getConnectStateString(state));
+        
+        postEvent(EventType::CONNECT_STATE, (uint8_t)state);
+    }
+}
+
+const char* PicoWiFiManager::getConnectStateString(ConnectState state) const {
+    switch (state) {
+        case ConnectState::IDLE: return "Idle";
+        case ConnectState::SCANNING: return "Scanning";
+        case ConnectState::MODE_SET: return "Mode Set";
+        case ConnectState::ASSOCIATING: return "Associating";
+        case ConnectState::DHCP: return "DHCP";
+        case ConnectState::CONNECTED: return "Connected";
+        case ConnectState::FAILED: return "Failed";
+        default: return "Unknown";
     }
 }
 
 void PicoWiFiManager::checkResetButton() {
-    if (_config.resetPin == 255) return; // Reset button disabled
-    
-    static uint32_t pressStart = 0;
-    static bool pressed = false;
-    
-    bool currentState = digitalRead(_config.resetPin) == LOW;
-    
-    if (currentState && !pressed) {
-        // Button just pressed
-        pressed = true;
-        pressStart = millis();
-    } else if (!currentState && pressed) {
-        // Button released
-        pressed = false;
-        uint32_t pressDuration = millis() - pressStart;
-        
-        if (pressDuration > 3000) { // Long press - factory reset
-            debugPrint("Factory reset triggered");
+    // Presses are timed in interrupt context; only finished gestures arrive here
+    ButtonGesture gesture;
+    while (_button.poll(gesture)) {
+        if (gesture == ButtonGesture::LONG_PRESS) {
+            PICOWIFI_LOGI("Factory reset triggered");
             reset();
-        } else if (pressDuration > 100) { // Short press - restart config portal
-            debugPrint("Config portal restart triggered");
+        } else {
+            PICOWIFI_LOGI("Config portal restart triggered");
             if (!_configMode) {
                 startConfigPortal();
             }
@@ -337,10 +1084,15 @@ void PicoWiFiManager::checkResetButton() {
 }
 
 void PicoWiFiManager::reset() {
-    debugPrint("Performing factory reset");
+    if (shouldForwardToCore1()) {
+        postCommand(CommandType::RESET);
+        return;
+    }
+    
+    PICOWIFI_LOGI("Performing factory reset");
     
     stopConfigPortal();
-    WiFi.disconnect();
+    PicoWiFiHAL::wifi().disconnect();
     
     if (_storage) {
         _storage->clearAll();
@@ -350,13 +1102,54 @@ void PicoWiFiManager::reset() {
     rp2040.restart();
 }
 
+void PicoWiFiManager::disconnect() {
+    if (shouldForwardToCore1()) {
+        postCommand(CommandType::DISCONNECT);
+        return;
+    }
+    
+    PICOWIFI_LOGI("Disconnecting");
+    if (isConnectPending()) {
+        _timing.failed();
+        publishTiming();
+    }
+    setConnectState(ConnectState::IDLE);
+    finishConnectCommand(false);
+    _disconnectRequested = true;
+    _reconnect.cancel();
+    PicoWiFiHAL::wifi().disconnect();
+    setStatus(ConnectionStatus::DISCONNECTED);
+    
+    postEvent(EventType::DISCONNECTED);
+}
+
 // Getters
 ConnectionStatus PicoWiFiManager::getStatus() const {
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.status;
+    }
     return _status;
 }
 
+void PicoWiFiManager::getStatusSnapshot(StatusSnapshot& snapshot) const {
+    if (readSnapshot(snapshot)) {
+        return;
+    }
+    
+    snapshot.status = _status;
+    snapshot.connectState = _connectState;
+    snapshot.configMode = _configMode;
+    snapshot.wifiConnected = PicoWiFiHAL::wifi().status() == WL_CONNECTED;
+    snapshot.localIP = (uint32_t)PicoWiFiHAL::wifi().localIP();
+    snapshot.rssi = PicoWiFiHAL::wifi().RSSI();
+    strncpy(snapshot.ssid, PicoWiFiHAL::wifi().SSID(), sizeof(snapshot.ssid) - 1);
+    snapshot.ssid[sizeof(snapshot.ssid) - 1] = '\0';
+    snapshot.updatedAt = millis();
+}
+
 String PicoWiFiManager::getStatusString() const {
-    switch (_status) {
+    switch (getStatus()) {
         case ConnectionStatus::DISCONNECTED: return "Disconnected";
         case ConnectionStatus::CONNECTING: return "Connecting";
         case ConnectionStatus::CONNECTED: return "Connected";
@@ -367,27 +1160,60 @@ String PicoWiFiManager::getStatusString() const {
 }
 
 bool PicoWiFiManager::isConnected() const {
-    return _status == ConnectionStatus::CONNECTED && WiFi.status() == WL_CONNECTED;
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.status == ConnectionStatus::CONNECTED && snapshot.wifiConnected;
+    }
+    return _status == ConnectionStatus::CONNECTED && PicoWiFiHAL::wifi().status() == WL_CONNECTED;
 }
 
 bool PicoWiFiManager::isConfigMode() const {
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.configMode;
+    }
     return _configMode;
 }
 
 String PicoWiFiManager::getSSID() const {
-    return WiFi.SSID();
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return String(snapshot.ssid);
+    }
+    return PicoWiFiHAL::wifi().SSID();
 }
 
 IPAddress PicoWiFiManager::getLocalIP() const {
-    return WiFi.localIP();
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return IPAddress(snapshot.localIP);
+    }
+    return PicoWiFiHAL::wifi().localIP();
 }
 
 int32_t PicoWiFiManager::getRSSI() const {
-    return WiFi.RSSI();
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.rssi;
+    }
+    return PicoWiFiHAL::wifi().RSSI();
+}
+
+LinkQuality PicoWiFiManager::getLinkQuality() const {
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.link;
+    }
+    return _link.getQuality();
 }
 
 String PicoWiFiManager::getMACAddress() const {
-    return WiFi.macAddress();
+    uint8_t mac[6];
+    char buffer[18];
+    PicoWiFiHAL::wifi().macAddress(mac);
+    snprintf(buffer, sizeof(buffer), "%02X:%02X:%02X:%02X:%02X:%02X",
+             mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    return String(buffer);
 }
 
 uint32_t PicoWiFiManager::getUptime() const {
@@ -398,10 +1224,120 @@ size_t PicoWiFiManager::getFreeHeap() const {
     return rp2040.getFreeHeap();
 }
 
+size_t PicoWiFiManager::getMinFreeHeap() const {
+    return MemoryMonitor::getMinFree();
+}
+
+size_t PicoWiFiManager::getPeakHeapUsed() const {
+    return MemoryMonitor::getPeakUsed();
+}
+
+size_t PicoWiFiManager::getCore1StackUsed() const {
+    if (!_core1StackPainted) return 0;
+    return MemoryMonitor::getStackUsed(_core1Stack, CORE1_STACK_SIZE / sizeof(uint32_t));
+}
+
+ReconnectStats PicoWiFiManager::getReconnectStats() const {
+    StatusSnapshot snapshot;
+    if (readSnapshot(snapshot)) {
+        return snapshot.reconnect;
+    }
+    return _reconnect.getStats();
+}
+
+void PicoWiFiManager::getConnectTiming(ConnectTiming& timing) const {
+    if (shouldForwardToCore1() && _timingSnapshot.read(timing)) {
+        return;
+    }
+    timing = _timing;
+}
+
+void PicoWiFiManager::notifyFirstPacket() {
+    if (shouldForwardToCore1()) {
+        postCommand(CommandType::FIRST_PACKET);
+        return;
+    }
+    
+    if (_timing.firstPacket(millis())) {
+        PICOWIFI_LOGD("First packet %lu ms after connect",
+                       (unsigned long)_timing.getLast().phase[(uint8_t)ConnectPhase::FIRST_PACKET]);
+        publishTiming();
+    }
+}
+
+// Power management
+void PicoWiFiManager::setPowerPolicy(const PowerPolicy& policy) {
+    _config.powerPolicy = policy;
+    _power.setPolicy(policy);
+    // cyw43_wifi_pm() takes the driver lock, so this is safe from either core
+    if (_isInitialized && PicoWiFiHAL::wifi().status() == WL_CONNECTED) {
+        applyPowerPolicy();
+    }
+}
+
+bool PicoWiFiManager::runDutyCycle(uint32_t period, DutyCycleTask task) {
+    uint32_t wakeAt = millis();
+    
+    // The fast-connect cache keeps the join short enough to repeat every cycle
+    bool success = isConnected() || connectWiFi();
+    if (!success) {
+        PICOWIFI_LOGW("Duty cycle: no connection, task skipped");
+    } else if (task) {
+        success = task();
+    }
+    
+    disconnect();
+    
+    uint32_t awake = millis() - wakeAt;
+    uint32_t sleep = awake < period ? period - awake : 0;
+    _power.recordCycle(success, awake, sleep);
+    
+    // Off rather than just disassociated; the next connect powers it up
+    if (sleep > 0 && _power.getPolicy().radioOffWhileSleeping) {
+        powerDownRadio();
+    }
+    PICOWIFI_LOGI("Duty cycle %s: awake %lu ms, sleeping %lu ms", success ? "done" : "failed",
+                   (unsigned long)awake, (unsigned long)sleep);
+    
+    // Print everything now rather than on the next wake
+    PicoWiFiLog::flush();
+    
+    // arduino-pico's delay() waits in WFE rather than spinning
+    if (sleep > 0) {
+        delay(sleep);
+    }
+    return success;
+}
+
+DutyCycleStats PicoWiFiManager::getDutyCycleStats() const {
+    return _power.getDutyCycleStats();
+}
+
 // Configuration setters
 void PicoWiFiManager::setConfig(const PicoWiFiConfig& config) {
     _config = config;
-    _debugEnabled = config.enableSerial;
+    _reconnect.setPolicy(config.reconnectPolicy);
+    setPowerPolicy(config.powerPolicy);
+    _link.setConfig(config.roaming);
+    if (_isInitialized) {
+        _button.begin(config.resetPin);
+        _led.begin(config.ledPin);
+        updateLED();
+        if (config.serialProvisioning) {
+            startSerialProvisioning();
+        }
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+        else if (_provisioner) {
+            _provisioner->end();
+        }
+#endif
+    }
+#if PICOWIFI_ENABLE_PORTAL
+    if (_portal) {
+        _portal->setKeepStation(config.apStaProvisioning);
+    }
+#endif
+    PicoWiFiLog::setEnabled(config.enableSerial);
 }
 
 void PicoWiFiManager::setDeviceName(const char* name) {
@@ -415,6 +1351,20 @@ void PicoWiFiManager::setTimeout(uint16_t seconds) {
     _config.configPortalTimeout = seconds;
 }
 
+void PicoWiFiManager::setResetPin(uint8_t pin) {
+    _config.resetPin = pin;
+    if (_isInitialized) {
+        _button.begin(pin);
+    }
+}
+
+void PicoWiFiManager::setLEDPin(uint8_t pin) {
+    _config.ledPin = pin;
+    if (_isInitialized) {
+        _led.begin(pin);
+    }
+}
+
 // Callback setters
 void PicoWiFiManager::onConfigModeStart(PicoWiFiCallback callback) {
     _onConfigStart = callback;
@@ -436,8 +1386,12 @@ void PicoWiFiManager::onStatusChange(StatusCallback callback) {
     _onStatusChange = callback;
 }
 
+void PicoWiFiManager::onConnectStateChange(ConnectStateCallback callback) {
+    _onConnectStateChange = callback;
+}
+
 void PicoWiFiManager::enableDebug(bool enable) {
-    _debugEnabled = enable;
+    PicoWiFiLog::setEnabled(enable);
 }
 
 bool PicoWiFiManager::isDualCoreEnabled() const {
@@ -446,32 +1400,292 @@ bool PicoWiFiManager::isDualCoreEnabled() const {
 
 void PicoWiFiManager::enableDualCore(bool enable) {
     _dualCoreEnabled = enable;
+    
+    if (enable && _isInitialized) {
+        startCore1();
+    } else if (!enable) {
+        stopCore1();
+    }
+}
+
+bool PicoWiFiManager::isDualCoreRunning() const {
+    return _core1Running;
+}
+
+bool PicoWiFiManager::startCore1() {
+    if (_core1Running) return true;
+    
+    if (get_core_num() != 0) {
+        PICOWIFI_LOGE("Dual-core mode must be started from core 0");
+        return false;
+    }
+    
+    if (!_commandQueueReady) {
+        queue_init(&_commandQueue, sizeof(Command), COMMAND_QUEUE_DEPTH);
+        _commandQueueReady = true;
+    }
+    
+    // Flash commits from core 1 need to be able to pause core 0
+    multicore_lockout_victim_init();
+    
+    // Seed the snapshot before core 0 starts reading it
+    publishSnapshot(true);
+    _lastSnapshotRefresh = millis();
+    _timingSnapshot.write(_timing);
+    
+    // Painted once, so the watermark covers every run since boot
+    if (!_core1StackPainted) {
+        MemoryMonitor::paintStack(_core1Stack, CORE1_STACK_SIZE / sizeof(uint32_t));
+        _core1StackPainted = true;
+    }
+    
+    _core1Running = true;
+    multicore_launch_core1_with_stack(core1Task, _core1Stack, sizeof(_core1Stack));
+    
+    PICOWIFI_LOGI("WiFi stack moved to core 1");
+    return true;
+}
+
+void PicoWiFiManager::stopCore1() {
+    if (!_core1Running) return;
+    
+    // Core 1 finishes its current pass, then core 0 takes over in loop()
+    _core1Running = false;
+    uint32_t start = millis();
+    while (_core1Active && millis() - start < 1000) {
+        delay(1);
+    }
+    
+    multicore_reset_core1();
+    _core1Active = false;
+    
+    // Deliver anything core 1 queued before it stopped
+    dispatchEvents();
+    PICOWIFI_LOGI("WiFi stack returned to core 0");
+}
+
+void PicoWiFiManager::core1Task() {
+    // Lets flash commits on core 0 pause this core
+    multicore_lockout_victim_init();
+    
+    if (_instance) {
+        _instance->runCore1();
+    }
+}
+
+void PicoWiFiManager::runCore1() {
+    _core1Active = true;
+    
+    while (_core1Running) {
+        service();
+    }
+    
+    _core1Active = false;
+}
+
+bool PicoWiFiManager::shouldForwardToCore1() const {
+    return _core1Running && get_core_num() == 0;
+}
+
+bool PicoWiFiManager::postCommand(CommandType type, const char* ssid, const char* password,
+                                  const uint8_t* bssid, uint8_t channel) {
+    Command command;
+    memset(&command, 0, sizeof(command));
+    command.type = type;
+    
+    if (ssid) {
+        strncpy(command.ssid, ssid, sizeof(command.ssid) - 1);
+    }
+    if (password) {
+        strncpy(command.password, password, sizeof(command.password) - 1);
+    }
+    if (bssid) {
+        memcpy(command.bssid, bssid, sizeof(command.bssid));
+        command.pinned = true;
+    }
+    command.channel = channel;
+    command.postedAt = millis();
+    
+    // Zero never names a request
+    if (++_nextCommandId == 0) _nextCommandId = 1;
+    command.id = _nextCommandId;
+    
+    if (!queue_try_add(&_commandQueue, &command)) {
+        PICOWIFI_LOGW("Core 1 command queue full");
+        return false;
+    }
+    return true;
+}
+
+void PicoWiFiManager::postEvent(EventType type, uint8_t value, uint32_t command) {
+    Event event = { type, value, command };
+    
+    if (!_core1Running) {
+        dispatchEvent(event);
+        return;
+    }
+    
+    // State transitions are visible to core 0 before their callbacks run
+    publishSnapshot(false);
+    if (!_events.push(event)) {
+        PICOWIFI_LOGW("Event queue full, event dropped");
+    }
 }
 
-// Debug helpers
-void PicoWiFiManager::debugPrint(const String& message) const {
-    if (_debugEnabled) {
-        Serial.printf("[PicoWiFiManager] %s\n", message.c_str());
+void PicoWiFiManager::dispatchEvent(const Event& event) {
+    HeapScope scope(MemorySubsystem::CALLBACKS);
+    
+    switch (event.type) {
+        case EventType::CONFIG_START:
+            if (_onConfigStart) _onConfigStart();
+            break;
+        case EventType::CONFIG_END:
+            if (_onConfigEnd) _onConfigEnd();
+            break;
+        case EventType::CONNECTED:
+            if (_onConnect) _onConnect();
+            break;
+        case EventType::DISCONNECTED:
+            if (_onDisconnect) _onDisconnect();
+            break;
+        case EventType::STATUS_CHANGE:
+            if (_onStatusChange) _onStatusChange((ConnectionStatus)event.value);
+            break;
+        case EventType::CONNECT_STATE:
+            if (_onConnectStateChange) _onConnectStateChange((ConnectState)event.value);
+            break;
+        case EventType::CONNECT_DONE:
+            _connectDone = event.command;
+            _connectDoneOK = event.value != 0;
+            break;
     }
 }
 
-void PicoWiFiManager::debugPrintf(const char* format, ...) const {
-    if (_debugEnabled) {
-        va_list args;
-        va_start(args, format);
-        Serial.printf("[PicoWiFiManager] ");
-        Serial.printf(format, args);
-        Serial.println();
-        va_end(args);
+void PicoWiFiManager::finishConnectCommand(bool connected) {
+    if (_connectCommand == 0) return;
+    
+    postEvent(EventType::CONNECT_DONE, connected ? 1 : 0, _connectCommand);
+    _connectCommand = 0;
+}
+
+void PicoWiFiManager::dispatchEvents() {
+    Event event;
+    while (_events.pop(event)) {
+        dispatchEvent(event);
+    }
+}
+
+void PicoWiFiManager::publishSnapshot(bool refreshRadio) {
+    // Only core 1 writes; radio queries are rate limited by the caller
+    StatusSnapshot snapshot;
+    if (!refreshRadio) {
+        _snapshot.read(snapshot);
+    }
+    
+    snapshot.status = _status;
+    snapshot.connectState = _connectState;
+    snapshot.configMode = _configMode;
+    snapshot.reconnect = _reconnect.getStats();
+    snapshot.link = _link.getQuality();
+    
+    if (refreshRadio) {
+        snapshot.wifiConnected = PicoWiFiHAL::wifi().status() == WL_CONNECTED;
+        snapshot.localIP = (uint32_t)PicoWiFiHAL::wifi().localIP();
+        snapshot.rssi = snapshot.wifiConnected ? PicoWiFiHAL::wifi().RSSI() : 0;
+        strncpy(snapshot.ssid, PicoWiFiHAL::wifi().SSID(), sizeof(snapshot.ssid) - 1);
+        snapshot.ssid[sizeof(snapshot.ssid) - 1] = '\0';
+    } else {
+        snapshot.wifiConnected = _status == ConnectionStatus::CONNECTED;
+        if (snapshot.wifiConnected) {
+            snapshot.localIP = (uint32_t)PicoWiFiHAL::wifi().localIP();
+        }
+    }
+    
+    snapshot.updatedAt = millis();
+    _snapshot.write(snapshot);
+}
+
+void PicoWiFiManager::publishTiming() {
+    // Copied out once per connect, so core 0 never sees a half-updated record
+    if (_core1Running) {
+        _timingSnapshot.write(_timing);
+    }
+}
+
+bool PicoWiFiManager::readSnapshot(StatusSnapshot& snapshot) const {
+    // Only core 0 readers in dual-core mode go through the snapshot
+    if (!shouldForwardToCore1()) {
+        return false;
+    }
+    return _snapshot.read(snapshot);
+}
+
+void PicoWiFiManager::processCommands() {
+    Command command;
+    while (queue_try_remove(&_commandQueue, &command)) {
+        switch (command.type) {
+            case CommandType::CONNECT:
+            case CommandType::CONNECT_SAVED: {
+                // The new request replaces any attempt in flight
+                finishConnectCommand(false);
+                bool started;
+                if (command.type == CommandType::CONNECT_SAVED) {
+                    started = connectAsync();
+                } else if (command.pinned) {
+                    started = connectAsync(command.ssid, command.password, command.bssid, command.channel);
+                } else {
+                    started = connectAsync(command.ssid, command.password);
+                }
+                _connectCommand = command.id;
+                if (!started) {
+                    finishConnectCommand(false);
+                }
+                break;
+            }
+            case CommandType::START_PORTAL:
+                startConfigPortal(command.ssid, command.password);
+                break;
+            case CommandType::STOP_PORTAL:
+                stopConfigPortal();
+                break;
+            case CommandType::DISCONNECT:
+                disconnect();
+                break;
+            case CommandType::RESET:
+                reset();
+                break;
+            case CommandType::RADIO_OFF:
+                powerDownRadio();
+                break;
+            case CommandType::FIRST_PACKET:
+                // Timed when the sketch saw it, not when core 1 got here
+                if (_timing.firstPacket(command.postedAt)) {
+                    publishTiming();
+                }
+                break;
+        }
     }
 }
 
 void PicoWiFiManager::printDiagnostics() const {
+#if PICOWIFI_ENABLE_DIAGNOSTICS
     Serial.println("=== PicoWiFiManager Diagnostics ===");
     Serial.printf("Status: %s\n", getStatusString().c_str());
     Serial.printf("Config Mode: %s\n", _configMode ? "Yes" : "No");
     Serial.printf("Uptime: %lu ms\n", getUptime());
-    Serial.printf("Free Heap: %zu bytes\n", getFreeHeap());
+    Serial.printf("Free Heap: %zu bytes (min %zu, peak used %zu)\n",
+                  getFreeHeap(), getMinFreeHeap(), getPeakHeapUsed());
+    for (uint8_t i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++) {
+        MemorySubsystem subsystem = (MemorySubsystem)i;
+        const HeapUsage& usage = MemoryMonitor::getUsage(subsystem);
+        if (usage.calls == 0) continue;
+        Serial.printf("  %-10s peak %6lu  retained %6ld  last %6ld bytes (n=%lu)\n",
+                      MemoryMonitor::getSubsystemName(subsystem), (unsigned long)usage.peak,
+                      (long)usage.retained, (long)usage.lastChange, (unsigned long)usage.calls);
+    }
+    if (_core1StackPainted) {
+        Serial.printf("Core 1 stack: %zu of %zu bytes used\n", getCore1StackUsed(), getCore1StackSize());
+    }
     
     if (isConnected()) {
         Serial.printf("SSID: %s\n", getSSID().c_str());
@@ -480,9 +1694,49 @@ void PicoWiFiManager::printDiagnostics() const {
         Serial.printf("MAC: %s\n", getMACAddress().c_str());
     }
     
+    ConnectTiming timing;
+    getConnectTiming(timing);
+    const ConnectTimeline& last = timing.getLast();
+    Serial.printf("Connects: %lu ok, %lu failed\n",
+                  (unsigned long)timing.getConnects(), (unsigned long)timing.getFailures());
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        ConnectPhase phase = (ConnectPhase)i;
+        const LatencyHistogram& histogram = timing.getHistogram(phase);
+        if (histogram.getCount() == 0) continue;
+        Serial.printf("  %-12s last %5lu  min %5lu  avg %5lu  p95 %5lu ms (n=%lu)\n",
+                      ConnectTiming::getPhaseName(phase), (unsigned long)last.phase[i],
+                      (unsigned long)histogram.getMin(), (unsigned long)histogram.getAverage(),
+                      (unsigned long)histogram.getPercentile(95), (unsigned long)histogram.getCount());
+    }
+    
+    Serial.printf("Power save: %s\n", PowerController::getModeName(_power.getPolicy().mode));
+    for (uint8_t i = 0; i < POWER_SAVE_MODE_COUNT; i++) {
+        const LatencyHistogram& histogram = timing.getReadyHistogram((PowerSaveMode)i);
+        if (histogram.getCount() == 0) continue;
+        Serial.printf("  ready (%s): avg %lu  p95 %lu ms (n=%lu)\n",
+                      PowerController::getModeName((PowerSaveMode)i), (unsigned long)histogram.getAverage(),
+                      (unsigned long)histogram.getPercentile(95), (unsigned long)histogram.getCount());
+    }
+    for (uint8_t i = 0; i < POWER_SAVE_MODE_COUNT; i++) {
+        const LatencyHistogram& histogram = timing.getReadyHistogram((PowerSaveMode)i, true);
+        if (histogram.getCount() == 0) continue;
+        Serial.printf("  ready (%s, radio off): avg %lu  p95 %lu ms (n=%lu)\n",
+                      PowerController::getModeName((PowerSaveMode)i), (unsigned long)histogram.getAverage(),
+                      (unsigned long)histogram.getPercentile(95), (unsigned long)histogram.getCount());
+    }
+    const DutyCycleStats& cycles = _power.getDutyCycleStats();
+    if (cycles.cycles > 0) {
+        Serial.printf("Duty cycles: %lu (%lu failed), last awake %lu ms, awake %lu%%\n",
+                      (unsigned long)cycles.cycles, (unsigned long)cycles.failures,
+                      (unsigned long)cycles.lastAwakeTime,
+                      (unsigned long)(cycles.totalAwakeTime * 100 /
+                                      (cycles.totalAwakeTime + cycles.totalSleepTime + 1)));
+    }
+    
     if (_storage) {
         _storage->printDiagnostics();
     }
     
     Serial.println("=====================================");
+#endif
 }
\ No newline at end of file
@@ -13,19 +13,32 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <WebServer.h>
-#include "ConfigPortal.h"
+#include <pico/util/queue.h>
+#include "PicoWiFiFeatures.h"
+#include "PicoWiFiLog.h"
+#include "PicoWiFiHAL.h"
+#include "ComponentSlot.h"
 #include "StorageManager.h"
+#include "ReconnectScheduler.h"
+#include "ConnectTiming.h"
+#include "LinkMonitor.h"
+#include "PowerPolicy.h"
+#include "ResetButton.h"
+#include "StatusLED.h"
+#include "InterCore.h"
+#include "MemoryMonitor.h"
+#if PICOWIFI_ENABLE_PORTAL
+#include "ConfigPortal.h"
+#endif
+#if PICOWIFI_ENABLE_SCANNER
 #include "NetworkScanner.h"
-
-// Status LED behavior
-enum class LEDMode {
-    OFF,
-    ON,
-    FAST_BLINK,    // Config mode
-    SLOW_BLINK,    // Connecting
-    PULSE          // Error
-};
+#endif
+#if PICOWIFI_ENABLE_STATUS_SERVER
+#include "StatusServer.h"
+#endif
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+#include "SerialProvisioner.h"
+#endif
 
 // Connection status
 enum class ConnectionStatus {
@@ -36,17 +49,55 @@ enum class ConnectionStatus {
     ERROR
 };
 
+// Steps of the non-blocking connection state machine
+enum class ConnectState {
+    IDLE,
+    SCANNING,      // Looking for saved networks in range before choosing one
+    MODE_SET,      // Previous link dropped, radio settling before STA mode
+    ASSOCIATING,   // Join issued, waiting for the AP
+    DHCP,          // Associated, waiting for an IP address
+    CONNECTED,
+    FAILED
+};
+
+// Connection state published by the WiFi core for lock-free readers
+struct StatusSnapshot {
+    ConnectionStatus status = ConnectionStatus::DISCONNECTED;
+    ConnectState connectState = ConnectState::IDLE;
+    bool configMode = false;
+    bool wifiConnected = false;
+    uint32_t localIP = 0;
+    int32_t rssi = 0;
+    char ssid[33] = {0};
+    ReconnectStats reconnect;
+    LinkQuality link;
+    uint32_t updatedAt = 0;
+};
+
 // Configuration structure
 struct PicoWiFiConfig {
     char deviceName[32] = "Pico2W";
     char apPassword[64] = "picowifi123";
     uint16_t configPortalTimeout = 300; // 5 minutes
+    bool apStaProvisioning = true;      // Keep the portal up while its credentials are tried
     uint16_t connectTimeout = 30;       // 30 seconds
-    uint8_t maxReconnectAttempts = 3;
+    uint8_t maxReconnectAttempts = 3;   // Attempts per outage before the portal starts
     bool autoReconnect = true;
+    ReconnectPolicy reconnectPolicy;    // Backoff between reconnect attempts
+    RoamingConfig roaming;              // Move to a stronger AP of the same SSID
+    PowerPolicy powerPolicy;            // Radio power save while connected
     bool enableSerial = true;
+    bool pinStrongestBSSID = true;      // Join the strongest AP of the SSID from the last scan
+    bool fastConnect = true;            // Try the cached BSSID/channel before a full connect
+    bool fastConnectReuseLease = false; // Also reuse the cached DHCP lease (skips DHCP)
+    uint16_t fastConnectTimeout = 5;    // Seconds before falling back to a full connect
+    StorageBackend storageBackend = StorageBackend::AUTO;  // Power-fail atomic banks where possible
+    bool statusServer = false;          // Serve /metrics and /status.json while connected
+    uint16_t statusServerPort = 80;
+    bool serialProvisioning = false;    // Accept credentials from extras/provision.py
+    Stream* provisioningStream = nullptr; // Port for it; nullptr means Serial
     uint8_t ledPin = LED_BUILTIN;
-    uint8_t resetPin = 2;
+    uint8_t resetPin = 2;               // Active low; 255 disables the button
     
     // Advanced settings
     bool useStaticIP = false;
@@ -58,8 +109,10 @@ struct PicoWiFiConfig {
 };
 
 // Callback function types
-typedef std::function<void(void)> PicoWiFiCallback;
-typedef std::function<void(ConnectionStatus)> StatusCallback;
+typedef CallbackFunction<void(void)> PicoWiFiCallback;
+typedef CallbackFunction<void(ConnectionStatus)> StatusCallback;
+typedef CallbackFunction<void(ConnectState)> ConnectStateCallback;
+typedef CallbackFunction<bool(void)> DutyCycleTask;
 
 class PicoWiFiManager {
 public:
@@ -76,6 +129,16 @@ public:
     void reset();
     void disconnect();
     
+    // Non-blocking connection (driven by loop() or pollConnect())
+    bool connectAsync();
+    bool connectAsync(const char* ssid, const char* password = nullptr);
+    bool connectAsync(const char* ssid, const char* password, const uint8_t* bssid, uint8_t channel = 0);
+    ConnectState pollConnect();
+    ConnectState getConnectState() const;
+    bool isConnectPending() const;
+    uint32_t getLastConnectDuration() const;  // ms from request to IP, fallback included
+    bool wasFastConnect() const;              // Last connect used the fast-connect cache
+    
     // Configuration
     void setConfig(const PicoWiFiConfig& config);
     PicoWiFiConfig getConfig() const;
@@ -90,7 +153,9 @@ public:
     void stopConfigPortal();
     
     // Status and information
+    // In dual-core mode these read a snapshot published by core 1
     ConnectionStatus getStatus() const;
+    void getStatusSnapshot(StatusSnapshot& snapshot) const;
     String getStatusString() const;
     bool isConnected() const;
     bool isConfigMode() const;
@@ -99,47 +164,143 @@ public:
     String getSSID() const;
     IPAddress getLocalIP() const;
     int32_t getRSSI() const;
+    LinkQuality getLinkQuality() const;  // Smoothed RSSI and roaming counters
     String getMACAddress() const;
     
-    // Callbacks
+    // Callbacks (in dual-core mode they run on core 0 from loop())
     void onConfigModeStart(PicoWiFiCallback callback);
     void onConfigModeEnd(PicoWiFiCallback callback);
     void onConnect(PicoWiFiCallback callback);
     void onDisconnect(PicoWiFiCallback callback);
     void onStatusChange(StatusCallback callback);
+    void onConnectStateChange(ConnectStateCallback callback);
     
     // Dual-core support
+    // When enabled the library launches core 1 and services WiFi, the portal,
+    // DNS and reconnection there; loop() on core 0 then returns immediately.
+    // Do not combine with a sketch-defined setup1()/loop1().
     void enableDualCore(bool enable = true);
     bool isDualCoreEnabled() const;
+    bool isDualCoreRunning() const;
     
     // Debug and diagnostics
     void enableDebug(bool enable = true);
     void printDiagnostics() const;
     uint32_t getUptime() const;
     size_t getFreeHeap() const;
+    size_t getMinFreeHeap() const;       // Lowest sampled since boot
+    size_t getPeakHeapUsed() const;
+    size_t getCore1StackUsed() const;    // Deepest core 1 stack use; 0 before startCore1()
+    static size_t getCore1StackSize() { return CORE1_STACK_SIZE; }
+    ReconnectStats getReconnectStats() const;
+    
+    // Connection timing: per-phase records of every connect and reconnect
+    void getConnectTiming(ConnectTiming& timing) const;
+    void notifyFirstPacket();  // Call when the application's first exchange succeeds
+    
+    // Power management
+    void setPowerPolicy(const PowerPolicy& policy);
+    // Connect (fast path), run the task, disconnect and sleep out the rest of
+    // the period; returns false if there was no connection or the task failed
+    bool runDutyCycle(uint32_t period, DutyCycleTask task);
+    DutyCycleStats getDutyCycleStats() const;
 
 private:
     PicoWiFiConfig _config;
     ConnectionStatus _status;
     
-    // Component managers
-    ConfigPortal* _portal;
-    StorageManager* _storage;
-    NetworkScanner* _scanner;
-    WebServer* _server;
+    // Component managers (inside the manager with PICOWIFI_STATIC_ALLOCATION)
+    ComponentSlot<StorageManager> _storage;
+#if PICOWIFI_ENABLE_PORTAL
+    ComponentSlot<ConfigPortal> _portal;
+#endif
+#if PICOWIFI_ENABLE_SCANNER
+    ComponentSlot<NetworkScanner> _scanner;
+#endif
+#if PICOWIFI_ENABLE_STATUS_SERVER
+    ComponentSlot<StatusServer> _statusServer;
+#endif
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+    ComponentSlot<SerialProvisioner> _provisioner;
+#endif
     
     // Internal state
     bool _isInitialized;
     bool _configMode;
     bool _dualCoreEnabled;
-    bool _debugEnabled;
+    
+    // Dual-core state
+    volatile bool _core1Running;
+    volatile bool _core1Active;
+    bool _commandQueueReady;
+    queue_t _commandQueue;
+    
+    // Connect requests are numbered so core 0 can wait for its own one;
+    // the first three are core 0 only, _connectCommand core 1 only
+    uint32_t _nextCommandId;
+    uint32_t _connectDone;
+    bool _connectDoneOK;
+    uint32_t _connectCommand;
     
     uint32_t _startTime;
-    uint32_t _lastReconnectAttempt;
-    uint8_t _reconnectAttempts;
+    ReconnectScheduler _reconnect;
+    ConnectTiming _timing;
+    SeqLock<ConnectTiming> _timingSnapshot;
+    
+    // Async connection state
+    ConnectState _connectState;
+    uint32_t _connectStart;
+    uint32_t _connectStepStart;
+    bool _saveOnConnect;
+    bool _disconnectRequested;
+    char _connectSSID[33];
+    char _connectPassword[65];
+    uint8_t _connectBSSID[6];
+    uint8_t _connectChannel;
+    bool _connectPinned;
+    
+    // Fast-connect attempt state
+    FastConnectCache _fastCache;
+    bool _fastConnectAttempt;
+    bool _leaseApplied;
+    uint32_t _connectOrigin;
+    uint32_t _lastConnectDuration;
+    bool _lastConnectFast;
+    
+    // Portal closes this long after a provisioning success (0 = not pending)
+    uint32_t _portalCloseAt;
+    
+    // Link quality and roaming
+    LinkMonitor _link;
+    bool _roamScanPending;
+    
+    PowerController _power;
+    bool _radioPowered;     // Radio core only; false after a duty-cycle power-down
+    
+    ResetButton _button;
     
-    unsigned long _lastLEDUpdate;
-    bool _ledState;
+    StatusLED _led;
+    
+    // Events passed from core 1 to core 0 in dual-core mode
+    enum class EventType : uint8_t {
+        CONFIG_START,
+        CONFIG_END,
+        CONNECTED,
+        DISCONNECTED,
+        STATUS_CHANGE,
+        CONNECT_STATE,
+        CONNECT_DONE
+    };
+    
+    struct Event {
+        EventType type;
+        uint8_t value;
+        uint32_t command;        // CONNECT_DONE: id of the finished request
+    };
+    
+    SpscQueue<Event, 32> _events;
+    SeqLock<StatusSnapshot> _snapshot;
+    uint32_t _lastSnapshotRefresh;
     
     // Callbacks
     PicoWiFiCallback _onConfigStart;
@@ -147,24 +308,89 @@ private:
     PicoWiFiCallback _onConnect;
     PicoWiFiCallback _onDisconnect;
     StatusCallback _onStatusChange;
+    ConnectStateCallback _onConnectStateChange;
+    
+    // Requests posted from core 0 to core 1
+    enum class CommandType : uint8_t {
+        CONNECT,
+        CONNECT_SAVED,
+        START_PORTAL,
+        STOP_PORTAL,
+        DISCONNECT,
+        RESET,
+        FIRST_PACKET,
+        RADIO_OFF
+    };
+    
+    struct Command {
+        CommandType type;
+        char ssid[33];
+        char password[65];
+        uint8_t bssid[6];
+        uint8_t channel;
+        bool pinned;
+        uint32_t postedAt;
+        uint32_t id;
+    };
     
     // Core methods
+    void service();
+    bool connectWiFi();
     bool connectWiFi(const char* ssid, const char* password);
+    bool waitForConnect(uint32_t command);
+    bool connectSavedNetwork();
+    bool selectSavedNetwork(WiFiCredentials& credentials);
     void handleReconnection();
+    void startStatusServer();
+    void startSerialProvisioning();
+    void applyPowerPolicy();
+    void wakeRadio();
+    void powerDownRadio();
+    void closePortalWhenDone();
+    bool keepPortalDuringConnect() const;
+#if PICOWIFI_ENABLE_SCANNER
+    void updateLinkMonitor();
+    void roamIfBetter();
+    bool startPreconnectScan();
+    bool findBestBSSID(const char* ssid, ScannedNetwork& network);
+#endif
     void updateLED();
     void setStatus(ConnectionStatus status);
+    void setConnectState(ConnectState state);
+    void fallbackToFullConnect();
+    void recordSuccessfulConnect();
+    const char* getConnectStateString(ConnectState state) const;
     void checkResetButton();
     
     // Dual-core task
     static void core1Task();
     void runCore1();
-    
-    // Debug helpers
-    void debugPrint(const String& message) const;
-    void debugPrintf(const char* format, ...) const;
+    bool startCore1();
+    void stopCore1();
+    bool shouldForwardToCore1() const;
+    bool postCommand(CommandType type, const char* ssid = nullptr, const char* password = nullptr,
+                     const uint8_t* bssid = nullptr, uint8_t channel = 0);
+    void processCommands();
+    void postEvent(EventType type, uint8_t value = 0, uint32_t command = 0);
+    void finishConnectCommand(bool connected);
+    void dispatchEvent(const Event& event);
+    void dispatchEvents();
+    void publishSnapshot(bool refreshRadio);
+    void publishTiming();
+    bool readSnapshot(StatusSnapshot& snapshot) const;
     
     // Static instance for dual-core
     static PicoWiFiManager* _instance;
+    
+    static const uint32_t CONNECT_SETTLE_MS = 100;
+    static const uint32_t PROVISION_CLOSE_MS = 30000;  // Longest the portal outlives a success
+    static const uint32_t PROVISION_LINGER_MS = 3000;  // ...or this long after /result showed it
+    static const uint8_t COMMAND_QUEUE_DEPTH = 4;
+    static const uint32_t SNAPSHOT_REFRESH_MS = 1000;
+    static const size_t LOG_DRAIN_PER_LOOP = 4;        // Log lines printed per loop() pass
+    static const size_t CORE1_STACK_SIZE = 8192;
+    static uint32_t _core1Stack[CORE1_STACK_SIZE / sizeof(uint32_t)];
+    static bool _core1StackPainted;
 };
 
 #endif // PICO_WIFI_MANAGER_H
\ No newline at end of file
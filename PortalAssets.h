@@ -0,0 +1,145 @@
+/**
+ * PortalAssets - Precompressed config portal web assets
+ *
+ * GENERATED by extras/embed_assets.py from extras/portal/ - do not edit.
+ */
+
+#ifndef PORTAL_ASSETS_H
+#define PORTAL_ASSETS_H
+
+#include <Arduino.h>
+
+// Cache-busting token referenced by index.html as ?v=...
+#define PORTAL_ASSET_VERSION "290d1209"
+
+// index.html: 969 bytes, 571 bytes gzipped
+static const char PORTAL_INDEX_HTML_TYPE[] = "text/html; charset=utf-8";
+static const uint8_t PORTAL_INDEX_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x53, 0x4d, 0x6f, 0xd3, 0x40,
+    0x10, 0xbd, 0xf3, 0x2b, 0x96, 0x3d, 0xb5, 0x12, 0x89, 0x9b, 0xf6, 0x42, 0x91, 0x6d, 0x0e, 0x94,
+    0x4a, 0x9c, 0xa8, 0x94, 0x22, 0xc4, 0x71, 0xb3, 0x9e, 0xc8, 0x4b, 0xed, 0x5d, 0xb3, 0x3b, 0x4e,
+    0xc8, 0xad, 0x2d, 0x12, 0x91, 0x90, 0xda, 0x22, 0x21, 0x21, 0x21, 0x71, 0x02, 0x51, 0xe5, 0x52,
+    0xca, 0x87, 0x04, 0x3d, 0xc0, 0xbf, 0x21, 0x5f, 0xff, 0x82, 0xdd, 0xac, 0x43, 0x1a, 0x2a, 0xc1,
+    0xc1, 0x1e, 0xef, 0x6a, 0xde, 0x9b, 0x99, 0x37, 0xcf, 0xe1, 0xf5, 0xad, 0xfb, 0x77, 0x76, 0x1f,
+    0xed, 0xdc, 0x25, 0x29, 0xe6, 0x59, 0x7c, 0x2d, 0x9c, 0x07, 0x60, 0x89, 0x0d, 0x39, 0x20, 0x23,
+    0x3c, 0x65, 0xda, 0x00, 0x46, 0xf4, 0xc1, 0xee, 0x76, 0xed, 0x26, 0xb5, 0xd7, 0x28, 0x30, 0x83,
+    0x78, 0x47, 0x70, 0x45, 0x1e, 0x8a, 0x6d, 0x41, 0x9a, 0x80, 0x65, 0x11, 0x06, 0xfe, 0xba, 0x42,
+    0x49, 0x96, 0x43, 0x44, 0x3b, 0x02, 0xba, 0x85, 0xd2, 0x48, 0x09, 0x57, 0x12, 0x41, 0x5a, 0x96,
+    0xae, 0x48, 0x30, 0x8d, 0x12, 0xe8, 0x08, 0x0e, 0xb5, 0xd9, 0xe1, 0x86, 0x90, 0x02, 0x05, 0xcb,
+    0x6a, 0x86, 0xb3, 0x0c, 0xa2, 0x86, 0x2b, 0x91, 0x09, 0xb9, 0x47, 0x34, 0x64, 0x11, 0x35, 0xd8,
+    0xcb, 0xc0, 0xa4, 0x00, 0x96, 0x24, 0xd5, 0xd0, 0x8e, 0x68, 0xe0, 0x18, 0x59, 0x56, 0xe7, 0xc6,
+    0xdc, 0xee, 0x44, 0xeb, 0x9b, 0x6b, 0x49, 0x63, 0x7d, 0x6d, 0xd3, 0xa1, 0x82, 0xaa, 0xef, 0x96,
+    0x4a, 0x7a, 0x36, 0x24, 0xa2, 0x43, 0x78, 0xc6, 0x8c, 0x89, 0xa8, 0x2b, 0xcf, 0x84, 0x04, 0xed,
+    0xd2, 0xd2, 0x06, 0x11, 0x49, 0x44, 0x67, 0xfd, 0xd2, 0x78, 0x36, 0xc2, 0x95, 0x61, 0xd2, 0x86,
+    0x4b, 0xdc, 0x88, 0xa7, 0x07, 0x17, 0xa3, 0x57, 0xfd, 0xf1, 0xb7, 0x2f, 0x93, 0xef, 0xe7, 0xb7,
+    0xec, 0xf5, 0x46, 0xc5, 0xeb, 0x08, 0x24, 0x60, 0x57, 0xe9, 0x3d, 0x43, 0xe3, 0xb0, 0x98, 0x17,
+    0x82, 0xbc, 0xc0, 0x1e, 0x8d, 0x47, 0xc7, 0xcf, 0x46, 0x27, 0x27, 0xbf, 0x2e, 0xce, 0xea, 0xf5,
+    0x7a, 0x18, 0x14, 0x71, 0x18, 0x58, 0x90, 0x63, 0xd4, 0xf6, 0xd5, 0x56, 0x3a, 0x27, 0x8c, 0xa3,
+    0x50, 0xd2, 0x4e, 0x63, 0x5b, 0x93, 0xc0, 0xed, 0x74, 0x56, 0xb7, 0x54, 0x59, 0xda, 0x42, 0x19,
+    0x74, 0x6d, 0x5a, 0x94, 0x90, 0x45, 0x89, 0x04, 0x7b, 0x85, 0xd5, 0x12, 0xe1, 0xa9, 0x4d, 0x72,
+    0x75, 0x8d, 0x11, 0x09, 0xad, 0x14, 0xf6, 0xdf, 0x45, 0xc6, 0x38, 0xa4, 0x2a, 0x4b, 0x40, 0x47,
+    0xd4, 0x37, 0x3b, 0x7c, 0x79, 0x34, 0x1e, 0x7c, 0x26, 0x2b, 0xcd, 0xe6, 0xbd, 0xad, 0x55, 0x6a,
+    0xb5, 0x7c, 0x52, 0x0a, 0x0d, 0x49, 0xec, 0xba, 0xb9, 0xc2, 0x5d, 0xd8, 0xde, 0xed, 0x28, 0x89,
+    0xe7, 0x5f, 0x9c, 0x7c, 0x8d, 0xc5, 0x79, 0xa9, 0xce, 0xf0, 0xfc, 0xf9, 0xf8, 0xdd, 0x0f, 0xb2,
+    0x32, 0x3c, 0x3d, 0x9c, 0xbe, 0xdd, 0x9f, 0x9c, 0x1e, 0xac, 0xd2, 0x05, 0x7b, 0xab, 0x44, 0x54,
+    0xb2, 0xa2, 0x37, 0x65, 0x2b, 0x17, 0xce, 0x04, 0x5e, 0xa3, 0x16, 0x4a, 0x1a, 0x4f, 0xf7, 0xdf,
+    0x8f, 0x8e, 0x3f, 0xf8, 0x5e, 0xc3, 0xc0, 0xa7, 0x57, 0xf0, 0xc0, 0x09, 0xb4, 0xbc, 0x3f, 0xaf,
+    0x96, 0x71, 0xb2, 0xb0, 0xb9, 0x0d, 0xac, 0x5d, 0xe4, 0x65, 0x4e, 0x62, 0x9f, 0x9a, 0x01, 0xab,
+    0x67, 0xc2, 0xb4, 0xdd, 0xc1, 0xb4, 0x7f, 0x34, 0x7a, 0xfd, 0xc9, 0x6f, 0x22, 0x0c, 0xd8, 0x65,
+    0xa8, 0x90, 0x6d, 0xf5, 0x2f, 0xe8, 0x64, 0x70, 0x36, 0x3c, 0x7c, 0x33, 0xf9, 0xda, 0x9f, 0x0c,
+    0x5e, 0xfc, 0x05, 0xd5, 0x60, 0x00, 0xff, 0x53, 0x76, 0xfc, 0xf3, 0xa3, 0x67, 0xf0, 0xd8, 0x6a,
+    0xf7, 0x73, 0xdb, 0xf0, 0xd2, 0xa0, 0xca, 0xe9, 0x1f, 0x4f, 0x54, 0xc1, 0x70, 0x2d, 0x0a, 0x24,
+    0x46, 0xf3, 0x85, 0xc5, 0x1f, 0x2f, 0x3b, 0x3c, 0x0c, 0x7c, 0x92, 0x03, 0x55, 0x1e, 0x0f, 0xfc,
+    0x1f, 0xfb, 0x1b, 0x36, 0xca, 0xb4, 0x07, 0xc9, 0x03, 0x00, 0x00,
+};
+static const size_t PORTAL_INDEX_HTML_GZ_LEN = sizeof(PORTAL_INDEX_HTML_GZ);
+
+// portal.css: 996 bytes, 500 bytes gzipped
+static const char PORTAL_CSS_TYPE[] = "text/css";
+static const uint8_t PORTAL_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x53, 0x4d, 0x8f, 0xda, 0x30,
+    0x10, 0xbd, 0xf3, 0x2b, 0x22, 0xa1, 0x6a, 0x5b, 0x29, 0x5e, 0x39, 0x40, 0x80, 0x35, 0xea, 0xa1,
+    0x3d, 0x54, 0xea, 0xa1, 0x97, 0xae, 0x7a, 0xaa, 0xf6, 0x30, 0xb1, 0x9d, 0xc4, 0x22, 0xf1, 0x58,
+    0xb6, 0x29, 0x64, 0x23, 0xfe, 0x7b, 0x9d, 0x0f, 0x58, 0x3e, 0xb6, 0xaa, 0x7c, 0xf2, 0xf8, 0xcd,
+    0x9b, 0x79, 0xcf, 0x33, 0x19, 0x8a, 0xa6, 0xcd, 0x51, 0x7b, 0x92, 0x43, 0xad, 0xaa, 0x86, 0x11,
+    0x30, 0xa6, 0x92, 0xc4, 0x35, 0xce, 0xcb, 0x3a, 0xfe, 0x5a, 0x29, 0xbd, 0xfd, 0x01, 0xfc, 0xb9,
+    0xbf, 0x7e, 0x0b, 0xb8, 0xf8, 0xe1, 0x59, 0x16, 0x28, 0xa3, 0x5f, 0xdf, 0x1f, 0xe2, 0x9f, 0x98,
+    0xa1, 0xc7, 0xf8, 0x8b, 0x55, 0x50, 0xc5, 0x0e, 0xb4, 0x23, 0x4e, 0x5a, 0x95, 0x6f, 0x6a, 0xb0,
+    0x85, 0xd2, 0x6c, 0x46, 0xcd, 0x61, 0x93, 0x01, 0xdf, 0x16, 0x16, 0x77, 0x5a, 0xb0, 0x69, 0x9e,
+    0x76, 0xe7, 0x38, 0x79, 0xe4, 0x81, 0x08, 0x94, 0x96, 0xb6, 0xad, 0xe1, 0x40, 0xf6, 0x4a, 0xf8,
+    0x92, 0x2d, 0x68, 0x07, 0x1f, 0x53, 0x69, 0x04, 0x3b, 0x8f, 0x97, 0xc9, 0xfb, 0x52, 0x79, 0xb9,
+    0x31, 0x20, 0x84, 0xd2, 0xc5, 0x48, 0x8d, 0x56, 0x48, 0x4b, 0x2c, 0x08, 0xb5, 0x73, 0x6c, 0xdd,
+    0x47, 0x0e, 0xc4, 0x95, 0x20, 0x70, 0x1f, 0x18, 0x66, 0xe6, 0x10, 0x25, 0x01, 0x17, 0xd9, 0x22,
+    0x83, 0x8f, 0x34, 0xee, 0xcf, 0x63, 0xf2, 0xe9, 0x38, 0x29, 0x93, 0x96, 0x63, 0x85, 0x96, 0x4d,
+    0xe7, 0xf3, 0xf9, 0xc6, 0xcb, 0x83, 0x27, 0x50, 0xa9, 0x42, 0x33, 0x2e, 0xb5, 0x97, 0x76, 0x6c,
+    0x82, 0x04, 0x71, 0x1e, 0x6b, 0x36, 0x0f, 0x1c, 0x21, 0x67, 0x7e, 0xca, 0x59, 0x2e, 0x97, 0x37,
+    0x88, 0x24, 0xed, 0x11, 0x9d, 0x9a, 0xb3, 0xf0, 0x88, 0x06, 0x9d, 0xb2, 0x36, 0xbe, 0x69, 0xef,
+    0x0b, 0xbc, 0x31, 0x05, 0x90, 0x96, 0x7e, 0x8f, 0x76, 0x4b, 0x82, 0xbe, 0xba, 0xbd, 0xb2, 0x6b,
+    0x9d, 0x3f, 0xe5, 0x70, 0xb2, 0x24, 0xed, 0x38, 0xcf, 0x06, 0x24, 0xf7, 0x06, 0x2c, 0x42, 0x84,
+    0xef, 0xac, 0x0b, 0xcc, 0x06, 0x55, 0x5f, 0x67, 0x00, 0xb0, 0x24, 0xa4, 0x3a, 0xac, 0x94, 0x88,
+    0xa6, 0xf2, 0x49, 0x72, 0x99, 0xdf, 0x54, 0x65, 0x25, 0xfe, 0x09, 0x7f, 0x71, 0x59, 0xfb, 0x8c,
+    0xcb, 0xbc, 0xbe, 0x7a, 0xa0, 0x74, 0xc5, 0x33, 0x18, 0x15, 0x5c, 0x7f, 0x4a, 0xd2, 0x39, 0x3e,
+    0x5b, 0x9c, 0x1b, 0x63, 0x1a, 0xb5, 0xfc, 0x7f, 0x93, 0xc3, 0xf7, 0x27, 0x94, 0x7e, 0xd8, 0xf4,
+    0x83, 0xe8, 0xd4, 0xab, 0x64, 0xc9, 0xf2, 0x6d, 0x18, 0xd2, 0xd1, 0xcd, 0xd0, 0xca, 0x3b, 0x9d,
+    0x52, 0x9a, 0xc2, 0x7a, 0x75, 0x9c, 0x28, 0x6d, 0x76, 0xfe, 0xb7, 0x6f, 0x8c, 0xfc, 0xdc, 0x19,
+    0xfe, 0x12, 0x5f, 0x04, 0x0c, 0x38, 0x17, 0xd4, 0x8a, 0x97, 0xf6, 0xa2, 0xd8, 0x65, 0xdb, 0xd7,
+    0x26, 0xdf, 0xdb, 0xc6, 0x39, 0x7f, 0x47, 0x48, 0x3f, 0x6e, 0xea, 0xb5, 0x23, 0x19, 0x1f, 0x43,
+    0xe4, 0x46, 0x44, 0xe8, 0x1b, 0xb8, 0x57, 0xa8, 0x5d, 0xfb, 0xcf, 0x41, 0xf3, 0x68, 0xfa, 0x99,
+    0x19, 0x34, 0x86, 0x25, 0x0a, 0xfb, 0x21, 0xc0, 0x36, 0x57, 0x3a, 0x97, 0x7c, 0x95, 0xae, 0xc4,
+    0x29, 0xc5, 0xaa, 0xa2, 0xf4, 0xc3, 0x14, 0x0c, 0x92, 0xfa, 0x7d, 0x11, 0xca, 0x99, 0x0a, 0x1a,
+    0xa6, 0x74, 0xd8, 0x5b, 0x49, 0xb2, 0x0a, 0xf9, 0xf6, 0x38, 0xf9, 0x0b, 0x61, 0xe9, 0xbd, 0xad,
+    0xe4, 0x03, 0x00, 0x00,
+};
+static const size_t PORTAL_CSS_GZ_LEN = sizeof(PORTAL_CSS_GZ);
+
+// portal.js: 1482 bytes, 701 bytes gzipped
+static const char PORTAL_JS_TYPE[] = "application/javascript";
+static const uint8_t PORTAL_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x75, 0x54, 0x4d, 0x6f, 0xd3, 0x40,
+    0x10, 0xbd, 0xf7, 0x57, 0x4c, 0x7b, 0x59, 0x5b, 0x6d, 0x9d, 0x0a, 0x09, 0x84, 0x48, 0x13, 0xa4,
+    0x56, 0x85, 0x02, 0x6d, 0x91, 0x20, 0x12, 0x48, 0xa8, 0x07, 0x63, 0x4f, 0xea, 0xa5, 0xf6, 0xda,
+    0xec, 0xae, 0x93, 0x56, 0x34, 0x57, 0x04, 0xe4, 0xc0, 0x05, 0xc1, 0x85, 0x03, 0x67, 0x2e, 0x45,
+    0x1c, 0xe0, 0xd6, 0x1f, 0x83, 0xd4, 0x02, 0xff, 0x82, 0xd9, 0x75, 0xfc, 0xd5, 0x06, 0xcb, 0xb2,
+    0xb2, 0x33, 0x6f, 0xde, 0x7c, 0xbd, 0x8d, 0x33, 0xcc, 0x45, 0xa0, 0x79, 0x2a, 0xc0, 0x71, 0xe1,
+    0xd5, 0x02, 0x40, 0x75, 0xc6, 0xd8, 0xe1, 0x21, 0xd9, 0x40, 0xa2, 0xce, 0xa5, 0x80, 0x30, 0x0d,
+    0xf2, 0x04, 0x85, 0xf6, 0x0e, 0x50, 0x6f, 0xc5, 0x68, 0x7e, 0x6e, 0x1c, 0xdf, 0x0b, 0x0d, 0xa8,
+    0x0b, 0x93, 0x85, 0x66, 0xe8, 0x73, 0x5f, 0x2a, 0x47, 0x2a, 0xc5, 0x0b, 0x4a, 0x00, 0x3e, 0x04,
+    0x7b, 0x86, 0x3e, 0xac, 0x5e, 0x5f, 0x73, 0x4b, 0x4a, 0xf6, 0xeb, 0xd3, 0xfb, 0xea, 0x65, 0xdd,
+    0x2b, 0xd0, 0x1b, 0xd7, 0xe7, 0x42, 0xa7, 0x73, 0xa0, 0x37, 0xe7, 0xb0, 0x4e, 0x6b, 0x68, 0xcb,
+    0x35, 0x6d, 0xb8, 0xda, 0x85, 0x4b, 0x14, 0x21, 0x4a, 0x47, 0x69, 0x5f, 0x63, 0x59, 0x7b, 0xd5,
+    0xb7, 0xe6, 0x3a, 0x46, 0xe8, 0x81, 0xf5, 0x16, 0xa7, 0x82, 0x9c, 0x26, 0xc5, 0xec, 0x91, 0xb9,
+    0x9e, 0xc6, 0x23, 0xbd, 0x99, 0x0a, 0x4d, 0x01, 0x04, 0x65, 0x4f, 0xf8, 0x1d, 0x0e, 0x0c, 0x96,
+    0xdb, 0x41, 0x36, 0x6a, 0xe4, 0x4b, 0x88, 0xb9, 0x32, 0x30, 0x43, 0x20, 0x50, 0x8f, 0x53, 0x79,
+    0xa8, 0x98, 0x5b, 0x90, 0x1a, 0x97, 0xc7, 0x85, 0x40, 0xb9, 0x3d, 0xd8, 0xdd, 0x31, 0x5c, 0x8d,
+    0xae, 0x17, 0x0b, 0xba, 0x32, 0xc6, 0x8b, 0x51, 0x1c, 0xe8, 0xa8, 0xac, 0x78, 0x5e, 0xf0, 0x7a,
+    0x06, 0x41, 0xec, 0x2b, 0xd5, 0x5b, 0xc2, 0x24, 0xd3, 0xc7, 0x4b, 0xfd, 0x8b, 0xcf, 0x5f, 0x2f,
+    0xde, 0x9e, 0x9d, 0xbf, 0xf9, 0xf6, 0xfb, 0xc7, 0xf7, 0x3f, 0x3f, 0x4f, 0xd7, 0x3b, 0x59, 0x7f,
+    0x96, 0x60, 0x62, 0xbf, 0x97, 0x32, 0x0c, 0x53, 0xb9, 0xe5, 0x07, 0x91, 0x53, 0xcb, 0x85, 0x5c,
+    0x75, 0x42, 0xd3, 0x0c, 0xd7, 0x98, 0x50, 0xaa, 0x6a, 0x5e, 0x81, 0x44, 0xa2, 0x98, 0x49, 0xc5,
+    0x61, 0x21, 0x1f, 0x95, 0xbd, 0x81, 0xc5, 0x7a, 0xb6, 0xa0, 0x3d, 0x3f, 0x31, 0x43, 0x2d, 0xfb,
+    0x5f, 0x35, 0x1e, 0xd6, 0x82, 0xb5, 0x47, 0x6a, 0xb5, 0x45, 0x60, 0xaf, 0xd0, 0xd7, 0x32, 0x4d,
+    0xd7, 0xcc, 0xd7, 0x58, 0xc8, 0x10, 0x5a, 0x83, 0x53, 0x5a, 0xac, 0x3a, 0x8c, 0x25, 0xdc, 0x48,
+    0x5c, 0x32, 0xce, 0x68, 0xc1, 0x56, 0xef, 0xa1, 0x08, 0xe0, 0x36, 0x39, 0x9f, 0x9d, 0xbf, 0xfb,
+    0x72, 0x7e, 0xfa, 0x7a, 0x9f, 0xc1, 0x2d, 0x73, 0xfa, 0xfb, 0x71, 0x7a, 0xf1, 0xe1, 0x6c, 0xff,
+    0x52, 0xb1, 0xa9, 0x08, 0x62, 0x1e, 0x1c, 0x52, 0x05, 0x97, 0x6f, 0x4c, 0xf1, 0x98, 0x1d, 0x9a,
+    0x02, 0x48, 0x03, 0x23, 0x3f, 0xce, 0x4d, 0x4f, 0x65, 0x4d, 0xdd, 0x16, 0x28, 0xa3, 0xa6, 0xa9,
+    0x53, 0x03, 0x1c, 0xd2, 0xa8, 0x94, 0x53, 0xe5, 0x99, 0x74, 0x9b, 0xeb, 0xf3, 0xb3, 0x8c, 0xd4,
+    0xb8, 0x19, 0xf1, 0x98, 0xee, 0x18, 0x55, 0x30, 0x83, 0x4d, 0xdc, 0x99, 0x7e, 0x8c, 0x0e, 0x8a,
+    0x25, 0x11, 0x89, 0x4e, 0x93, 0xba, 0x18, 0x93, 0xa5, 0xb0, 0x51, 0x8e, 0xb6, 0x0a, 0x22, 0xd9,
+    0xaf, 0xd5, 0x58, 0x60, 0xea, 0xa5, 0xb7, 0xef, 0x42, 0x9c, 0xfa, 0x61, 0xd5, 0xa1, 0xd9, 0xef,
+    0x51, 0x24, 0x6d, 0x53, 0x63, 0x78, 0xba, 0xbb, 0xb3, 0xad, 0x75, 0xf6, 0x08, 0x5f, 0xe6, 0xa8,
+    0x74, 0xd9, 0x00, 0xf9, 0xbd, 0x94, 0x6a, 0x76, 0xd8, 0xdd, 0xad, 0x01, 0x5b, 0x01, 0xd6, 0x29,
+    0xd2, 0xbc, 0x50, 0xa9, 0x60, 0x4d, 0x8c, 0x30, 0xd4, 0xff, 0x19, 0xa4, 0xe9, 0xca, 0x80, 0x4c,
+    0x68, 0xae, 0x60, 0xb1, 0xd7, 0x83, 0x6b, 0x6b, 0xd5, 0xdd, 0xee, 0x36, 0xe4, 0x66, 0xc9, 0x89,
+    0xe5, 0xfe, 0xe3, 0x87, 0x7b, 0x5e, 0x46, 0xaa, 0x40, 0x1b, 0x28, 0x51, 0x65, 0xa9, 0x50, 0x38,
+    0x20, 0xd5, 0x54, 0x93, 0xed, 0x74, 0xe0, 0x01, 0x62, 0x06, 0x2a, 0x4a, 0xc7, 0x5c, 0x1c, 0x40,
+    0x40, 0x52, 0xc6, 0x90, 0x48, 0x55, 0x1e, 0x6b, 0x05, 0x63, 0x1a, 0x32, 0x82, 0x8e, 0x10, 0x42,
+    0x1c, 0xf1, 0x00, 0xc9, 0x31, 0x24, 0x5f, 0x84, 0x8a, 0x76, 0xaf, 0x40, 0x05, 0xbe, 0x68, 0x94,
+    0x37, 0xf7, 0xee, 0xc1, 0xc9, 0x09, 0xcc, 0x6e, 0xa5, 0x81, 0x0b, 0xca, 0xe2, 0xb6, 0xff, 0x4e,
+    0xba, 0x57, 0x28, 0x6a, 0xa0, 0x42, 0x3d, 0xe0, 0x09, 0xa6, 0xb9, 0x76, 0xcc, 0x6c, 0x56, 0x4c,
+    0xcf, 0x6b, 0xe5, 0xc2, 0xeb, 0xc9, 0x29, 0xe2, 0x2b, 0xa6, 0x6d, 0x57, 0x55, 0x6c, 0xa8, 0xbb,
+    0x30, 0x71, 0xcd, 0xf7, 0x1f, 0x64, 0x02, 0x36, 0xc8, 0xca, 0x05, 0x00, 0x00,
+};
+static const size_t PORTAL_JS_GZ_LEN = sizeof(PORTAL_JS_GZ);
+
+#endif // PORTAL_ASSETS_H
@@ -0,0 +1,45 @@
+/**
+ * PowerPolicy - Implementation
+ */
+
+#include "PowerPolicy.h"
+#include <pico/cyw43_arch.h>
+
+bool PowerController::apply() {
+    return cyw43_wifi_pm(&cyw43_state, getPowerManagementValue()) == 0;
+}
+
+void PowerController::recordCycle(bool success, uint32_t awakeMs, uint32_t sleepMs) {
+    _stats.cycles++;
+    if (!success) {
+        _stats.failures++;
+    }
+    _stats.lastAwakeTime = awakeMs;
+    _stats.totalAwakeTime += awakeMs;
+    _stats.totalSleepTime += sleepMs;
+}
+
+uint32_t PowerController::getPowerManagementValue() const {
+    uint32_t sleepReturn = 200;
+    uint8_t listenAssoc = 10;
+    switch (_policy.mode) {
+        case PowerSaveMode::NONE: return CYW43_NONE_PM;
+        case PowerSaveMode::PERFORMANCE: sleepReturn = 20; listenAssoc = 1; break;
+        case PowerSaveMode::AGGRESSIVE: sleepReturn = 2000; break;
+        default: break;
+    }
+
+    // The driver's CYW43_*_PM presets, with our DTIM interval in place of 1
+    uint8_t dtim = _policy.dtimInterval > 0 ? _policy.dtimInterval : 1;
+    return cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, sleepReturn, 1, dtim, listenAssoc);
+}
+
+const char* PowerController::getModeName(PowerSaveMode mode) {
+    switch (mode) {
+        case PowerSaveMode::NONE: return "none";
+        case PowerSaveMode::PERFORMANCE: return "performance";
+        case PowerSaveMode::BALANCED: return "balanced";
+        case PowerSaveMode::AGGRESSIVE: return "aggressive";
+        default: return "unknown";
+    }
+}
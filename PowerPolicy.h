@@ -0,0 +1,62 @@
+/**
+ * PowerPolicy - CYW43 power-save settings and duty-cycle accounting
+ *
+ * The radio's power-save mode trades current draw for latency: the longer
+ * it may sleep between beacons, the longer a packet addressed to it waits.
+ * The mode is applied after every connect. Duty-cycled nodes use
+ * PicoWiFiManager::runDutyCycle(), which joins through the fast-connect
+ * cache, runs a task, disconnects and sleeps out the rest of the period,
+ * optionally with the radio powered down; the next connect powers it back
+ * up and the wake cost is charged to that connect's ready time.
+ */
+
+#ifndef POWER_POLICY_H
+#define POWER_POLICY_H
+
+#include <Arduino.h>
+
+enum class PowerSaveMode : uint8_t {
+    NONE,          // Radio always awake: lowest latency, highest current
+    PERFORMANCE,   // Power save, back to sleep 20 ms after traffic
+    BALANCED,      // Power save, 200 ms (the driver's default)
+    AGGRESSIVE,    // Power save, 2 s; for mostly idle links
+    COUNT
+};
+
+static const uint8_t POWER_SAVE_MODE_COUNT = (uint8_t)PowerSaveMode::COUNT;
+
+struct PowerPolicy {
+    PowerSaveMode mode = PowerSaveMode::BALANCED;
+    uint8_t dtimInterval = 1;        // Wake for every Nth DTIM beacon while asleep (not NONE)
+    bool radioOffWhileSleeping = false;  // runDutyCycle() powers the radio down for the sleep
+};
+
+struct DutyCycleStats {
+    uint32_t cycles = 0;
+    uint32_t failures = 0;           // No connection, or the task returned false
+    uint32_t lastAwakeTime = 0;      // ms from wake to disconnect
+    uint64_t totalAwakeTime = 0;
+    uint64_t totalSleepTime = 0;
+};
+
+class PowerController {
+public:
+    void setPolicy(const PowerPolicy& policy) { _policy = policy; }
+    const PowerPolicy& getPolicy() const { return _policy; }
+
+    // Pushes the policy to the radio; false if the driver refused it
+    bool apply();
+
+    void recordCycle(bool success, uint32_t awakeMs, uint32_t sleepMs);
+    const DutyCycleStats& getDutyCycleStats() const { return _stats; }
+
+    // Value for cyw43_wifi_pm()
+    uint32_t getPowerManagementValue() const;
+    static const char* getModeName(PowerSaveMode mode);
+
+private:
+    PowerPolicy _policy;
+    DutyCycleStats _stats;
+};
+
+#endif // POWER_POLICY_H
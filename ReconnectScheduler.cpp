@@ -0,0 +1,85 @@
+/**
+ * ReconnectScheduler - Implementation
+ */
+
+#include "ReconnectScheduler.h"
+
+ReconnectScheduler::ReconnectScheduler()
+    : _active(false)
+    , _inFlight(false)
+    , _attempts(0)
+    , _outageStart(0)
+    , _nextAttempt(0)
+    , _delay(0) {
+}
+
+void ReconnectScheduler::setPolicy(const ReconnectPolicy& policy) {
+    _policy = policy;
+
+    // A wider spread would take the delay below zero
+    if (_policy.jitterPercent > 100) {
+        _policy.jitterPercent = 100;
+    }
+}
+
+void ReconnectScheduler::begin(uint32_t now) {
+    _active = true;
+    _inFlight = false;
+    _attempts = 0;
+    _outageStart = now;
+    _delay = computeDelay(0);
+    _nextAttempt = now + _delay;
+    _stats.linkLosses++;
+}
+
+void ReconnectScheduler::attemptStarted(uint32_t now) {
+    (void)now;
+    _inFlight = true;
+    if (_attempts < 255) _attempts++;
+    _stats.attempts++;
+}
+
+void ReconnectScheduler::attemptFailed(uint32_t now) {
+    // Measured from the failure so a long join timeout doesn't eat the gap
+    _inFlight = false;
+    _delay = computeDelay(_attempts);
+    _nextAttempt = now + _delay;
+}
+
+void ReconnectScheduler::recovered(uint32_t now) {
+    if (!_active) return;
+
+    uint32_t duration = now - _outageStart;
+    _stats.recoveries++;
+    _stats.lastRecoveryTime = duration;
+    _stats.totalRecoveryTime += duration;
+    if (duration > _stats.maxRecoveryTime) {
+        _stats.maxRecoveryTime = duration;
+    }
+
+    cancel();
+}
+
+void ReconnectScheduler::cancel() {
+    _active = false;
+    _inFlight = false;
+    _attempts = 0;
+}
+
+uint32_t ReconnectScheduler::computeDelay(uint8_t failures) const {
+    uint64_t delay = _policy.initialDelay;
+    for (uint8_t i = 0; i < failures && delay < _policy.maxDelay; i++) {
+        delay = delay * _policy.backoffPercent / 100;
+    }
+    if (delay > _policy.maxDelay) {
+        delay = _policy.maxDelay;
+    }
+
+    // Spread uniformly over delay +/- jitterPercent using the hardware RNG
+    uint32_t spread = (uint32_t)(delay * _policy.jitterPercent / 100);
+    if (spread > 0) {
+        delay = delay - spread + rp2040.hwrand32() % (2 * spread + 1);
+    }
+
+    return (uint32_t)delay;
+}
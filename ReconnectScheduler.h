@@ -0,0 +1,71 @@
+/**
+ * ReconnectScheduler - Backoff timing for PicoWiFiManager's reconnects
+ *
+ * After a link loss attempts are spaced out exponentially up to a ceiling,
+ * with random jitter so devices that lost the same AP don't come back in
+ * lockstep and flood it (and its DHCP server) with joins.
+ */
+
+#ifndef RECONNECT_SCHEDULER_H
+#define RECONNECT_SCHEDULER_H
+
+#include <Arduino.h>
+
+struct ReconnectPolicy {
+    uint32_t initialDelay = 1000;      // ms from link loss to the first attempt
+    uint32_t maxDelay = 60000;         // Backoff ceiling in ms
+    uint16_t backoffPercent = 200;     // Delay growth per failed attempt (200 = doubling)
+    uint8_t jitterPercent = 30;        // Random +/- spread applied to every delay (at most 100)
+    bool fallbackToPortal = true;      // Start the portal after maxReconnectAttempts
+};
+
+struct ReconnectStats {
+    uint32_t linkLosses = 0;
+    uint32_t attempts = 0;             // Reconnect attempts over all outages
+    uint32_t recoveries = 0;
+    uint32_t portalFallbacks = 0;
+    uint32_t lastRecoveryTime = 0;     // ms from link loss to reconnect
+    uint32_t maxRecoveryTime = 0;
+    uint32_t totalRecoveryTime = 0;    // Divide by recoveries for the mean
+};
+
+class ReconnectScheduler {
+public:
+    ReconnectScheduler();
+
+    void setPolicy(const ReconnectPolicy& policy);
+    const ReconnectPolicy& getPolicy() const { return _policy; }
+
+    // Outage lifecycle
+    void begin(uint32_t now);            // Link lost: schedule the first attempt
+    void attemptStarted(uint32_t now);
+    void attemptFailed(uint32_t now);    // Schedule the next attempt
+    void recovered(uint32_t now);
+    void cancel();                       // Outage handled elsewhere (portal, disconnect)
+
+    bool isActive() const { return _active; }
+    bool isInFlight() const { return _inFlight; }
+    bool isDue(uint32_t now) const { return _active && !_inFlight && (int32_t)(now - _nextAttempt) >= 0; }
+
+    uint8_t getAttempts() const { return _attempts; }
+    uint32_t getCurrentDelay() const { return _delay; }
+    uint32_t getOutageDuration(uint32_t now) const { return _active ? now - _outageStart : 0; }
+
+    const ReconnectStats& getStats() const { return _stats; }
+    void countPortalFallback() { _stats.portalFallbacks++; }
+
+private:
+    ReconnectPolicy _policy;
+    ReconnectStats _stats;
+
+    bool _active;
+    bool _inFlight;
+    uint8_t _attempts;
+    uint32_t _outageStart;
+    uint32_t _nextAttempt;
+    uint32_t _delay;
+
+    uint32_t computeDelay(uint8_t failures) const;
+};
+
+#endif // RECONNECT_SCHEDULER_H
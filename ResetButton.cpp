@@ -0,0 +1,80 @@
+/**
+ * ResetButton - Implementation
+ */
+
+#include "ResetButton.h"
+
+ResetButton::ResetButton()
+    : _pin(DISABLED_PIN)
+    , _pressed(false)
+    , _pressStart(0)
+    , _edgeAt(0)
+    , _alarm(0) {
+}
+
+ResetButton::~ResetButton() {
+    end();
+}
+
+void ResetButton::begin(uint8_t pin) {
+    end();
+    if (pin == DISABLED_PIN) return;
+
+    _pin = pin;
+    pinMode(_pin, INPUT_PULLUP);
+    _pressed = digitalRead(_pin) == LOW;
+    _pressStart = millis();
+    attachInterruptParam(digitalPinToInterrupt(_pin), onEdge, CHANGE, this);
+}
+
+void ResetButton::end() {
+    if (_pin == DISABLED_PIN) return;
+
+    detachInterrupt(digitalPinToInterrupt(_pin));
+    if (_alarm > 0) {
+        cancel_alarm(_alarm);
+        _alarm = 0;
+    }
+    _pin = DISABLED_PIN;
+    _pressed = false;
+}
+
+void ResetButton::onEdge(void* param) {
+    ResetButton* button = static_cast<ResetButton*>(param);
+
+    // Every bounce pushes the settle time out again
+    if (button->_alarm > 0) {
+        cancel_alarm(button->_alarm);
+    } else {
+        button->_edgeAt = millis();
+    }
+    alarm_id_t alarm = add_alarm_in_ms(DEBOUNCE_MS, onSettled, button, true);
+    button->_alarm = alarm > 0 ? alarm : 0;
+}
+
+int64_t ResetButton::onSettled(alarm_id_t id, void* param) {
+    ResetButton* button = static_cast<ResetButton*>(param);
+    if (button->_alarm == id) {
+        button->_alarm = 0;
+        button->settle();
+    }
+    return 0; // One-shot
+}
+
+void ResetButton::settle() {
+    bool down = digitalRead(_pin) == LOW;
+
+    if (down && !_pressed) {
+        _pressed = true;
+        _pressStart = _edgeAt;
+    } else if (!down && _pressed) {
+        _pressed = false;
+        uint32_t duration = _edgeAt - _pressStart;
+
+        if (duration > LONG_PRESS_MS) {
+            _gestures.push(ButtonGesture::LONG_PRESS);
+        } else if (duration > SHORT_PRESS_MS) {
+            _gestures.push(ButtonGesture::SHORT_PRESS);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * ResetButton - Interrupt-driven reset button for PicoWiFiManager
+ *
+ * Edges on the button pin raise a GPIO interrupt that (re)arms a hardware
+ * alarm; when the pin has been quiet for DEBOUNCE_MS the alarm reads the
+ * settled level. Press and release times come from the interrupts, so a
+ * press is measured correctly even while loop() is blocked, and a finished
+ * gesture waits in a small queue until the manager polls for it.
+ *
+ * The button is active low with the internal pull-up enabled.
+ */
+
+#ifndef RESET_BUTTON_H
+#define RESET_BUTTON_H
+
+#include <Arduino.h>
+#include <pico/time.h>
+#include "InterCore.h"
+
+enum class ButtonGesture : uint8_t {
+    SHORT_PRESS,    // Restart the config portal
+    LONG_PRESS      // Factory reset
+};
+
+class ResetButton {
+public:
+    static const uint8_t DISABLED_PIN = 255;
+    static const uint32_t DEBOUNCE_MS = 30;
+    static const uint32_t SHORT_PRESS_MS = 100;
+    static const uint32_t LONG_PRESS_MS = 3000;
+
+    ResetButton();
+    ~ResetButton();
+
+    ResetButton(const ResetButton&) = delete;
+    ResetButton& operator=(const ResetButton&) = delete;
+
+    // Configures the pin and enables its interrupt; DISABLED_PIN turns it off
+    void begin(uint8_t pin);
+    void end();
+
+    // Consumer side: returns false when no gesture is waiting
+    bool poll(ButtonGesture& gesture) { return _gestures.pop(gesture); }
+
+    bool isEnabled() const { return _pin != DISABLED_PIN; }
+    bool isPressed() const { return _pressed; }
+    uint32_t getDroppedGestures() const { return _gestures.getDropped(); }
+
+private:
+    uint8_t _pin;
+    volatile bool _pressed;
+    volatile uint32_t _pressStart;
+    volatile uint32_t _edgeAt;       // First edge of the current bounce burst
+    volatile alarm_id_t _alarm;      // 0 while no debounce alarm is pending
+    SpscQueue<ButtonGesture, 4> _gestures;
+
+    // Interrupt context
+    static void onEdge(void* param);
+    static int64_t onSettled(alarm_id_t id, void* param);
+    void settle();
+};
+
+#endif // RESET_BUTTON_H
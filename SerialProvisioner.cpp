@@ -0,0 +1,279 @@
+/**
+ * SerialProvisioner - Implementation
+ */
+
+#include "PicoWiFiFeatures.h"
+
+#if PICOWIFI_ENABLE_SERIAL_PROVISIONING
+
+#include "SerialProvisioner.h"
+#include "Crc32.h"
+#include "PicoWiFiHAL.h"
+#include "PicoWiFiLog.h"
+
+#define PICOWIFI_LOG_TAG LogTag::PROVISIONER
+
+static void putU16(uint8_t* out, uint16_t value) {
+    out[0] = value & 0xFF;
+    out[1] = value >> 8;
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        out[i] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+SerialProvisioner::SerialProvisioner(StorageManager* storage)
+    : _storage(storage)
+    , _stream(nullptr)
+    , _synced(false)
+    , _sawSync0(false)
+    , _received(0)
+    , _expected(0)
+    , _lastByteAt(0)
+    , _awaitingConnect(false)
+    , _connectSeq(0) {
+}
+
+void SerialProvisioner::begin(Stream* stream) {
+    _stream = stream;
+    _awaitingConnect = false;
+    resync();
+    PICOWIFI_LOGI("Serial provisioning ready");
+}
+
+void SerialProvisioner::end() {
+    _stream = nullptr;
+    _awaitingConnect = false;
+}
+
+void SerialProvisioner::resync() {
+    _synced = false;
+    _sawSync0 = false;
+    _received = 0;
+    _expected = 0;
+}
+
+void SerialProvisioner::handle() {
+    if (!_stream) return;
+
+    uint32_t now = millis();
+    if (_synced && now - _lastByteAt > FRAME_TIMEOUT_MS) {
+        // The host gave up halfway through a frame
+        _stats.errors++;
+        resync();
+    }
+
+    // Bounded so a flood of bytes cannot stall the rest of loop()
+    for (size_t i = 0; i < MAX_BYTES_PER_HANDLE && _stream->available() > 0; i++) {
+        int byte = _stream->read();
+        if (byte < 0) break;
+        _lastByteAt = now;
+        receive((uint8_t)byte);
+    }
+}
+
+void SerialProvisioner::receive(uint8_t byte) {
+    if (!_synced) {
+        // Log text and line noise are skipped until the sync pair
+        if (_sawSync0 && byte == PROVISION_SYNC_1) {
+            _synced = true;
+            _received = 0;
+            _expected = 4;
+        } else {
+            _sawSync0 = byte == PROVISION_SYNC_0;
+        }
+        return;
+    }
+
+    _frame[_received++] = byte;
+
+    if (_received == 4) {
+        // Header complete: type, seq, length
+        size_t length = _frame[2] | ((size_t)_frame[3] << 8);
+        if (length > PROVISION_MAX_PAYLOAD) {
+            _stats.errors++;
+            reply(_frame[0], _frame[1], ProvisionResult::BAD_LENGTH);
+            resync();
+            return;
+        }
+        _expected = 4 + length + 4;
+    }
+
+    if (_received < _expected) return;
+
+    uint8_t type = _frame[0];
+    uint8_t seq = _frame[1];
+    size_t length = _expected - 8;
+    uint32_t crc = crc32(_frame, 4 + length);
+    resync();
+
+    if (crc != getU32(_frame + 4 + length)) {
+        _stats.errors++;
+        reply(type, seq, ProvisionResult::BAD_CRC);
+        return;
+    }
+
+    _stats.frames++;
+    dispatch(type, seq, _frame + 4, length);
+}
+
+void SerialProvisioner::dispatch(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length) {
+    switch ((ProvisionCommand)type) {
+        case ProvisionCommand::HELLO:
+            handleHello(seq);
+            break;
+        case ProvisionCommand::PROVISION:
+            handleProvision(seq, payload, length);
+            break;
+        case ProvisionCommand::STATUS:
+            handleStatus(seq);
+            break;
+        case ProvisionCommand::ERASE:
+            handleErase(seq);
+            break;
+        default:
+            reply(type, seq, ProvisionResult::UNKNOWN_COMMAND);
+            break;
+    }
+}
+
+void SerialProvisioner::handleHello(uint8_t seq) {
+    // version, network slots, saved networks, MAC
+    uint8_t data[9];
+    data[0] = PROVISION_PROTOCOL_VERSION;
+    data[1] = MAX_SAVED_NETWORKS;
+    data[2] = _storage->getNetworkCount();
+    PicoWiFiHAL::wifi().macAddress(data + 3);
+    reply((uint8_t)ProvisionCommand::HELLO, seq, ProvisionResult::OK, data, sizeof(data));
+}
+
+void SerialProvisioner::handleProvision(uint8_t seq, const uint8_t* payload, size_t length) {
+    // flags, priority, ssid length, ssid, password length, password
+    // [, channel, BSSID]
+    WiFiCredentials wifi;
+    size_t offset = 0;
+
+    bool valid = length >= 4;
+    uint8_t flags = valid ? payload[0] : 0;
+    if (valid) {
+        wifi.priority = payload[1];
+        uint8_t ssidLength = payload[2];
+        offset = 3;
+        valid = ssidLength > 0 && ssidLength < sizeof(wifi.ssid) && offset + ssidLength + 1 <= length;
+        if (valid) {
+            memcpy(wifi.ssid, payload + offset, ssidLength);
+            offset += ssidLength;
+        }
+    }
+    if (valid) {
+        uint8_t passwordLength = payload[offset++];
+        valid = passwordLength < sizeof(wifi.password) && offset + passwordLength <= length;
+        if (valid) {
+            memcpy(wifi.password, payload + offset, passwordLength);
+            offset += passwordLength;
+        }
+    }
+    if (valid && (flags & PROVISION_FLAG_HINT)) {
+        valid = offset + 1 + sizeof(wifi.fastConnect.bssid) <= length;
+        if (valid) {
+            // Seeds the fast-connect cache: the first join goes straight to this AP
+            wifi.fastConnect.valid = 1;
+            wifi.fastConnect.channel = payload[offset++];
+            memcpy(wifi.fastConnect.bssid, payload + offset, sizeof(wifi.fastConnect.bssid));
+            offset += sizeof(wifi.fastConnect.bssid);
+        }
+    }
+    if (!valid || offset != length) {
+        _stats.errors++;
+        reply((uint8_t)ProvisionCommand::PROVISION, seq, ProvisionResult::BAD_PAYLOAD);
+        return;
+    }
+    wifi.valid = true;
+
+    // One commit for the whole request; the other settings are kept
+    WiFiCredentials current;
+    NetworkConfig network;
+    DeviceConfig device;
+    _storage->loadAll(current, network, device);
+    if (!_storage->saveAll(wifi, network, device)) {
+        PICOWIFI_LOGE("Provisioned network could not be saved");
+        reply((uint8_t)ProvisionCommand::PROVISION, seq, ProvisionResult::STORAGE_FAILED);
+        return;
+    }
+    _stats.provisioned++;
+    PICOWIFI_LOGI("Provisioned %s", wifi.ssid);
+
+    uint8_t connecting = 0;
+    if ((flags & PROVISION_FLAG_CONNECT) && _onProvisioned && _onProvisioned(wifi)) {
+        connecting = 1;
+        _awaitingConnect = true;
+        _connectSeq = seq;
+    }
+    reply((uint8_t)ProvisionCommand::PROVISION, seq, ProvisionResult::OK, &connecting, 1);
+}
+
+void SerialProvisioner::handleStatus(uint8_t seq) {
+    // WiFi status, IP, RSSI, saved networks
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    uint8_t data[7];
+    bool connected = wifi.status() == WL_CONNECTED;
+    data[0] = wifi.status();
+    putU32(data + 1, connected ? (uint32_t)wifi.localIP() : 0);
+    data[5] = (uint8_t)(int8_t)(connected ? wifi.RSSI() : 0);
+    data[6] = _storage->getNetworkCount();
+    reply((uint8_t)ProvisionCommand::STATUS, seq, ProvisionResult::OK, data, sizeof(data));
+}
+
+void SerialProvisioner::handleErase(uint8_t seq) {
+    _storage->clearWiFiCredentials();
+    PICOWIFI_LOGI("Saved networks erased");
+    reply((uint8_t)ProvisionCommand::ERASE, seq, ProvisionResult::OK);
+}
+
+void SerialProvisioner::reportConnect(bool success, uint32_t ip, uint32_t duration, bool fast) {
+    if (!_awaitingConnect) return;
+    _awaitingConnect = false;
+
+    // IP, connect time, fast connect used
+    uint8_t data[9];
+    putU32(data, success ? ip : 0);
+    putU32(data + 4, duration);
+    data[8] = fast ? 1 : 0;
+    reply((uint8_t)ProvisionCommand::CONNECT_RESULT, _connectSeq,
+          success ? ProvisionResult::OK : ProvisionResult::CONNECT_FAILED, data, sizeof(data));
+}
+
+void SerialProvisioner::reply(uint8_t type, uint8_t seq, ProvisionResult result,
+                              const uint8_t* data, size_t length) {
+    uint8_t payload[1 + 16];
+    if (length > sizeof(payload) - 1) length = sizeof(payload) - 1;
+    payload[0] = (uint8_t)result;
+    if (length > 0) {
+        memcpy(payload + 1, data, length);
+    }
+    sendFrame(type | 0x80, seq, payload, 1 + length);
+}
+
+void SerialProvisioner::sendFrame(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length) {
+    if (!_stream) return;
+
+    uint8_t header[6] = {PROVISION_SYNC_0, PROVISION_SYNC_1, type, seq, 0, 0};
+    putU16(header + 4, (uint16_t)length);
+
+    uint32_t crc = crc32Update(CRC32_INITIAL, header + 2, 4);
+    crc = crc32Final(crc32Update(crc, payload, length));
+    uint8_t trailer[4];
+    putU32(trailer, crc);
+
+    _stream->write(header, sizeof(header));
+    _stream->write(payload, length);
+    _stream->write(trailer, sizeof(trailer));
+}
+
+#endif // PICOWIFI_ENABLE_SERIAL_PROVISIONING
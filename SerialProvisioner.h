@@ -0,0 +1,114 @@
+/**
+ * SerialProvisioner - Binary credential push over a serial port
+ *
+ * Lets a production line provision devices without the softAP portal: a
+ * host tool (extras/provision.py) writes the credentials in one framed
+ * request, the device stores them with a single StorageManager::saveAll()
+ * and starts connecting at once. An optional BSSID/channel hint goes into
+ * the fast-connect cache, so the first join skips the channel scan too.
+ *
+ * Frame (little endian), both directions:
+ *     0xA5 0x5A | type u8 | seq u8 | length u16 | payload | CRC-32 u32
+ * The CRC covers type through payload. Replies use the request type with
+ * bit 7 set and the request's seq; their payload starts with a
+ * ProvisionResult. Anything between frames (log text) is skipped by both
+ * sides, so the port can stay shared with PicoWiFiLog.
+ */
+
+#ifndef SERIAL_PROVISIONER_H
+#define SERIAL_PROVISIONER_H
+
+#include <Arduino.h>
+#include "ComponentSlot.h"
+#include "StorageManager.h"
+
+static const uint8_t PROVISION_PROTOCOL_VERSION = 1;
+static const uint8_t PROVISION_SYNC_0 = 0xA5;
+static const uint8_t PROVISION_SYNC_1 = 0x5A;
+static const size_t PROVISION_MAX_PAYLOAD = 128;
+
+enum class ProvisionCommand : uint8_t {
+    HELLO = 0x01,           // -> version, slots, saved networks, MAC
+    PROVISION = 0x02,       // Save one network (and connect)
+    STATUS = 0x03,          // -> WiFi state, IP, RSSI
+    ERASE = 0x04,           // Forget every saved network
+    CONNECT_RESULT = 0x10   // Sent unasked when a provisioned connect ends
+};
+
+// PROVISION flags
+static const uint8_t PROVISION_FLAG_CONNECT = 0x01;  // Connect once saved
+static const uint8_t PROVISION_FLAG_HINT = 0x02;     // Channel + BSSID follow the password
+
+enum class ProvisionResult : uint8_t {
+    OK,
+    BAD_CRC,
+    BAD_LENGTH,
+    BAD_PAYLOAD,
+    UNKNOWN_COMMAND,
+    STORAGE_FAILED,
+    CONNECT_FAILED
+};
+
+struct ProvisioningStats {
+    uint32_t frames = 0;        // Requests received intact
+    uint32_t errors = 0;        // Bad CRC, length or payload
+    uint32_t provisioned = 0;   // Networks saved
+};
+
+// Gets the saved network; returns true if a connect was started
+typedef CallbackFunction<bool(const WiFiCredentials&)> ProvisionCallback;
+
+class SerialProvisioner {
+public:
+    explicit SerialProvisioner(StorageManager* storage);
+
+    void begin(Stream* stream);
+    void end();
+    bool isActive() const { return _stream != nullptr; }
+
+    // Reads whatever has arrived, never blocks
+    void handle();
+
+    void onProvisioned(ProvisionCallback callback) { _onProvisioned = callback; }
+
+    // Result of the connect a PROVISION request started
+    void reportConnect(bool success, uint32_t ip, uint32_t duration, bool fast);
+    bool isAwaitingConnect() const { return _awaitingConnect; }
+
+    const ProvisioningStats& getStats() const { return _stats; }
+
+private:
+    StorageManager* _storage;
+    Stream* _stream;
+    ProvisionCallback _onProvisioned;
+    ProvisioningStats _stats;
+
+    // Receive state: after the sync bytes _frame collects header, payload, CRC
+    bool _synced;
+    bool _sawSync0;
+    size_t _received;
+    size_t _expected;
+    uint32_t _lastByteAt;
+    uint8_t _frame[4 + PROVISION_MAX_PAYLOAD + 4];
+
+    bool _awaitingConnect;
+    uint8_t _connectSeq;
+
+    void resync();
+    void receive(uint8_t byte);
+    void dispatch(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length);
+
+    void handleHello(uint8_t seq);
+    void handleProvision(uint8_t seq, const uint8_t* payload, size_t length);
+    void handleStatus(uint8_t seq);
+    void handleErase(uint8_t seq);
+
+    void reply(uint8_t type, uint8_t seq, ProvisionResult result,
+               const uint8_t* data = nullptr, size_t length = 0);
+    void sendFrame(uint8_t type, uint8_t seq, const uint8_t* payload, size_t length);
+
+    static const uint32_t FRAME_TIMEOUT_MS = 500;   // Gap that abandons a partial frame
+    static const size_t MAX_BYTES_PER_HANDLE = 256;
+};
+
+#endif // SERIAL_PROVISIONER_H
@@ -0,0 +1,104 @@
+/**
+ * SimulatedStorage - Implementation
+ */
+
+#include "SimulatedStorage.h"
+
+SimulatedPowerLoss::Outcome SimulatedPowerLoss::operation(uint32_t micros) {
+    if (_failed) {
+        _stats.lostOperations++;
+        return Outcome::LOST;
+    }
+
+    if (micros > 0) {
+        delayMicroseconds(micros);
+    }
+    _stats.busyMicros += micros;
+
+    if (_armed && _remaining-- == 0) {
+        _armed = false;
+        _failed = true;
+        return Outcome::TORN;
+    }
+    return Outcome::COMPLETE;
+}
+
+// SimulatedFlashDriver
+
+SimulatedFlashDriver::SimulatedFlashDriver(uint8_t* region, size_t size)
+    : _region(region)
+    , _size(size - size % FLASH_SECTOR_SIZE) {
+    wipe();
+}
+
+void SimulatedFlashDriver::wipe() {
+    memset(_region, 0xFF, _size);
+}
+
+void SimulatedFlashDriver::eraseSector(uintptr_t address) {
+    _stats.erases++;
+    Outcome outcome = operation(_timing.eraseMicros);
+    if (outcome == Outcome::LOST || address < getRegionStart() || address >= getRegionEnd()) {
+        return;
+    }
+
+    uint8_t* sector = _region + ((address - getRegionStart()) & ~(uintptr_t)(FLASH_SECTOR_SIZE - 1));
+    memset(sector, 0xFF, outcome == Outcome::TORN ? FLASH_SECTOR_SIZE / 2 : FLASH_SECTOR_SIZE);
+}
+
+void SimulatedFlashDriver::programPage(uintptr_t address, const uint8_t* page) {
+    _stats.programs++;
+    Outcome outcome = operation(_timing.programMicros);
+    if (outcome == Outcome::LOST || address < getRegionStart() ||
+        address + FLASH_PAGE_SIZE > getRegionEnd()) {
+        return;
+    }
+
+    // NOR programming only clears bits
+    uint8_t* target = _region + (address - getRegionStart());
+    size_t length = outcome == Outcome::TORN ? FLASH_PAGE_SIZE / 2 : FLASH_PAGE_SIZE;
+    for (size_t i = 0; i < length; i++) {
+        target[i] &= page[i];
+    }
+}
+
+// SimulatedEEPROMDriver
+
+SimulatedEEPROMDriver::SimulatedEEPROMDriver(uint8_t* stored, uint8_t* image, size_t capacity)
+    : _stored(stored)
+    , _image(image)
+    , _capacity(capacity)
+    , _size(capacity) {
+    wipe();
+}
+
+void SimulatedEEPROMDriver::wipe() {
+    memset(_stored, 0xFF, _capacity);
+    memset(_image, 0xFF, _capacity);
+}
+
+void SimulatedEEPROMDriver::begin(size_t size) {
+    _size = size < _capacity ? size : _capacity;
+    memcpy(_image, _stored, _size);
+}
+
+bool SimulatedEEPROMDriver::commit() {
+    // One sector erase, then the image page by page
+    _stats.erases++;
+    Outcome outcome = operation(_timing.eraseMicros);
+    if (outcome == Outcome::LOST) return false;
+
+    memset(_stored, 0xFF, outcome == Outcome::TORN ? _size / 2 : _size);
+    if (outcome == Outcome::TORN) return false;
+
+    for (size_t offset = 0; offset < _size; offset += FLASH_PAGE_SIZE) {
+        size_t length = _size - offset < FLASH_PAGE_SIZE ? _size - offset : FLASH_PAGE_SIZE;
+        _stats.programs++;
+        outcome = operation(_timing.programMicros);
+        if (outcome == Outcome::LOST) return false;
+
+        memcpy(_stored + offset, _image + offset, outcome == Outcome::TORN ? length / 2 : length);
+        if (outcome == Outcome::TORN) return false;
+    }
+    return true;
+}
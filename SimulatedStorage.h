@@ -0,0 +1,113 @@
+/**
+ * SimulatedStorage - RAM-backed FlashDriver and EEPROMDriver
+ *
+ * Lets StorageManager run every backend against a RAM image with flash
+ * timing and power-loss injection:
+ *
+ *     alignas(FLASH_SECTOR_SIZE) static uint8_t region[6 * FLASH_SECTOR_SIZE];
+ *     SimulatedFlashDriver flash(region, sizeof(region));
+ *     PicoWiFiHAL::setFlashDriver(&flash);
+ *
+ * Both drivers count sector erases and page programs as operations.
+ * failAfter(n) lets n more operations complete, tears the next one halfway
+ * and drops everything after it until powerCycle(), as if power was cut
+ * at that point.
+ */
+
+#ifndef SIMULATED_STORAGE_H
+#define SIMULATED_STORAGE_H
+
+#include <Arduino.h>
+#include <hardware/flash.h>
+#include "PicoWiFiHAL.h"
+
+// Typical QSPI NOR figures; all zero runs at RAM speed
+struct SimulatedFlashTiming {
+    uint32_t eraseMicros = 45000;    // One 4 KB sector
+    uint32_t programMicros = 400;    // One 256-byte page
+};
+
+struct SimulatedFlashStats {
+    uint32_t erases = 0;
+    uint32_t programs = 0;
+    uint32_t busyMicros = 0;         // Time spent in simulated operations
+    uint32_t lostOperations = 0;     // Dropped while the power was cut
+};
+
+// Power-loss bookkeeping shared by both drivers
+class SimulatedPowerLoss {
+public:
+    SimulatedPowerLoss() : _armed(false), _failed(false), _remaining(0) {}
+
+    void failAfter(uint32_t operations) {
+        _armed = true;
+        _remaining = operations;
+    }
+    void powerCycle() {
+        _armed = false;
+        _failed = false;
+    }
+    bool hasFailed() const { return _failed; }
+
+protected:
+    enum class Outcome : uint8_t { COMPLETE, TORN, LOST };
+
+    SimulatedFlashTiming _timing;
+    SimulatedFlashStats _stats;
+
+    // Decides the fate of the next operation and charges its time
+    Outcome operation(uint32_t micros);
+
+private:
+    bool _armed;
+    bool _failed;
+    uint32_t _remaining;
+};
+
+class SimulatedFlashDriver : public FlashDriver, public SimulatedPowerLoss {
+public:
+    // region must be FLASH_SECTOR_SIZE aligned and a multiple of it in size
+    SimulatedFlashDriver(uint8_t* region, size_t size);
+
+    void setTiming(const SimulatedFlashTiming& timing) { _timing = timing; }
+    const SimulatedFlashStats& getStats() const { return _stats; }
+
+    // Back to erased flash (all 0xFF)
+    void wipe();
+
+    // FlashDriver
+    uintptr_t getRegionStart() override { return (uintptr_t)_region; }
+    uintptr_t getRegionEnd() override { return (uintptr_t)_region + _size; }
+    void eraseSector(uintptr_t address) override;
+    void programPage(uintptr_t address, const uint8_t* page) override;
+
+private:
+    uint8_t* _region;
+    size_t _size;
+};
+
+class SimulatedEEPROMDriver : public EEPROMDriver, public SimulatedPowerLoss {
+public:
+    // stored holds what survives a power cut, image the working copy; both
+    // need capacity bytes
+    SimulatedEEPROMDriver(uint8_t* stored, uint8_t* image, size_t capacity);
+
+    void setTiming(const SimulatedFlashTiming& timing) { _timing = timing; }
+    const SimulatedFlashStats& getStats() const { return _stats; }
+
+    void wipe();
+
+    // EEPROMDriver; a commit rewrites the whole sector like EEPROM emulation
+    void begin(size_t size) override;
+    void end() override {}
+    uint8_t* getData() override { return _image; }
+    bool commit() override;
+
+private:
+    uint8_t* _stored;
+    uint8_t* _image;
+    size_t _capacity;
+    size_t _size;
+};
+
+#endif // SIMULATED_STORAGE_H
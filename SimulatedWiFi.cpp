@@ -0,0 +1,268 @@
+/**
+ * SimulatedWiFi - Implementation
+ */
+
+#include "SimulatedWiFi.h"
+#include "NetworkScanner.h"
+
+// Lease handed out by the simulated network (IPAddress byte order)
+static const uint32_t SIM_GATEWAY = 0x0100000A;   // 10.0.0.1, also the DNS server
+static const uint32_t SIM_LEASE = 0x6400000A;     // 10.0.0.100
+static const uint32_t SIM_SUBNET = 0x00FFFFFF;    // 255.255.255.0
+
+static const uint8_t SIM_MAC[6] = {0x28, 0xCD, 0xC1, 0x00, 0x00, 0x01};
+
+SimulatedWiFiDriver::SimulatedWiFiDriver()
+    : _apCount(0)
+    , _mode(WIFI_OFF)
+    , _status(WL_IDLE_STATUS)
+    , _failConnects(0)
+    , _powered(true)
+    , _associated(-1)
+    , _joining(-1)
+    , _joinPending(false)
+    , _joinAccepted(false)
+    , _joinStart(0)
+    , _joinLatency(0)
+    , _staticIP(0)
+    , _staticDNS(0)
+    , _staticGateway(0)
+    , _staticSubnet(0)
+    , _sink(nullptr)
+    , _sinkContext(nullptr)
+    , _scanActive(false)
+    , _scanStart(0) {
+}
+
+bool SimulatedWiFiDriver::addAccessPoint(const char* ssid, const char* password, uint8_t channel,
+                                         int8_t rssi, const uint8_t* bssid) {
+    if (!ssid || _apCount >= MAX_ACCESS_POINTS) return false;
+
+    SimulatedAccessPoint& ap = _aps[_apCount];
+    ap = SimulatedAccessPoint();
+    strncpy(ap.ssid, ssid, sizeof(ap.ssid) - 1);
+    if (password) {
+        strncpy(ap.password, password, sizeof(ap.password) - 1);
+    }
+    if (bssid) {
+        memcpy(ap.bssid, bssid, sizeof(ap.bssid));
+    } else {
+        // Locally administered, numbered in order of creation
+        const uint8_t generated[6] = {0x02, 0x00, 0x5E, 0x00, 0x00, (uint8_t)(_apCount + 1)};
+        memcpy(ap.bssid, generated, sizeof(ap.bssid));
+    }
+    ap.channel = channel;
+    ap.rssi = rssi;
+    _apCount++;
+    return true;
+}
+
+void SimulatedWiFiDriver::clearAccessPoints() {
+    disconnect();
+    _apCount = 0;
+}
+
+SimulatedAccessPoint* SimulatedWiFiDriver::getAccessPoint(uint8_t index) {
+    return index < _apCount ? &_aps[index] : nullptr;
+}
+
+void SimulatedWiFiDriver::dropLink() {
+    advance();
+    if (_associated < 0) return;
+
+    _associated = -1;
+    _status = WL_CONNECTION_LOST;
+    _stats.drops++;
+}
+
+void SimulatedWiFiDriver::config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet) {
+    _staticIP = (uint32_t)ip;
+    _staticDNS = (uint32_t)dns;
+    _staticGateway = (uint32_t)gateway;
+    _staticSubnet = (uint32_t)subnet;
+}
+
+void SimulatedWiFiDriver::beginNoBlock(const char* ssid, const char* password, const uint8_t* bssid) {
+    _stats.joins++;
+    _associated = -1;
+    _status = WL_DISCONNECTED;
+
+    _joining = findAccessPoint(ssid, bssid);
+    _joinPending = true;
+    _joinStart = millis();
+    _joinLatency = bssid ? _timing.pinnedLatency : _timing.connectLatency;
+    if (_staticIP == 0) {
+        _joinLatency += _timing.dhcpLatency;
+    }
+
+    const char* given = password ? password : "";
+    _joinAccepted = _powered && _joining >= 0 && strcmp(_aps[_joining].password, given) == 0;
+    if (_joinAccepted && _failConnects > 0) {
+        _failConnects--;
+        _joinAccepted = false;
+    }
+}
+
+void SimulatedWiFiDriver::disconnect() {
+    _associated = -1;
+    _joinPending = false;
+    _status = WL_DISCONNECTED;
+}
+
+void SimulatedWiFiDriver::advance() {
+    if (!_joinPending || millis() - _joinStart < _joinLatency) return;
+
+    _joinPending = false;
+    if (_joinAccepted) {
+        _associated = _joining;
+        _status = WL_CONNECTED;
+    } else {
+        // An unknown SSID is reported once the driver gave up looking for it
+        _status = _joining >= 0 ? WL_CONNECT_FAILED : WL_NO_SSID_AVAIL;
+        _stats.rejected++;
+    }
+}
+
+uint8_t SimulatedWiFiDriver::status() {
+    advance();
+    return _status;
+}
+
+void SimulatedWiFiDriver::powerOff() {
+    if (!_powered) return;
+
+    disconnect();
+    _scanActive = false;
+    _powered = false;
+    _stats.powerCycles++;
+}
+
+void SimulatedWiFiDriver::powerOn() {
+    if (_powered) return;
+
+    delay(_timing.powerOnLatency);
+    _powered = true;
+}
+
+IPAddress SimulatedWiFiDriver::localIP() {
+    if (status() != WL_CONNECTED) return INADDR_NONE;
+    return IPAddress(_staticIP != 0 ? _staticIP : SIM_LEASE);
+}
+
+IPAddress SimulatedWiFiDriver::gatewayIP() {
+    if (status() != WL_CONNECTED) return INADDR_NONE;
+    return IPAddress(_staticIP != 0 ? _staticGateway : SIM_GATEWAY);
+}
+
+IPAddress SimulatedWiFiDriver::subnetMask() {
+    if (status() != WL_CONNECTED) return INADDR_NONE;
+    return IPAddress(_staticIP != 0 ? _staticSubnet : SIM_SUBNET);
+}
+
+IPAddress SimulatedWiFiDriver::dnsIP() {
+    if (status() != WL_CONNECTED) return INADDR_NONE;
+    return IPAddress(_staticIP != 0 ? _staticDNS : SIM_GATEWAY);
+}
+
+const char* SimulatedWiFiDriver::SSID() {
+    const SimulatedAccessPoint* ap = current();
+    return ap ? ap->ssid : "";
+}
+
+int32_t SimulatedWiFiDriver::RSSI() {
+    const SimulatedAccessPoint* ap = current();
+    return ap ? ap->rssi : 0;
+}
+
+uint8_t SimulatedWiFiDriver::channel() {
+    const SimulatedAccessPoint* ap = current();
+    return ap ? ap->channel : 0;
+}
+
+void SimulatedWiFiDriver::BSSID(uint8_t* bssid) {
+    const SimulatedAccessPoint* ap = current();
+    if (ap) {
+        memcpy(bssid, ap->bssid, sizeof(ap->bssid));
+    } else {
+        memset(bssid, 0, 6);
+    }
+}
+
+void SimulatedWiFiDriver::macAddress(uint8_t* mac) {
+    memcpy(mac, SIM_MAC, sizeof(SIM_MAC));
+}
+
+int SimulatedWiFiDriver::scanNetworks() {
+    // Blocks like the real scan, including any join that completes meanwhile
+    if (!_powered) return -1;
+
+    delay(_timing.scanLatency);
+    advance();
+    _stats.scans++;
+    return _apCount;
+}
+
+bool SimulatedWiFiDriver::getScanResult(uint8_t index, ScannedNetwork& network) {
+    if (index >= _apCount) return false;
+    toScannedNetwork(_aps[index], network);
+    return true;
+}
+
+int SimulatedWiFiDriver::startAsyncScan(ScanResultSink sink, void* context) {
+    if (_scanActive || !_powered) return -1;
+
+    _sink = sink;
+    _sinkContext = context;
+    _scanActive = true;
+    _scanStart = millis();
+    return 0;
+}
+
+bool SimulatedWiFiDriver::isAsyncScanActive() {
+    if (!_scanActive) return false;
+    if (millis() - _scanStart < _timing.scanLatency) return true;
+
+    // Like the CYW43, every BSS is reported for its beacon and again for its
+    // probe response, slightly weaker the second time
+    ScannedNetwork network;
+    for (uint8_t pass = 0; pass < 2 && _sink; pass++) {
+        for (uint8_t i = 0; i < _apCount; i++) {
+            toScannedNetwork(_aps[i], network);
+            network.rssi -= pass * 3;
+            _sink(_sinkContext, network);
+        }
+    }
+
+    _scanActive = false;
+    _stats.scans++;
+    return false;
+}
+
+int SimulatedWiFiDriver::findAccessPoint(const char* ssid, const uint8_t* bssid) const {
+    if (!ssid) return -1;
+
+    // A pinned join goes to that AP only, otherwise to the strongest one
+    int best = -1;
+    for (uint8_t i = 0; i < _apCount; i++) {
+        if (strcmp(_aps[i].ssid, ssid) != 0) continue;
+        if (bssid && memcmp(_aps[i].bssid, bssid, sizeof(_aps[i].bssid)) != 0) continue;
+        if (best < 0 || _aps[i].rssi > _aps[best].rssi) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+const SimulatedAccessPoint* SimulatedWiFiDriver::current() const {
+    return _associated >= 0 ? &_aps[_associated] : nullptr;
+}
+
+void SimulatedWiFiDriver::toScannedNetwork(const SimulatedAccessPoint& ap, ScannedNetwork& network) const {
+    network = ScannedNetwork();
+    memcpy(network.ssid, ap.ssid, sizeof(network.ssid));
+    memcpy(network.bssid, ap.bssid, sizeof(network.bssid));
+    network.rssi = ap.rssi;
+    network.channel = ap.channel;
+    network.encType = ap.password[0] ? ENC_TYPE_CCMP : ENC_TYPE_NONE;
+    network.hidden = ap.ssid[0] == '\0';
+}
@@ -0,0 +1,131 @@
+/**
+ * SimulatedWiFi - Scripted WiFiDriver for benchmarks and fault injection
+ *
+ * Replaces the CYW43 radio with a list of access points and fixed
+ * latencies, so connect, reconnect and scan paths of PicoWiFiManager run
+ * the same way every time:
+ *
+ *     SimulatedWiFiDriver radio;
+ *     radio.addAccessPoint("Office", "secret", 6, -55);
+ *     PicoWiFiHAL::setWiFiDriver(&radio);
+ *
+ * Joins complete connectLatency ms after beginNoBlock() (pinnedLatency when
+ * a BSSID is given), plus dhcpLatency unless config() set an address.
+ * While powered off every join is rejected and scans fail; powerOn() blocks
+ * for powerOnLatency.
+ * State changes are applied when the driver is polled; nothing runs in the
+ * background.
+ */
+
+#ifndef SIMULATED_WIFI_H
+#define SIMULATED_WIFI_H
+
+#include <Arduino.h>
+#include "PicoWiFiHAL.h"
+
+struct SimulatedAccessPoint {
+    char ssid[33] = {0};
+    char password[64] = {0};   // Empty for an open network
+    uint8_t bssid[6] = {0};
+    uint8_t channel = 1;
+    int8_t rssi = -60;
+};
+
+struct SimulatedRadioTiming {
+    uint32_t connectLatency = 2500;  // ms, join including the driver's channel sweep
+    uint32_t pinnedLatency = 700;    // ms, join with BSSID and channel known
+    uint32_t dhcpLatency = 400;      // ms, skipped when config() set an address
+    uint32_t scanLatency = 2200;     // ms, blocking and background scans
+    uint32_t powerOnLatency = 150;   // ms, powerOn() bringing the radio back up
+};
+
+struct SimulatedRadioStats {
+    uint32_t joins = 0;              // beginNoBlock() calls
+    uint32_t rejected = 0;           // Joins that ended without a link
+    uint32_t scans = 0;
+    uint32_t drops = 0;              // dropLink() calls that took a link down
+    uint32_t powerCycles = 0;        // powerOff() calls on a running radio
+};
+
+class SimulatedWiFiDriver : public WiFiDriver {
+public:
+    static const uint8_t MAX_ACCESS_POINTS = 64;
+
+    SimulatedWiFiDriver();
+
+    // Scripting; bssid nullptr generates a unique one
+    bool addAccessPoint(const char* ssid, const char* password, uint8_t channel,
+                        int8_t rssi, const uint8_t* bssid = nullptr);
+    void clearAccessPoints();
+    uint8_t getAccessPointCount() const { return _apCount; }
+    SimulatedAccessPoint* getAccessPoint(uint8_t index);
+
+    void setTiming(const SimulatedRadioTiming& timing) { _timing = timing; }
+    const SimulatedRadioTiming& getTiming() const { return _timing; }
+
+    // The next count joins are rejected (WL_CONNECT_FAILED)
+    void failNextConnects(uint8_t count) { _failConnects = count; }
+
+    // Takes the current association down, as when the AP reboots
+    void dropLink();
+
+    const SimulatedRadioStats& getStats() const { return _stats; }
+
+    // WiFiDriver
+    void setMode(WiFiMode_t mode) override { _mode = mode; }
+    void config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet) override;
+    void beginNoBlock(const char* ssid, const char* password, const uint8_t* bssid) override;
+    void disconnect() override;
+    uint8_t status() override;
+    void powerOff() override;
+    void powerOn() override;
+    IPAddress localIP() override;
+    IPAddress gatewayIP() override;
+    IPAddress subnetMask() override;
+    IPAddress dnsIP() override;
+    const char* SSID() override;
+    int32_t RSSI() override;
+    uint8_t channel() override;
+    void BSSID(uint8_t* bssid) override;
+    void macAddress(uint8_t* mac) override;
+    int scanNetworks() override;
+    bool getScanResult(uint8_t index, ScannedNetwork& network) override;
+    int startAsyncScan(ScanResultSink sink, void* context) override;
+    bool isAsyncScanActive() override;
+
+private:
+    SimulatedAccessPoint _aps[MAX_ACCESS_POINTS];
+    uint8_t _apCount;
+    SimulatedRadioTiming _timing;
+    SimulatedRadioStats _stats;
+    WiFiMode_t _mode;
+    uint8_t _status;
+    uint8_t _failConnects;
+    bool _powered;
+
+    // Current association and the join in flight (-1: none / no such AP)
+    int _associated;
+    int _joining;
+    bool _joinPending;
+    bool _joinAccepted;
+    uint32_t _joinStart;
+    uint32_t _joinLatency;
+
+    // Addresses from config(); zero means DHCP
+    uint32_t _staticIP;
+    uint32_t _staticDNS;
+    uint32_t _staticGateway;
+    uint32_t _staticSubnet;
+
+    ScanResultSink _sink;
+    void* _sinkContext;
+    bool _scanActive;
+    uint32_t _scanStart;
+
+    void advance();
+    int findAccessPoint(const char* ssid, const uint8_t* bssid) const;
+    const SimulatedAccessPoint* current() const;
+    void toScannedNetwork(const SimulatedAccessPoint& ap, ScannedNetwork& network) const;
+};
+
+#endif // SIMULATED_WIFI_H
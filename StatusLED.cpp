@@ -0,0 +1,135 @@
+/**
+ * StatusLED - Implementation
+ */
+
+#include "StatusLED.h"
+#include <pico/cyw43_arch.h>
+#include <hardware/gpio.h>
+#include <hardware/pwm.h>
+
+StatusLED::StatusLED()
+    : _pin(DISABLED_PIN)
+    , _mode(LEDMode::OFF)
+    , _lit(false)
+    , _step(0)
+    , _timerActive(false)
+    , _workerActive(false)
+    , _worker()
+    , _context(nullptr) {
+}
+
+StatusLED::~StatusLED() {
+    end();
+}
+
+void StatusLED::begin(uint8_t pin) {
+    end();
+    if (pin == DISABLED_PIN) return;
+
+    _pin = pin;
+    if (isRadioPin()) {
+        _context = cyw43_arch_async_context();
+        _worker.do_work = onWorker;
+        _worker.user_data = this;
+    } else {
+        // Squared levels give a roughly even fade; this sets the whole slice
+        uint slice = pwm_gpio_to_slice_num(_pin);
+        gpio_set_function(_pin, GPIO_FUNC_PWM);
+        pwm_set_wrap(slice, 255 * 255);
+        pwm_set_enabled(slice, true);
+    }
+    apply();
+}
+
+void StatusLED::end() {
+    if (_pin == DISABLED_PIN) return;
+
+    stopTimers();
+    write(0);
+    _pin = DISABLED_PIN;
+}
+
+void StatusLED::setMode(LEDMode mode) {
+    if (mode == _mode) return;
+    _mode = mode;
+    if (isEnabled()) {
+        apply();
+    }
+}
+
+void StatusLED::apply() {
+    stopTimers();
+
+    if (_mode == LEDMode::OFF || _mode == LEDMode::ON) {
+        write(_mode == LEDMode::ON ? 255 : 0);
+        return;
+    }
+
+    // Patterns start lit (PULSE from dark) and advance from the timer
+    _step = 0;
+    _lit = _mode != LEDMode::PULSE || isRadioPin();
+    write(_lit ? 255 : 0);
+
+    uint32_t interval = getStepInterval();
+    if (isRadioPin()) {
+        _workerActive = async_context_add_at_time_worker_in_ms(_context, &_worker, interval);
+    } else {
+        _timerActive = add_repeating_timer_ms(-(int32_t)interval, onTimer, this, &_timer);
+    }
+}
+
+void StatusLED::stopTimers() {
+    if (_timerActive) {
+        cancel_repeating_timer(&_timer);
+        _timerActive = false;
+    }
+    if (_workerActive) {
+        // Takes the context lock, so the worker is neither running nor queued afterwards
+        async_context_remove_at_time_worker(_context, &_worker);
+        _workerActive = false;
+    }
+}
+
+uint32_t StatusLED::getStepInterval() const {
+    switch (_mode) {
+        case LEDMode::FAST_BLINK: return FAST_BLINK_MS;
+        case LEDMode::SLOW_BLINK: return SLOW_BLINK_MS;
+        case LEDMode::PULSE: return isRadioPin() ? PULSE_PERIOD_MS / 2 : PULSE_STEP_MS;
+        default: return 0;
+    }
+}
+
+void StatusLED::write(uint8_t level) {
+    if (isRadioPin()) {
+        cyw43_arch_gpio_put(_pin - RADIO_PIN_BASE, level > 0);
+    } else {
+        pwm_set_gpio_level(_pin, (uint16_t)level * level);
+    }
+}
+
+uint8_t StatusLED::nextLevel() {
+    if (_mode == LEDMode::PULSE && !isRadioPin()) {
+        // Triangle ramp: up for half the period, down for the other half
+        const uint16_t steps = PULSE_PERIOD_MS / PULSE_STEP_MS;
+        const uint16_t half = steps / 2;
+        _step = (_step + 1) % steps;
+        uint16_t ramp = _step < half ? _step : steps - _step;
+        return (uint8_t)(ramp * 255 / half);
+    }
+
+    _lit = !_lit;
+    return _lit ? 255 : 0;
+}
+
+bool StatusLED::onTimer(repeating_timer_t* timer) {
+    StatusLED* led = static_cast<StatusLED*>(timer->user_data);
+    led->write(led->nextLevel());
+    return true;
+}
+
+void StatusLED::onWorker(async_context_t* context, async_at_time_worker_t* worker) {
+    // At-time workers are one-shot; re-queue for the next step
+    StatusLED* led = static_cast<StatusLED*>(worker->user_data);
+    led->write(led->nextLevel());
+    async_context_add_at_time_worker_in_ms(context, worker, led->getStepInterval());
+}
@@ -0,0 +1,79 @@
+/**
+ * StatusLED - Timer-driven status LED for PicoWiFiManager
+ *
+ * The LED is only touched when the mode changes or a blink step is due;
+ * nothing runs per loop() pass. External GPIO LEDs are driven by a PWM
+ * slice stepped from a repeating hardware timer, which also makes PULSE a
+ * real fade. The Pico W's LED sits behind the CYW43, so every change is a
+ * bus transaction to the radio: it is stepped from an at-time worker in
+ * the radio's async context (the only place those writes are allowed
+ * outside thread context), and PULSE becomes a slow blink since it can't
+ * be dimmed.
+ */
+
+#ifndef STATUS_LED_H
+#define STATUS_LED_H
+
+#include <Arduino.h>
+#include <pico/time.h>
+#include <pico/async_context.h>
+
+// Status LED behavior
+enum class LEDMode {
+    OFF,
+    ON,
+    FAST_BLINK,    // Config mode
+    SLOW_BLINK,    // Connecting
+    PULSE          // Error
+};
+
+class StatusLED {
+public:
+    static const uint8_t DISABLED_PIN = 255;
+    // arduino-pico numbers the CYW43's own GPIOs from 64 (LED_BUILTIN on a Pico W)
+    static const uint8_t RADIO_PIN_BASE = 64;
+
+    static const uint32_t FAST_BLINK_MS = 100;   // Half period
+    static const uint32_t SLOW_BLINK_MS = 200;
+    static const uint32_t PULSE_PERIOD_MS = 2000;
+    static const uint32_t PULSE_STEP_MS = 20;
+
+    StatusLED();
+    ~StatusLED();
+
+    StatusLED(const StatusLED&) = delete;
+    StatusLED& operator=(const StatusLED&) = delete;
+
+    // Takes over the pin and shows the current mode; DISABLED_PIN turns it off
+    void begin(uint8_t pin);
+    void end();
+
+    // Cheap when the mode is unchanged
+    void setMode(LEDMode mode);
+    LEDMode getMode() const { return _mode; }
+
+    bool isEnabled() const { return _pin != DISABLED_PIN; }
+    bool isRadioPin() const { return _pin >= RADIO_PIN_BASE && _pin != DISABLED_PIN; }
+
+private:
+    uint8_t _pin;
+    LEDMode _mode;
+    volatile bool _lit;
+    volatile uint16_t _step;          // Position in the PULSE ramp
+    bool _timerActive;
+    bool _workerActive;
+    repeating_timer_t _timer;         // GPIO pins
+    async_at_time_worker_t _worker;   // CYW43 pin
+    async_context_t* _context;
+
+    void apply();
+    void stopTimers();
+    uint32_t getStepInterval() const;
+    void write(uint8_t level);        // 0-255
+    uint8_t nextLevel();
+
+    static bool onTimer(repeating_timer_t* timer);
+    static void onWorker(async_context_t* context, async_at_time_worker_t* worker);
+};
+
+#endif // STATUS_LED_H
@@ -0,0 +1,260 @@
+/**
+ * StatusServer - Monitoring endpoints implementation
+ */
+
+#include "PicoWiFiFeatures.h"
+
+#if PICOWIFI_ENABLE_STATUS_SERVER
+
+#include "StatusServer.h"
+#include "PicoWiFiManager.h"
+#if PICOWIFI_ENABLE_SCANNER
+#include "NetworkScanner.h"
+#endif
+#include "ChunkedResponse.h"
+
+StatusServer::StatusServer(PicoWiFiManager* manager)
+    : _manager(manager)
+    , _scanner(nullptr)
+    , _active(false)
+    , _port(0)
+    , _requests(0) {
+}
+
+StatusServer::~StatusServer() {
+    _server.destroy();
+}
+
+bool StatusServer::start(uint16_t port) {
+    if (_active) return true;
+
+    // The routes are bound to the server, so it lives as long as its port
+    if (_server && _port != port) {
+        _server.destroy();
+    }
+
+    if (!_server) {
+        _server.create(port);
+        _port = port;
+        _server->on("/metrics", HTTP_GET, [this]() { handleMetrics(); });
+        _server->on("/status.json", HTTP_GET, [this]() { handleStatusJSON(); });
+        _server->onNotFound([this]() { handleNotFound(); });
+    }
+
+    _server->begin();
+    _active = true;
+    return true;
+}
+
+void StatusServer::stop() {
+    if (_active) {
+        _active = false;
+        if (_server) {
+            _server->stop();
+        }
+    }
+}
+
+void StatusServer::handle() {
+    if (_active && _server) {
+        _server->handleClient();
+    }
+}
+
+void StatusServer::printMetricHeader(ChunkedResponse& out, const char* name,
+                                     const char* type, const char* help) {
+    out.printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void StatusServer::handleMetrics() {
+    _requests++;
+    _manager->getConnectTiming(_timing);
+    ReconnectStats reconnect = _manager->getReconnectStats();
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    bool connected = wifi.status() == WL_CONNECTED;
+
+    ChunkedResponse out(*_server, 200, "text/plain; version=0.0.4");
+
+    printMetricHeader(out, "picowifi_uptime_seconds", "counter", "Time since PicoWiFiManager::begin()");
+    out.printf("picowifi_uptime_seconds %lu\n", (unsigned long)(_manager->getUptime() / 1000));
+    printMetricHeader(out, "picowifi_free_heap_bytes", "gauge", "Free heap");
+    out.printf("picowifi_free_heap_bytes %lu\n", (unsigned long)_manager->getFreeHeap());
+    printMetricHeader(out, "picowifi_heap_min_free_bytes", "gauge", "Lowest free heap sampled since boot");
+    out.printf("picowifi_heap_min_free_bytes %lu\n", (unsigned long)_manager->getMinFreeHeap());
+    printMetricHeader(out, "picowifi_heap_peak_used_bytes", "gauge", "Highest used heap sampled since boot");
+    out.printf("picowifi_heap_peak_used_bytes %lu\n", (unsigned long)_manager->getPeakHeapUsed());
+#if PICOWIFI_ENABLE_DIAGNOSTICS
+    printMetricHeader(out, "picowifi_heap_scope_peak_bytes", "gauge", "Largest heap growth inside one subsystem call");
+    for (uint8_t i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++) {
+        MemorySubsystem subsystem = (MemorySubsystem)i;
+        out.printf("picowifi_heap_scope_peak_bytes{subsystem=\"%s\"} %lu\n",
+                   MemoryMonitor::getSubsystemName(subsystem),
+                   (unsigned long)MemoryMonitor::getUsage(subsystem).peak);
+    }
+    printMetricHeader(out, "picowifi_heap_retained_bytes", "gauge", "Heap still held after subsystem calls returned");
+    for (uint8_t i = 0; i < MEMORY_SUBSYSTEM_COUNT; i++) {
+        MemorySubsystem subsystem = (MemorySubsystem)i;
+        out.printf("picowifi_heap_retained_bytes{subsystem=\"%s\"} %ld\n",
+                   MemoryMonitor::getSubsystemName(subsystem),
+                   (long)MemoryMonitor::getUsage(subsystem).retained);
+    }
+#endif
+    size_t stackUsed = _manager->getCore1StackUsed();
+    if (stackUsed > 0) {
+        printMetricHeader(out, "picowifi_core1_stack_used_bytes", "gauge", "Deepest core 1 stack use since boot");
+        out.printf("picowifi_core1_stack_used_bytes %lu\n", (unsigned long)stackUsed);
+        printMetricHeader(out, "picowifi_core1_stack_size_bytes", "gauge", "Core 1 stack size");
+        out.printf("picowifi_core1_stack_size_bytes %lu\n", (unsigned long)PicoWiFiManager::getCore1StackSize());
+    }
+    printMetricHeader(out, "picowifi_wifi_connected", "gauge", "1 while associated with an IP address");
+    out.printf("picowifi_wifi_connected %d\n", connected ? 1 : 0);
+    if (connected) {
+        printMetricHeader(out, "picowifi_wifi_rssi_dbm", "gauge", "Signal strength of the current AP");
+        out.printf("picowifi_wifi_rssi_dbm %ld\n", (long)wifi.RSSI());
+        printMetricHeader(out, "picowifi_wifi_channel", "gauge", "Channel of the current AP");
+        out.printf("picowifi_wifi_channel %d\n", wifi.channel());
+    }
+
+    LinkQuality link = _manager->getLinkQuality();
+    printMetricHeader(out, "picowifi_link_degraded", "gauge", "1 while the smoothed RSSI is below the roaming threshold");
+    out.printf("picowifi_link_degraded %d\n", link.degraded ? 1 : 0);
+    printMetricHeader(out, "picowifi_roam_scans_total", "counter", "Scans started because the link degraded");
+    out.printf("picowifi_roam_scans_total %lu\n", (unsigned long)link.roamScans);
+    printMetricHeader(out, "picowifi_roams_total", "counter", "Moves to a stronger AP of the same SSID");
+    out.printf("picowifi_roams_total %lu\n", (unsigned long)link.roams);
+
+    printMetricHeader(out, "picowifi_link_losses_total", "counter", "Outages seen by the reconnect scheduler");
+    out.printf("picowifi_link_losses_total %lu\n", (unsigned long)reconnect.linkLosses);
+    printMetricHeader(out, "picowifi_reconnect_attempts_total", "counter", "Reconnect attempts");
+    out.printf("picowifi_reconnect_attempts_total %lu\n", (unsigned long)reconnect.attempts);
+    printMetricHeader(out, "picowifi_reconnect_recoveries_total", "counter", "Outages that ended in a reconnect");
+    out.printf("picowifi_reconnect_recoveries_total %lu\n", (unsigned long)reconnect.recoveries);
+    printMetricHeader(out, "picowifi_portal_fallbacks_total", "counter", "Outages that ended in the config portal");
+    out.printf("picowifi_portal_fallbacks_total %lu\n", (unsigned long)reconnect.portalFallbacks);
+    printMetricHeader(out, "picowifi_recovery_milliseconds", "gauge", "Time to recover from outages");
+    out.printf("picowifi_recovery_milliseconds{stat=\"last\"} %lu\n", (unsigned long)reconnect.lastRecoveryTime);
+    out.printf("picowifi_recovery_milliseconds{stat=\"max\"} %lu\n", (unsigned long)reconnect.maxRecoveryTime);
+
+#if PICOWIFI_ENABLE_SCANNER
+    if (_scanner) {
+        const ScanStats& scan = _scanner->getStats();
+        printMetricHeader(out, "picowifi_scans_total", "counter", "Completed network scans");
+        out.printf("picowifi_scans_total %lu\n", (unsigned long)scan.scans);
+        printMetricHeader(out, "picowifi_scan_failures_total", "counter", "Failed or timed out scans");
+        out.printf("picowifi_scan_failures_total %lu\n", (unsigned long)scan.failures);
+        printMetricHeader(out, "picowifi_scan_last_milliseconds", "gauge", "Duration of the last scan");
+        out.printf("picowifi_scan_last_milliseconds %lu\n", (unsigned long)scan.lastDuration);
+        printMetricHeader(out, "picowifi_scan_access_points", "gauge", "Access points seen by the last scan");
+        out.printf("picowifi_scan_access_points %u\n", scan.lastAccessPoints);
+    }
+#endif
+
+    printMetricHeader(out, "picowifi_connects_total", "counter", "Successful connects");
+    out.printf("picowifi_connects_total %lu\n", (unsigned long)_timing.getConnects());
+    printMetricHeader(out, "picowifi_connect_failures_total", "counter", "Failed connects");
+    out.printf("picowifi_connect_failures_total %lu\n", (unsigned long)_timing.getFailures());
+
+    // Quantiles come from the fixed histogram buckets (within 25%)
+    printMetricHeader(out, "picowifi_connect_phase_milliseconds", "summary", "Time spent per connection phase");
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        ConnectPhase phase = (ConnectPhase)i;
+        const LatencyHistogram& histogram = _timing.getHistogram(phase);
+        const char* name = ConnectTiming::getPhaseName(phase);
+        out.printf("picowifi_connect_phase_milliseconds{phase=\"%s\",quantile=\"0.95\"} %lu\n",
+                   name, (unsigned long)histogram.getPercentile(95));
+        out.printf("picowifi_connect_phase_milliseconds_sum{phase=\"%s\"} %llu\n",
+                   name, (unsigned long long)histogram.getSum());
+        out.printf("picowifi_connect_phase_milliseconds_count{phase=\"%s\"} %lu\n",
+                   name, (unsigned long)histogram.getCount());
+    }
+
+    printMetricHeader(out, "picowifi_connect_ready_milliseconds", "summary", "Request-to-connected time per radio power-save mode");
+    // radio="off": the connect powered the radio up first, wake cost included
+    for (uint8_t i = 0; i < POWER_SAVE_MODE_COUNT * 2; i++) {
+        PowerSaveMode powerMode = (PowerSaveMode)(i % POWER_SAVE_MODE_COUNT);
+        bool fromOff = i >= POWER_SAVE_MODE_COUNT;
+        const LatencyHistogram& histogram = _timing.getReadyHistogram(powerMode, fromOff);
+        const char* mode = PowerController::getModeName(powerMode);
+        const char* radio = fromOff ? "off" : "on";
+        if (histogram.getCount() == 0) continue;
+        out.printf("picowifi_connect_ready_milliseconds{mode=\"%s\",radio=\"%s\",quantile=\"0.95\"} %lu\n",
+                   mode, radio, (unsigned long)histogram.getPercentile(95));
+        out.printf("picowifi_connect_ready_milliseconds_sum{mode=\"%s\",radio=\"%s\"} %llu\n",
+                   mode, radio, (unsigned long long)histogram.getSum());
+        out.printf("picowifi_connect_ready_milliseconds_count{mode=\"%s\",radio=\"%s\"} %lu\n",
+                   mode, radio, (unsigned long)histogram.getCount());
+    }
+
+    printMetricHeader(out, "picowifi_connect_phase_last_milliseconds", "gauge", "Phase times of the last connect");
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        out.printf("picowifi_connect_phase_last_milliseconds{phase=\"%s\"} %lu\n",
+                   ConnectTiming::getPhaseName((ConnectPhase)i), (unsigned long)_timing.getLast().phase[i]);
+    }
+
+    out.end();
+}
+
+void StatusServer::handleStatusJSON() {
+    _requests++;
+    _manager->getConnectTiming(_timing);
+    ReconnectStats reconnect = _manager->getReconnectStats();
+    WiFiDriver& wifi = PicoWiFiHAL::wifi();
+    bool connected = wifi.status() == WL_CONNECTED;
+
+    ChunkedResponse out(*_server, 200, "application/json");
+
+    out.printf("{\"uptime\":%lu,\"freeHeap\":%lu,\"connected\":%s",
+               (unsigned long)_manager->getUptime(), (unsigned long)_manager->getFreeHeap(),
+               connected ? "true" : "false");
+
+    if (connected) {
+        IPAddress ip = wifi.localIP();
+        out.print(",\"ssid\":");
+        out.printJSONString(wifi.SSID());
+        out.printf(",\"ip\":\"%u.%u.%u.%u\",\"rssi\":%ld,\"channel\":%d",
+                   ip[0], ip[1], ip[2], ip[3], (long)wifi.RSSI(), wifi.channel());
+    }
+
+    LinkQuality link = _manager->getLinkQuality();
+    out.printf(",\"link\":{\"rssi\":%d,\"degraded\":%s,\"roamScans\":%lu,\"roams\":%lu}",
+               link.rssi, link.degraded ? "true" : "false",
+               (unsigned long)link.roamScans, (unsigned long)link.roams);
+
+    out.printf(",\"reconnect\":{\"linkLosses\":%lu,\"attempts\":%lu,\"recoveries\":%lu,"
+               "\"portalFallbacks\":%lu,\"lastRecovery\":%lu,\"maxRecovery\":%lu}",
+               (unsigned long)reconnect.linkLosses, (unsigned long)reconnect.attempts,
+               (unsigned long)reconnect.recoveries, (unsigned long)reconnect.portalFallbacks,
+               (unsigned long)reconnect.lastRecoveryTime, (unsigned long)reconnect.maxRecoveryTime);
+
+#if PICOWIFI_ENABLE_SCANNER
+    if (_scanner) {
+        const ScanStats& scan = _scanner->getStats();
+        out.printf(",\"scan\":{\"scans\":%lu,\"failures\":%lu,\"lastDuration\":%lu,\"accessPoints\":%u}",
+                   (unsigned long)scan.scans, (unsigned long)scan.failures,
+                   (unsigned long)scan.lastDuration, scan.lastAccessPoints);
+    }
+#endif
+
+    const ConnectTimeline& last = _timing.getLast();
+    out.printf(",\"connect\":{\"successes\":%lu,\"failures\":%lu,\"lastFast\":%s,\"phases\":{",
+               (unsigned long)_timing.getConnects(), (unsigned long)_timing.getFailures(),
+               last.fast ? "true" : "false");
+    for (uint8_t i = 0; i < CONNECT_PHASE_COUNT; i++) {
+        ConnectPhase phase = (ConnectPhase)i;
+        const LatencyHistogram& histogram = _timing.getHistogram(phase);
+        out.printf("%s\"%s\":{\"last\":%lu,\"min\":%lu,\"avg\":%lu,\"p95\":%lu,\"max\":%lu,\"count\":%lu}",
+                   i > 0 ? "," : "", ConnectTiming::getPhaseName(phase), (unsigned long)last.phase[i],
+                   (unsigned long)histogram.getMin(), (unsigned long)histogram.getAverage(),
+                   (unsigned long)histogram.getPercentile(95), (unsigned long)histogram.getMax(),
+                   (unsigned long)histogram.getCount());
+    }
+    out.printf("},\"powerMode\":\"%s\"}}", PowerController::getModeName(last.powerMode));
+
+    out.end();
+}
+
+void StatusServer::handleNotFound() {
+    _server->send(404, "text/plain", "Not found");
+}
+
+#endif // PICOWIFI_ENABLE_STATUS_SERVER
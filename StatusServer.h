@@ -0,0 +1,56 @@
+/**
+ * StatusServer - Monitoring endpoints for PicoWiFiManager in STA mode
+ *
+ * Serves /metrics (Prometheus text format) and /status.json while the
+ * device is connected to a network. Responses are streamed through
+ * ChunkedResponse's fixed buffer and the connect timing is copied into a
+ * member, so a scrape every few seconds allocates nothing per request.
+ */
+
+#ifndef STATUS_SERVER_H
+#define STATUS_SERVER_H
+
+#include <Arduino.h>
+#include <WebServer.h>
+#include "ComponentSlot.h"
+#include "ConnectTiming.h"
+
+// Forward declarations
+class PicoWiFiManager;
+class NetworkScanner;
+class ChunkedResponse;
+
+class StatusServer {
+public:
+    explicit StatusServer(PicoWiFiManager* manager);
+    ~StatusServer();
+
+    // Lifecycle; the portal owns port 80 while it runs, so the manager
+    // stops this server whenever the portal starts
+    bool start(uint16_t port);
+    void stop();
+    void handle();
+
+    bool isActive() const { return _active; }
+    uint32_t getRequestCount() const { return _requests; }
+
+    void setScanner(NetworkScanner* scanner) { _scanner = scanner; }
+
+private:
+    PicoWiFiManager* _manager;
+    ComponentSlot<WebServer> _server;
+    NetworkScanner* _scanner;
+    bool _active;
+    uint16_t _port;
+    uint32_t _requests;
+    ConnectTiming _timing;  // Scratch copy, kept off the handler's stack
+
+    void handleMetrics();
+    void handleStatusJSON();
+    void handleNotFound();
+
+    static void printMetricHeader(ChunkedResponse& out, const char* name,
+                                  const char* type, const char* help);
+};
+
+#endif // STATUS_SERVER_H
@@ -0,0 +1,90 @@
+/**
+ * StorageLegacy - Frozen layouts of earlier StorageData versions
+ *
+ * StorageManager::begin() recognises these by their version byte and
+ * upgrades them in place. To change StorageData: copy the current layout
+ * here as the next StorageDataVn, bump STORAGE_VERSION and add a matching
+ * migration in StorageManager. Never edit a layout once released.
+ */
+
+#ifndef STORAGE_LEGACY_H
+#define STORAGE_LEGACY_H
+
+#include <Arduino.h>
+
+// Shared by versions 1-3
+struct NetworkConfigV1 {
+    bool useStaticIP;
+    uint32_t staticIP;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t primaryDNS;
+    uint32_t secondaryDNS;
+};
+
+struct DeviceConfigV1 {
+    char hostname[32];
+    bool autoReconnect;
+    uint8_t maxReconnectAttempts;
+    uint16_t connectTimeout;
+};
+
+struct FastConnectCacheV1 {
+    uint8_t valid;
+    uint8_t channel;
+    uint8_t bssid[6];
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+};
+
+// Version 1: a single network; later firmware kept a FastConnectCacheV1 at
+// the start of reserved (zero when absent)
+struct WiFiCredentialsV1 {
+    char ssid[32];
+    char password[64];
+    bool valid;
+};
+
+struct StorageDataV1 {
+    uint32_t magic;
+    uint8_t version;
+    uint32_t checksum;        // XOR fold, see below
+    WiFiCredentialsV1 wifi;
+    NetworkConfigV1 network;
+    DeviceConfigV1 device;
+    uint8_t reserved[64];
+};
+
+// Version 2: several credential slots, still with the XOR checksum
+struct WiFiCredentialsV2 {
+    char ssid[32];
+    char password[64];
+    bool valid;
+    uint8_t priority;
+    uint32_t lastSuccess;
+    FastConnectCacheV1 fastConnect;
+};
+
+struct StorageDataV2 {
+    uint32_t magic;
+    uint8_t version;
+    uint32_t checksum;
+    uint32_t successCounter;
+    WiFiCredentialsV2 networks[4];
+    NetworkConfigV1 network;
+    DeviceConfigV1 device;
+    uint8_t reserved[64];
+};
+
+// The layouts must not drift with compiler or header changes
+static_assert(sizeof(StorageDataV1) == 236, "StorageDataV1 layout changed");
+static_assert(sizeof(StorageDataV2) == 652, "StorageDataV2 layout changed");
+
+// Versions 1 and 2 XOR-folded the structure, checksum field included, into
+// one byte. Since the field held the previous value while it was computed,
+// a stored image generally can't be verified; migration checks the fields
+// themselves instead.
+
+#endif // STORAGE_LEGACY_H
@@ -3,76 +3,212 @@
  */
 
 #include "StorageManager.h"
+#include "PicoWiFiFeatures.h"
+#include "PicoWiFiHAL.h"
+#include "PicoWiFiLog.h"
+#include "MemoryMonitor.h"
+
+#define PICOWIFI_LOG_TAG LogTag::STORAGE
+
 
 StorageManager::StorageManager() 
     : _initialized(false)
-    , _eepromSize(512) {
+    , _eepromSize(STORAGE_EEPROM_SIZE)
+    , _backend(StorageBackend::EEPROM_EMULATION)
+    , _bankBase(0)
+    , _activeBank(1)
+    , _generation(0)
+    , _migratedFrom(0) {
 }
 
 StorageManager::~StorageManager() {
 }
 
-bool StorageManager::begin(size_t eepromSize) {
+bool StorageManager::begin(size_t eepromSize, StorageBackend backend) {
+    HeapScope scope(MemorySubsystem::STORAGE);
+    
     _eepromSize = eepromSize;
+    _backend = backend;
+    
+    bool ready = true;
+    if (_backend == StorageBackend::AUTO) {
+        // Power-fail atomic banks unless the sectors hold something else,
+        // such as a LittleFS image
+        bool free = beginDualBank() && areBankSectorsFree();
+        _backend = free ? StorageBackend::DUAL_BANK : StorageBackend::EEPROM_EMULATION;
+        if (!free) {
+            PICOWIFI_LOGI("No free filesystem sectors for banks, using EEPROM emulation");
+        }
+    } else if (_backend == StorageBackend::DUAL_BANK) {
+        ready = beginDualBank();
+    } else if (_backend == StorageBackend::FLASH_LOG) {
+        ready = beginFlashLog();
+    }
     
-    EEPROM.begin(_eepromSize);
+    if (!ready) {
+        PICOWIFI_LOGW("No room in the filesystem region, using EEPROM emulation");
+        _backend = StorageBackend::EEPROM_EMULATION;
+    }
     
-    if (!loadFromEEPROM()) {
-        Serial.println("No valid storage data found, initializing defaults");
-        initializeDefaults();
-        saveToEEPROM();
+    if (_backend == StorageBackend::EEPROM_EMULATION) {
+        PicoWiFiHAL::eeprom().begin(_eepromSize);
+    }
+    
+    if (!load() && !attemptRecovery()) {
+        // A flash backend's first boot picks up what EEPROM emulation stored
+        if (_backend != StorageBackend::EEPROM_EMULATION && importFromEEPROM()) {
+            commit();
+        } else {
+            PICOWIFI_LOGW("No valid storage data found, initializing defaults");
+            initializeDefaults();
+            commit();
+        }
+    }
+    
+    // Store an upgraded layout right away so the migration runs only once
+    if (_migratedFrom != 0) {
+        commit();
     }
     
     _initialized = true;
-    Serial.println("StorageManager initialized");
+    PICOWIFI_LOGI("StorageManager initialized");
     return true;
 }
 
 void StorageManager::format() {
+    if (_backend == StorageBackend::FLASH_LOG) {
+        _log.format();
+    }
     initializeDefaults();
-    saveToEEPROM();
-    Serial.println("Storage formatted");
+    commit();
+    PICOWIFI_LOGI("Storage formatted");
 }
 
-bool StorageManager::saveWiFiCredentials(const char* ssid, const char* password) {
+bool StorageManager::saveWiFiCredentials(const char* ssid, const char* password, uint8_t priority) {
     if (!_initialized || !ssid) return false;
     
-    strncpy(_data.wifi.ssid, ssid, sizeof(_data.wifi.ssid) - 1);
-    _data.wifi.ssid[sizeof(_data.wifi.ssid) - 1] = '\0';
+    int slot = findSlot(ssid);
+    if (slot < 0) {
+        slot = findSlotToReplace();
+        
+        // A new network starts without history or a cached AP
+        _data.networks[slot].clear();
+        strncpy(_data.networks[slot].ssid, ssid, sizeof(_data.networks[slot].ssid) - 1);
+    }
+    
+    WiFiCredentials& entry = _data.networks[slot];
     
     if (password) {
-        strncpy(_data.wifi.password, password, sizeof(_data.wifi.password) - 1);
-        _data.wifi.password[sizeof(_data.wifi.password) - 1] = '\0';
+        strncpy(entry.password, password, sizeof(entry.password) - 1);
+        entry.password[sizeof(entry.password) - 1] = '\0';
     } else {
-        memset(_data.wifi.password, 0, sizeof(_data.wifi.password));
+        memset(entry.password, 0, sizeof(entry.password));
     }
     
-    _data.wifi.valid = true;
+    entry.priority = priority;
+    entry.valid = true;
     
-    return saveToEEPROM();
+    return commit();
 }
 
 bool StorageManager::loadWiFiCredentials(WiFiCredentials& credentials) {
     if (!_initialized) return false;
     
-    credentials = _data.wifi;
-    return credentials.valid;
+    int slot = findPreferredSlot();
+    if (slot < 0) {
+        credentials.clear();
+        return false;
+    }
+    
+    credentials = _data.networks[slot];
+    return true;
+}
+
+bool StorageManager::loadWiFiCredentials(const char* ssid, WiFiCredentials& credentials) {
+    if (!_initialized) return false;
+    
+    int slot = findSlot(ssid);
+    if (slot < 0) return false;
+    
+    credentials = _data.networks[slot];
+    return true;
+}
+
+bool StorageManager::removeWiFiCredentials(const char* ssid) {
+    if (!_initialized) return false;
+    
+    int slot = findSlot(ssid);
+    if (slot < 0) return false;
+    
+    _data.networks[slot].clear();
+    return commit();
 }
 
 bool StorageManager::hasWiFiCredentials() {
-    return _initialized && _data.wifi.valid;
+    return _initialized && findPreferredSlot() >= 0;
 }
 
 void StorageManager::clearWiFiCredentials() {
-    _data.wifi.clear();
-    saveToEEPROM();
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        _data.networks[i].clear();
+    }
+    _data.successCounter = 0;
+    commit();
+}
+
+uint8_t StorageManager::getNetworkCount() {
+    if (!_initialized) return 0;
+    
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        if (_data.networks[i].valid) count++;
+    }
+    return count;
+}
+
+bool StorageManager::getNetwork(uint8_t index, WiFiCredentials& credentials) {
+    if (!_initialized) return false;
+    
+    // index counts saved networks only, skipping empty slots
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        if (!_data.networks[i].valid) continue;
+        
+        if (index-- == 0) {
+            credentials = _data.networks[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StorageManager::markConnected(const char* ssid, const FastConnectCache* cache) {
+    if (!_initialized) return false;
+    
+    int slot = findSlot(ssid);
+    if (slot < 0) return false;
+    
+    WiFiCredentials& entry = _data.networks[slot];
+    bool changed = false;
+    
+    // Reconnecting to the most recent network changes nothing worth a commit
+    if (entry.lastSuccess == 0 || entry.lastSuccess != _data.successCounter) {
+        entry.lastSuccess = ++_data.successCounter;
+        changed = true;
+    }
+    
+    if (cache && memcmp(&entry.fastConnect, cache, sizeof(*cache)) != 0) {
+        entry.fastConnect = *cache;
+        changed = true;
+    }
+    
+    return changed ? commit() : true;
 }
 
 bool StorageManager::saveNetworkConfig(const NetworkConfig& config) {
     if (!_initialized) return false;
     
     _data.network = config;
-    return saveToEEPROM();
+    return commit();
 }
 
 bool StorageManager::loadNetworkConfig(NetworkConfig& config) {
@@ -84,14 +220,14 @@ bool StorageManager::loadNetworkConfig(NetworkConfig& config) {
 
 void StorageManager::clearNetworkConfig() {
     _data.network = NetworkConfig();
-    saveToEEPROM();
+    commit();
 }
 
 bool StorageManager::saveDeviceConfig(const DeviceConfig& config) {
     if (!_initialized) return false;
     
     _data.device = config;
-    return saveToEEPROM();
+    return commit();
 }
 
 bool StorageManager::loadDeviceConfig(DeviceConfig& config) {
@@ -103,7 +239,31 @@ bool StorageManager::loadDeviceConfig(DeviceConfig& config) {
 
 void StorageManager::clearDeviceConfig() {
     _data.device = DeviceConfig();
-    saveToEEPROM();
+    commit();
+}
+
+bool StorageManager::loadFastConnect(const char* ssid, FastConnectCache& cache) {
+    if (!_initialized) return false;
+    
+    int slot = findSlot(ssid);
+    if (slot < 0) return false;
+    
+    cache = _data.networks[slot].fastConnect;
+    return cache.valid != 0;
+}
+
+void StorageManager::clearFastConnect() {
+    bool changed = false;
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        if (_data.networks[i].fastConnect.valid) {
+            _data.networks[i].fastConnect = FastConnectCache();
+            changed = true;
+        }
+    }
+    
+    if (changed) {
+        commit();
+    }
 }
 
 bool StorageManager::saveAll(const WiFiCredentials& wifi, 
@@ -111,11 +271,15 @@ bool StorageManager::saveAll(const WiFiCredentials& wifi,
                            const DeviceConfig& device) {
     if (!_initialized) return false;
     
-    _data.wifi = wifi;
+    if (wifi.valid) {
+        int slot = findSlot(wifi.ssid);
+        if (slot < 0) slot = findSlotToReplace();
+        _data.networks[slot] = wifi;
+    }
     _data.network = network;
     _data.device = device;
     
-    return saveToEEPROM();
+    return commit();
 }
 
 bool StorageManager::loadAll(WiFiCredentials& wifi, 
@@ -123,7 +287,7 @@ bool StorageManager::loadAll(WiFiCredentials& wifi,
                            DeviceConfig& device) {
     if (!_initialized) return false;
     
-    wifi = _data.wifi;
+    loadWiFiCredentials(wifi);
     network = _data.network;
     device = _data.device;
     
@@ -131,10 +295,13 @@ bool StorageManager::loadAll(WiFiCredentials& wifi,
 }
 
 void StorageManager::clearAll() {
-    _data.wifi.clear();
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        _data.networks[i].clear();
+    }
+    _data.successCounter = 0;
     _data.network = NetworkConfig();
     _data.device = DeviceConfig();
-    saveToEEPROM();
+    commit();
 }
 
 bool StorageManager::isValid() {
@@ -153,28 +320,78 @@ size_t StorageManager::getUsedSpace() {
     return sizeof(StorageData);
 }
 
+uint32_t StorageManager::measureValidationTime(uint8_t iterations) {
+    if (iterations == 0) return 0;
+    
+    // Same work begin() does per load: checksum plus field checks
+    volatile bool valid = true;
+    uint32_t start = micros();
+    for (uint8_t i = 0; i < iterations; i++) {
+        valid = validateData(_data) && valid;
+    }
+    (void)valid;
+    
+    return (micros() - start) / iterations;
+}
+
 size_t StorageManager::getTotalSpace() {
-    return _eepromSize;
+    switch (_backend) {
+        case StorageBackend::DUAL_BANK: return DUAL_BANK_SECTORS * FLASH_SECTOR_SIZE;
+        case StorageBackend::FLASH_LOG: return _log.getSize();
+        default: return _eepromSize;
+    }
 }
 
 void StorageManager::printDiagnostics() {
+#if PICOWIFI_ENABLE_DIAGNOSTICS
     Serial.println("=== Storage Manager Diagnostics ===");
     Serial.printf("Initialized: %s\n", _initialized ? "Yes" : "No");
-    Serial.printf("EEPROM Size: %zu bytes\n", _eepromSize);
+    if (_backend == StorageBackend::FLASH_LOG) {
+        Serial.printf("Backend: Flash log (%zu bytes)\n", _log.getSize());
+        Serial.printf("Log: sector %d, %d pages free, seq %lu, %lu erases\n",
+                      _log.getActiveSector(), _log.getFreePages(),
+                      (unsigned long)_log.getSequence(), (unsigned long)_log.getEraseCount());
+    } else if (_backend == StorageBackend::DUAL_BANK) {
+        uint32_t generation;
+        Serial.printf("Backend: Dual bank (%zu bytes)\n", getTotalSpace());
+        Serial.printf("Banks: active %c, generation %lu, backup %s\n", 'A' + _activeBank,
+                      (unsigned long)_generation, readBank(_activeBank ^ 1, generation) ? "valid" : "none");
+    } else {
+        Serial.printf("Backend: EEPROM emulation (%zu bytes, backup %s)\n", _eepromSize,
+                      getBackupAddress() >= 0 ? "enabled" : "disabled");
+    }
     Serial.printf("Used Space: %zu bytes\n", getUsedSpace());
     Serial.printf("Valid: %s\n", isValid() ? "Yes" : "No");
     Serial.printf("Magic: 0x%08X\n", _data.magic);
-    Serial.printf("Version: %d\n", _data.version);
-    Serial.printf("Checksum: 0x%08X\n", _data.checksum);
-    
-    if (_data.wifi.valid) {
-        Serial.printf("WiFi SSID: %s\n", _data.wifi.ssid);
-        Serial.println("WiFi Password: [Set]");
+    if (_migratedFrom != 0) {
+        Serial.printf("Version: %d (migrated from %d)\n", _data.version, _migratedFrom);
     } else {
+        Serial.printf("Version: %d\n", _data.version);
+    }
+    Serial.printf("Checksum: 0x%08X (CRC32, %lu us per validation)\n", _data.checksum,
+                  (unsigned long)measureValidationTime());
+    
+    if (getNetworkCount() == 0) {
         Serial.println("WiFi: Not configured");
     }
     
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        const WiFiCredentials& entry = _data.networks[i];
+        if (!entry.valid) continue;
+        
+        Serial.printf("WiFi Slot %d: %s (priority %d, last success #%lu)\n", i, entry.ssid,
+                      entry.priority, (unsigned long)entry.lastSuccess);
+        
+        if (entry.fastConnect.valid) {
+            const uint8_t* b = entry.fastConnect.bssid;
+            Serial.printf("  Fast Connect: %02X:%02X:%02X:%02X:%02X:%02X ch %d%s\n",
+                          b[0], b[1], b[2], b[3], b[4], b[5], entry.fastConnect.channel,
+                          entry.fastConnect.ip ? " (lease cached)" : "");
+        }
+    }
+    
     Serial.println("====================================");
+#endif
 }
 
 bool StorageManager::performIntegrityCheck() {
@@ -187,39 +404,382 @@ bool StorageManager::repairIfNeeded() {
     if (!_initialized) return false;
     
     if (!validateData(_data)) {
-        Serial.println("Storage corrupted, attempting repair...");
+        PICOWIFI_LOGE("Storage corrupted, attempting repair...");
+        if (attemptRecovery()) {
+            return true;
+        }
+        
         initializeDefaults();
-        return saveToEEPROM();
+        return commit();
     }
     
     return true;
 }
 
 // Private methods
+bool StorageManager::load() {
+    switch (_backend) {
+        case StorageBackend::DUAL_BANK: return loadFromBanks();
+        case StorageBackend::FLASH_LOG: return loadFromLog();
+        default: return loadFromEEPROM();
+    }
+}
+
+bool StorageManager::commit() {
+    HeapScope scope(MemorySubsystem::STORAGE);
+    
+    _data.checksum = calculateChecksum(_data);
+    
+    switch (_backend) {
+        case StorageBackend::DUAL_BANK: return saveToBank();
+        case StorageBackend::FLASH_LOG: return saveToLog();
+        default: return saveToEEPROM();
+    }
+}
+
 bool StorageManager::loadFromEEPROM() {
-    EEPROM.get(EEPROM_START_ADDRESS, _data);
-    return validateData(_data);
+    const uint8_t* image = PicoWiFiHAL::eeprom().getData() + EEPROM_START_ADDRESS;
+    memcpy(&_data, image, sizeof(_data));
+    if (validateData(_data)) {
+        return true;
+    }
+    
+    return migrate(image, _eepromSize - EEPROM_START_ADDRESS);
+}
+
+bool StorageManager::migrate(const uint8_t* image, size_t length) {
+    // magic and version sit at the same offsets in every layout
+    uint32_t magic;
+    memcpy(&magic, image, sizeof(magic));
+    uint8_t version = image[offsetof(StorageDataV1, version)];
+    
+    // Anything newer is left alone for the firmware that wrote it
+    if (magic != STORAGE_MAGIC || version == 0 || version >= STORAGE_VERSION) {
+        return false;
+    }
+    
+    StorageDataV2 v2;
+    switch (version) {
+        case 1:
+            if (length < sizeof(StorageDataV1)) return false;
+            migrateV1ToV2(*(const StorageDataV1*)image, v2);
+            break;
+            
+        case 2:
+            if (length < sizeof(StorageDataV2)) return false;
+            memcpy(&v2, image, sizeof(v2));
+            break;
+            
+        default:
+            return false;
+    }
+    
+    StorageData data;
+    migrateV2ToCurrent(v2, data);
+    
+    data.checksum = calculateChecksum(data);
+    if (!validateData(data)) {
+        PICOWIFI_LOGW("Storage version %d data failed validation, not migrated", version);
+        return false;
+    }
+    
+    _data = data;
+    _migratedFrom = version;
+    PICOWIFI_LOGI("Migrated storage from version %d to %d", version, STORAGE_VERSION);
+    return true;
+}
+
+void StorageManager::migrateV1ToV2(const StorageDataV1& legacy, StorageDataV2& upgraded) {
+    memset(&upgraded, 0, sizeof(upgraded));
+    upgraded.magic = legacy.magic;
+    upgraded.version = 2;
+    
+    // The single network becomes the first slot, along with the fast-connect
+    // cache later version 1 firmware kept in reserved
+    if (legacy.wifi.valid) {
+        WiFiCredentialsV2& slot = upgraded.networks[0];
+        memcpy(slot.ssid, legacy.wifi.ssid, sizeof(slot.ssid));
+        memcpy(slot.password, legacy.wifi.password, sizeof(slot.password));
+        memcpy(&slot.fastConnect, legacy.reserved, sizeof(slot.fastConnect));
+        slot.valid = true;
+    }
+    
+    upgraded.network = legacy.network;
+    upgraded.device = legacy.device;
+}
+
+void StorageManager::migrateV2ToCurrent(const StorageDataV2& legacy, StorageData& upgraded) {
+    static_assert(sizeof(FastConnectCacheV1) == sizeof(FastConnectCache), "FastConnectCache layout changed");
+    
+    upgraded = StorageData();
+    upgraded.successCounter = legacy.successCounter;
+    
+    const uint8_t slots = MAX_SAVED_NETWORKS < 4 ? MAX_SAVED_NETWORKS : 4;
+    for (uint8_t i = 0; i < slots; i++) {
+        const WiFiCredentialsV2& from = legacy.networks[i];
+        if (!from.valid) continue;
+        
+        // Old strings are not trusted to be terminated
+        WiFiCredentials& to = upgraded.networks[i];
+        memcpy(to.ssid, from.ssid, sizeof(to.ssid));
+        to.ssid[sizeof(to.ssid) - 1] = '\0';
+        memcpy(to.password, from.password, sizeof(to.password));
+        to.password[sizeof(to.password) - 1] = '\0';
+        to.valid = true;
+        to.priority = from.priority;
+        to.lastSuccess = from.lastSuccess;
+        memcpy(&to.fastConnect, &from.fastConnect, sizeof(to.fastConnect));
+    }
+    
+    upgraded.network.useStaticIP = legacy.network.useStaticIP;
+    upgraded.network.staticIP = legacy.network.staticIP;
+    upgraded.network.gateway = legacy.network.gateway;
+    upgraded.network.subnet = legacy.network.subnet;
+    upgraded.network.primaryDNS = legacy.network.primaryDNS;
+    upgraded.network.secondaryDNS = legacy.network.secondaryDNS;
+    
+    memcpy(upgraded.device.hostname, legacy.device.hostname, sizeof(upgraded.device.hostname));
+    upgraded.device.hostname[sizeof(upgraded.device.hostname) - 1] = '\0';
+    upgraded.device.autoReconnect = legacy.device.autoReconnect;
+    upgraded.device.maxReconnectAttempts = legacy.device.maxReconnectAttempts;
+    upgraded.device.connectTimeout = legacy.device.connectTimeout;
 }
 
 bool StorageManager::saveToEEPROM() {
-    _data.checksum = calculateChecksum(_data);
-    EEPROM.put(EEPROM_START_ADDRESS, _data);
-    EEPROM.commit();
+    // A commit erases and reprograms the whole sector; skip it if nothing changed
+    EEPROMDriver& eeprom = PicoWiFiHAL::eeprom();
+    uint8_t* image = eeprom.getData();
+    if (memcmp(image + EEPROM_START_ADDRESS, &_data, sizeof(_data)) == 0) {
+        return true;
+    }
+    
+    // Keep the outgoing state as the backup. Both copies share one sector
+    // and one commit, so this only covers data that is intact in flash but
+    // fails validation; a torn commit can take out both
+    int backupAddress = getBackupAddress();
+    if (backupAddress >= 0) {
+        const StorageData* previous = (const StorageData*)(image + EEPROM_START_ADDRESS);
+        if (validateData(*previous)) {
+            memcpy(image + backupAddress, previous, sizeof(StorageData));
+        }
+    }
+    
+    memcpy(image + EEPROM_START_ADDRESS, &_data, sizeof(_data));
+    return eeprom.commit();
+}
+
+int StorageManager::getBackupAddress() const {
+    int address = EEPROM_START_ADDRESS + sizeof(StorageData);
+    return address + sizeof(StorageData) <= _eepromSize ? address : -1;
+}
+
+bool StorageManager::importFromEEPROM() {
+    PicoWiFiHAL::eeprom().begin(_eepromSize);
+    bool found = loadFromEEPROM();
+    PicoWiFiHAL::eeprom().end();
+    
+    if (found) {
+        PICOWIFI_LOGI("Imported EEPROM settings");
+    }
+    return found;
+}
+
+uintptr_t StorageManager::bankAddress(uint8_t bank) const {
+    return _bankBase + (uintptr_t)bank * FLASH_SECTOR_SIZE;
+}
+
+bool StorageManager::beginDualBank() {
+    const size_t size = DUAL_BANK_SECTORS * FLASH_SECTOR_SIZE;
+    uintptr_t end = PicoWiFiHAL::flash().getRegionEnd();
+    
+    if (end - PicoWiFiHAL::flash().getRegionStart() < size) {
+        return false;
+    }
+    _bankBase = end - size;
     return true;
 }
 
-uint32_t StorageManager::calculateChecksum(const StorageData& data) {
-    // Simple XOR checksum for demonstration
-    // In production, use CRC32
-    uint32_t checksum = 0;
-    const uint8_t* ptr = (const uint8_t*)&data;
-    size_t size = sizeof(StorageData) - sizeof(data.checksum);
+bool StorageManager::areBankSectorsFree() const {
+    // Ours if either bank carries the magic (the other may have been torn
+    // mid-save); otherwise only if nothing was ever written there
+    for (uint8_t bank = 0; bank < DUAL_BANK_SECTORS; bank++) {
+        if (((const BankHeader*)bankAddress(bank))->magic == BANK_MAGIC) {
+            return true;
+        }
+    }
+    
+    const uint32_t* words = (const uint32_t*)bankAddress(0);
+    for (size_t i = 0; i < DUAL_BANK_SECTORS * FLASH_SECTOR_SIZE / sizeof(uint32_t); i++) {
+        if (words[i] != 0xFFFFFFFF) return false;
+    }
+    return true;
+}
+
+const StorageData* StorageManager::readBank(uint8_t bank, uint32_t& generation) {
+    // Banks are memory mapped, so they are checked in place without a copy
+    const BankHeader* header = (const BankHeader*)bankAddress(bank);
+    if (header->magic != BANK_MAGIC || header->length != sizeof(StorageData)) {
+        return nullptr;
+    }
+    
+    const uint8_t* image = (const uint8_t*)(header + 1);
+    uint32_t crc = crc32Update(CRC32_INITIAL, (const uint8_t*)&header->generation, sizeof(header->generation));
+    crc = crc32Final(crc32Update(crc, image, header->length));
+    
+    const StorageData* data = (const StorageData*)image;
+    if (crc != header->crc || !validateData(*data)) {
+        return nullptr;
+    }
+    
+    generation = header->generation;
+    return data;
+}
+
+bool StorageManager::loadFromBanks() {
+    // One pass over both banks: the newest intact one wins
+    uint32_t generations[DUAL_BANK_SECTORS] = {};
+    const StorageData* banks[DUAL_BANK_SECTORS];
+    int newest = -1;
     
-    for (size_t i = 0; i < size; i++) {
-        checksum ^= ptr[i];
+    for (uint8_t bank = 0; bank < DUAL_BANK_SECTORS; bank++) {
+        banks[bank] = readBank(bank, generations[bank]);
+        if (banks[bank] &&
+            (newest < 0 || (int32_t)(generations[bank] - generations[newest]) > 0)) {
+            newest = bank;
+        }
+    }
+    
+    if (newest < 0) {
+        return false;
     }
     
-    return checksum;
+    _data = *banks[newest];
+    _activeBank = newest;
+    _generation = generations[newest];
+    return true;
+}
+
+bool StorageManager::saveToBank() {
+    uint32_t generation;
+    const StorageData* live = readBank(_activeBank, generation);
+    if (live && memcmp(live, &_data, sizeof(_data)) == 0) {
+        return true;
+    }
+    
+    // The live bank stays untouched, so a power cut keeps the previous state
+    uint8_t target = _activeBank ^ 1;
+    if (!writeBank(target)) {
+        PICOWIFI_LOGE("Bank write failed, previous state kept");
+        return false;
+    }
+    
+    _activeBank = target;
+    return true;
+}
+
+bool StorageManager::writeBank(uint8_t bank) {
+    BankHeader header;
+    header.magic = BANK_MAGIC;
+    header.generation = _generation + 1;
+    header.length = sizeof(StorageData);
+    
+    uint32_t crc = crc32Update(CRC32_INITIAL, (const uint8_t*)&header.generation, sizeof(header.generation));
+    header.crc = crc32Final(crc32Update(crc, (const uint8_t*)&_data, sizeof(_data)));
+    
+    FlashLog::eraseSector(bankAddress(bank));
+    FlashLog::program(bankAddress(bank), (const uint8_t*)&header, sizeof(header),
+                      (const uint8_t*)&_data, sizeof(_data));
+    
+    uint32_t generation;
+    if (!readBank(bank, generation)) {
+        return false;
+    }
+    
+    _generation = generation;
+    return true;
+}
+
+bool StorageManager::beginFlashLog() {
+    const size_t size = FLASH_LOG_SECTORS * FLASH_SECTOR_SIZE;
+    uintptr_t end = PicoWiFiHAL::flash().getRegionEnd();
+    
+    return end - PicoWiFiHAL::flash().getRegionStart() >= size && _log.begin(end - size, FLASH_LOG_SECTORS);
+}
+
+bool StorageManager::loadFromLog() {
+    // The log appeared with version 2, whose sections have the current
+    // layout; only the whole-image checksum changed, and the log never
+    // stored one. Such logs load as they are and are rewritten at begin().
+    static_assert(sizeof(WiFiCredentialsV2) == sizeof(WiFiCredentials) &&
+                  sizeof(NetworkConfigV1) == sizeof(NetworkConfig) &&
+                  sizeof(DeviceConfigV1) == sizeof(DeviceConfig), "Flash log section layout changed");
+    
+    LogHeader header;
+    if (!_log.read(LOG_KEY_HEADER, &header, sizeof(header)) || header.magic != STORAGE_MAGIC ||
+        (header.version != STORAGE_VERSION && header.version != 2)) {
+        return false;
+    }
+    
+    // Sections missing from the log keep their defaults
+    StorageData data;
+    data.successCounter = header.successCounter;
+    _log.read(LOG_KEY_NETWORK_CONFIG, &data.network, sizeof(data.network));
+    _log.read(LOG_KEY_DEVICE_CONFIG, &data.device, sizeof(data.device));
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        _log.read(LOG_KEY_WIFI_SLOT + i, &data.networks[i], sizeof(data.networks[i]));
+    }
+    
+    if (header.version != STORAGE_VERSION) {
+        // Old strings are not trusted to be terminated
+        for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+            data.networks[i].ssid[sizeof(data.networks[i].ssid) - 1] = '\0';
+            data.networks[i].password[sizeof(data.networks[i].password) - 1] = '\0';
+        }
+        data.device.hostname[sizeof(data.device.hostname) - 1] = '\0';
+    }
+    
+    data.checksum = calculateChecksum(data);
+    if (!validateData(data)) {
+        return false;
+    }
+    
+    _data = data;
+    if (header.version != STORAGE_VERSION) {
+        _migratedFrom = (uint8_t)header.version;
+        PICOWIFI_LOGI("Migrated flash log from version %d to %d", _migratedFrom, STORAGE_VERSION);
+    }
+    return true;
+}
+
+bool StorageManager::saveToLog() {
+    LogHeader header;
+    header.magic = STORAGE_MAGIC;
+    header.version = STORAGE_VERSION;
+    header.successCounter = _data.successCounter;
+    
+    // append() skips sections whose newest record is already identical
+    bool ok = _log.append(LOG_KEY_HEADER, &header, sizeof(header));
+    ok = _log.append(LOG_KEY_NETWORK_CONFIG, &_data.network, sizeof(_data.network)) && ok;
+    ok = _log.append(LOG_KEY_DEVICE_CONFIG, &_data.device, sizeof(_data.device)) && ok;
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        ok = _log.append(LOG_KEY_WIFI_SLOT + i, &_data.networks[i], sizeof(_data.networks[i])) && ok;
+    }
+    
+    if (!ok) {
+        PICOWIFI_LOGE("Flash log write failed");
+    }
+    return ok;
+}
+
+uint32_t StorageManager::calculateChecksum(const StorageData& data) {
+    // CRC32 over the whole structure except the checksum field itself
+    const uint8_t* ptr = (const uint8_t*)&data;
+    const size_t offset = offsetof(StorageData, checksum);
+    const size_t tail = offset + sizeof(data.checksum);
+    
+    uint32_t crc = crc32Update(CRC32_INITIAL, ptr, offset);
+    crc = crc32Update(crc, ptr + tail, sizeof(StorageData) - tail);
+    return crc32Final(crc);
 }
 
 bool StorageManager::validateData(const StorageData& data) {
@@ -240,8 +800,8 @@ bool StorageManager::validateData(const StorageData& data) {
     }
     
     // Validate WiFi credentials if marked as valid
-    if (data.wifi.valid) {
-        if (!isValidSSID(data.wifi.ssid)) {
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        if (data.networks[i].valid && !isValidSSID(data.networks[i].ssid)) {
             return false;
         }
     }
@@ -281,6 +841,121 @@ bool StorageManager::isValidPassword(const char* password) {
     return true;
 }
 
+bool StorageManager::attemptRecovery() {
+    PICOWIFI_LOGW("Attempting recovery from backup...");
+    
+    if (!restoreFromBackup()) {
+        PICOWIFI_LOGE("No usable backup");
+        return false;
+    }
+    
+    PICOWIFI_LOGI("Storage recovered from backup");
+    return true;
+}
+
+bool StorageManager::createBackup() {
+    switch (_backend) {
+        case StorageBackend::DUAL_BANK: {
+            // Normally the other bank already holds the previous generation;
+            // make sure it holds something valid at all
+            uint32_t generation;
+            if (readBank(_activeBank ^ 1, generation)) {
+                return true;
+            }
+            return writeBank(_activeBank ^ 1);
+        }
+            
+        case StorageBackend::FLASH_LOG:
+            // Every record is checksummed on its own and older versions stay
+            // in the log, so there is no separate copy to take
+            return true;
+            
+        default: {
+            int backupAddress = getBackupAddress();
+            if (backupAddress < 0) return false;
+            
+            memcpy(PicoWiFiHAL::eeprom().getData() + backupAddress, &_data, sizeof(_data));
+            return PicoWiFiHAL::eeprom().commit();
+        }
+    }
+}
+
+bool StorageManager::restoreFromBackup() {
+    switch (_backend) {
+        case StorageBackend::DUAL_BANK: {
+            uint32_t generation;
+            const StorageData* backup = readBank(_activeBank ^ 1, generation);
+            if (!backup) return false;
+            
+            _data = *backup;
+            _activeBank ^= 1;
+            return true;
+        }
+            
+        case StorageBackend::FLASH_LOG:
+            return false;
+            
+        default: {
+            int backupAddress = getBackupAddress();
+            if (backupAddress < 0) return false;
+            
+            StorageData backup;
+            memcpy(&backup, PicoWiFiHAL::eeprom().getData() + backupAddress, sizeof(backup));
+            if (!validateData(backup)) return false;
+            
+            // The broken primary is not worth keeping as the next backup
+            _data = backup;
+            return commit();
+        }
+    }
+}
+
+int StorageManager::findSlot(const char* ssid) {
+    if (!ssid) return -1;
+    
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        if (_data.networks[i].valid &&
+            strncmp(_data.networks[i].ssid, ssid, sizeof(_data.networks[i].ssid)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int StorageManager::findSlotToReplace() {
+    // An empty slot if there is one, otherwise the lowest-priority network
+    // that has gone longest without a successful connect
+    int victim = 0;
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        const WiFiCredentials& entry = _data.networks[i];
+        if (!entry.valid) return i;
+        
+        const WiFiCredentials& worst = _data.networks[victim];
+        if (entry.priority < worst.priority ||
+            (entry.priority == worst.priority && entry.lastSuccess < worst.lastSuccess)) {
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+int StorageManager::findPreferredSlot() {
+    // The network that last worked, then the highest priority
+    int best = -1;
+    for (uint8_t i = 0; i < MAX_SAVED_NETWORKS; i++) {
+        const WiFiCredentials& entry = _data.networks[i];
+        if (!entry.valid) continue;
+        
+        if (best < 0 ||
+            entry.lastSuccess > _data.networks[best].lastSuccess ||
+            (entry.lastSuccess == _data.networks[best].lastSuccess &&
+             entry.priority > _data.networks[best].priority)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
 bool StorageManager::isValidHostname(const char* hostname) {
     if (!hostname) return false;
     
@@ -293,16 +968,3 @@ bool StorageManager::isValidHostname(const char* hostname) {
 bool StorageManager::isValidIP(uint32_t ip) {
     return ip != 0;
 }
-
-void StorageManager::debugPrint(const String& message) {
-    Serial.printf("[StorageManager] %s\n", message.c_str());
-}
-
-void StorageManager::debugPrintf(const char* format, ...) {
-    va_list args;
-    va_start(args, format);
-    Serial.printf("[StorageManager] ");
-    Serial.printf(format, args);
-    Serial.println();
-    va_end(args);
-}
\ No newline at end of file
@@ -2,39 +2,76 @@
  * StorageManager - Persistent Storage Manager for PicoWiFiManager
  * 
  * Handles WiFi credentials and configuration storage in Pico's Flash memory
- * Uses EEPROM emulation with data validation and corruption recovery
+ * Uses EEPROM emulation, power-fail safe A/B flash banks or a wear-levelled
+ * flash log, with data validation and corruption recovery
  */
 
 #ifndef STORAGE_MANAGER_H
 #define STORAGE_MANAGER_H
 
 #include <Arduino.h>
-#include <EEPROM.h>
+#include "FlashLog.h"
+#include "Crc32.h"
+#include "StorageLegacy.h"
+#include "PicoWiFiFeatures.h"
 
-// Storage structure version for migration support
-#define STORAGE_VERSION 1
+// Storage structure version; older versions are migrated at begin()
+#define STORAGE_VERSION 3
 #define STORAGE_MAGIC 0x50494345  // Magic number to validate data (PICE in hex)
 
 // Maximum sizes
 #define MAX_SSID_LENGTH 32
 #define MAX_PASSWORD_LENGTH 64
 #define MAX_HOSTNAME_LENGTH 32
+#define MAX_SAVED_NETWORKS 4
+
+// Backing store sizes
+#define STORAGE_EEPROM_SIZE 2048  // Room for the data and its backup copy
+#define DUAL_BANK_SECTORS 2       // Both taken from the end of the filesystem region
+#define FLASH_LOG_SECTORS 4
+
+enum class StorageBackend : uint8_t {
+    EEPROM_EMULATION,  // Whole structure rewritten into one flash sector per save
+    DUAL_BANK,         // Alternating A/B sectors; a save never touches the live copy
+    FLASH_LOG,         // Changed sections appended to a ring of flash sectors
+    AUTO               // DUAL_BANK if its sectors are free, else EEPROM_EMULATION
+};
+
+// Last-good association, used to skip the channel scan (and optionally
+// DHCP) on the next connect to the same network
+struct FastConnectCache {
+    uint8_t valid;
+    uint8_t channel;
+    uint8_t bssid[6];
+    uint32_t ip;              // DHCP lease; 0 when none was recorded
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    
+    FastConnectCache() {
+        memset(this, 0, sizeof(*this));
+    }
+};
 
 struct WiFiCredentials {
     char ssid[MAX_SSID_LENGTH];
     char password[MAX_PASSWORD_LENGTH];
     bool valid;
+    uint8_t priority;         // Higher wins among visible networks
+    uint32_t lastSuccess;     // Storage-wide connect counter; 0 = never connected
+    FastConnectCache fastConnect;
     
     WiFiCredentials() {
-        memset(ssid, 0, sizeof(ssid));
-        memset(password, 0, sizeof(password));
-        valid = false;
+        clear();
     }
     
     void clear() {
         memset(ssid, 0, sizeof(ssid));
         memset(password, 0, sizeof(password));
         valid = false;
+        priority = 0;
+        lastSuccess = 0;
+        fastConnect = FastConnectCache();
     }
 };
 
@@ -77,7 +114,8 @@ struct StorageData {
     uint8_t version;          // Structure version
     uint32_t checksum;        // CRC32 checksum
     
-    WiFiCredentials wifi;
+    uint32_t successCounter;  // Bumped on every connect that changes the most recent network
+    WiFiCredentials networks[MAX_SAVED_NETWORKS];
     NetworkConfig network;
     DeviceConfig device;
     
@@ -87,6 +125,7 @@ struct StorageData {
         magic = STORAGE_MAGIC;
         version = STORAGE_VERSION;
         checksum = 0;
+        successCounter = 0;
         memset(reserved, 0, sizeof(reserved));
     }
 };
@@ -97,15 +136,31 @@ public:
     ~StorageManager();
     
     // Initialization
-    bool begin(size_t eepromSize = 512);
+    // DUAL_BANK and FLASH_LOG need that many sectors of filesystem area (not
+    // shared with LittleFS); without them EEPROM emulation is used. AUTO
+    // takes the banks only when they are erased or already hold banks.
+    bool begin(size_t eepromSize = STORAGE_EEPROM_SIZE,
+               StorageBackend backend = StorageBackend::AUTO);
+    StorageBackend getBackend() const { return _backend; }  // Never AUTO
+    uint8_t getMigratedFromVersion() const { return _migratedFrom; }  // 0 if none
     void format();
     
     // WiFi credentials management
-    bool saveWiFiCredentials(const char* ssid, const char* password);
+    // Saving an SSID that is already stored updates its slot; when all slots
+    // are taken the lowest-priority, least recently used one is replaced.
+    // loadWiFiCredentials() returns the preferred network.
+    bool saveWiFiCredentials(const char* ssid, const char* password, uint8_t priority = 0);
     bool loadWiFiCredentials(WiFiCredentials& credentials);
+    bool loadWiFiCredentials(const char* ssid, WiFiCredentials& credentials);
+    bool removeWiFiCredentials(const char* ssid);
     bool hasWiFiCredentials();
     void clearWiFiCredentials();
     
+    // Saved network slots
+    uint8_t getNetworkCount();
+    bool getNetwork(uint8_t index, WiFiCredentials& credentials);
+    bool markConnected(const char* ssid, const FastConnectCache* cache = nullptr);
+    
     // Network configuration
     bool saveNetworkConfig(const NetworkConfig& config);
     bool loadNetworkConfig(NetworkConfig& config);
@@ -116,6 +171,10 @@ public:
     bool loadDeviceConfig(DeviceConfig& config);
     void clearDeviceConfig();
     
+    // Per-network fast-connect cache (updated through markConnected())
+    bool loadFastConnect(const char* ssid, FastConnectCache& cache);
+    void clearFastConnect();
+    
     // Complete storage operations
     bool saveAll(const WiFiCredentials& wifi, 
                  const NetworkConfig& network, 
@@ -131,6 +190,7 @@ public:
     uint32_t getChecksum();
     size_t getUsedSpace();
     size_t getTotalSpace();
+    uint32_t measureValidationTime(uint8_t iterations = 16);  // Microseconds per validation
     
     // Debug and maintenance
     void printDiagnostics();
@@ -140,34 +200,86 @@ public:
 private:
     bool _initialized;
     size_t _eepromSize;
+    StorageBackend _backend;
+    FlashLog _log;
+    uintptr_t _bankBase;
+    uint8_t _activeBank;
+    uint32_t _generation;
+    uint8_t _migratedFrom;
     StorageData _data;
     
     // Internal operations
+    bool load();
+    bool commit();
     bool loadFromEEPROM();
     bool saveToEEPROM();
+    bool importFromEEPROM();
+    bool beginDualBank();
+    bool areBankSectorsFree() const;
+    bool loadFromBanks();
+    bool saveToBank();
+    bool writeBank(uint8_t bank);
+    const StorageData* readBank(uint8_t bank, uint32_t& generation);
+    uintptr_t bankAddress(uint8_t bank) const;
+    bool beginFlashLog();
+    bool loadFromLog();
+    bool saveToLog();
     uint32_t calculateChecksum(const StorageData& data);
     bool validateData(const StorageData& data);
     void initializeDefaults();
     
+    // Schema migration, one step per version (see StorageLegacy.h)
+    bool migrate(const uint8_t* image, size_t length);
+    void migrateV1ToV2(const StorageDataV1& legacy, StorageDataV2& upgraded);
+    void migrateV2ToCurrent(const StorageDataV2& legacy, StorageData& upgraded);
+    
     // Data validation helpers
     bool isValidSSID(const char* ssid);
     bool isValidPassword(const char* password);
     bool isValidHostname(const char* hostname);
     bool isValidIP(uint32_t ip);
     
-    // Corruption recovery
+    // Slot helpers
+    int findSlot(const char* ssid);
+    int findSlotToReplace();
+    int findPreferredSlot();
+    
+    // Corruption recovery. The backup is the state before the last commit:
+    // the other bank (DUAL_BANK) or a second copy in the EEPROM image.
     bool attemptRecovery();
-    void createBackup();
+    bool createBackup();
     bool restoreFromBackup();
+    int getBackupAddress() const;
     
-    // Utilities
-    void debugPrint(const String& message);
-    void debugPrintf(const char* format, ...);
+    // Flash log layout: one record per section, so a save only appends
+    // the sections that actually changed
+    enum LogKey : uint8_t {
+        LOG_KEY_HEADER = 0,
+        LOG_KEY_NETWORK_CONFIG = 1,
+        LOG_KEY_DEVICE_CONFIG = 2,
+        LOG_KEY_WIFI_SLOT = 3     // First of MAX_SAVED_NETWORKS slot records
+    };
     
-    static const int EEPROM_START_ADDRESS = 0;
-    static const uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+    struct LogHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t successCounter;
+    };
+    
+    static_assert(LOG_KEY_WIFI_SLOT + MAX_SAVED_NETWORKS <= FlashLog::MAX_KEYS,
+                  "Too many saved networks for the flash log");
     
-    uint32_t crc32(const uint8_t* data, size_t length);
+    // Dual-bank layout: a header followed by the StorageData image. The CRC
+    // covers the generation too, so a torn write can never look newer.
+    struct BankHeader {
+        uint32_t magic;
+        uint32_t generation;
+        uint32_t length;
+        uint32_t crc;
+    };
+    
+    static const uint32_t BANK_MAGIC = 0x4B4E4250;  // "PBNK"
+    static const int EEPROM_START_ADDRESS = 0;
 };
 
 #endif // STORAGE_MANAGER_H
\ No newline at end of file
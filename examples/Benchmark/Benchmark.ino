@@ -0,0 +1,329 @@
+/**
+ * PicoWiFiManager - Benchmark Example
+ *
+ * Runs the library against the simulated radio and flash of SimulatedWiFi.h
+ * and SimulatedStorage.h and prints a report, so changes that slow down
+ * reconnects, scans or storage show up before they reach devices in the
+ * field. The radio is not used; the numbers depend only on the library and
+ * the scripted latencies below.
+ *
+ * This example measures:
+ * - Reconnect time after the AP drops the link (fast connect and fallback)
+ * - CPU time spent processing scan results, by access point count
+ * - Storage commit time and flash operations per backend
+ * - Power-loss recovery: power is cut at every flash operation of a save
+ * - Lowest free heap seen during the run
+ *
+ * Run it on the board and compare the report between library versions.
+ * extras/host runs the same checks, plus portal latency, as pass/fail
+ * tests on a PC.
+ */
+
+#include "PicoWiFiManager.h"
+#include "SimulatedWiFi.h"
+#include "SimulatedStorage.h"
+
+const char* BENCH_SSID = "BenchNet";
+const char* BENCH_PASSWORD = "benchpass";
+const uint8_t RECONNECT_RUNS = 5;
+const uint8_t COMMIT_RUNS = 8;
+const uint32_t RECONNECT_TIMEOUT_MS = 60000;
+
+SimulatedWiFiDriver radio;
+
+alignas(FLASH_SECTOR_SIZE) uint8_t flashRegion[6 * FLASH_SECTOR_SIZE];
+SimulatedFlashDriver flash(flashRegion, sizeof(flashRegion));
+
+uint8_t eepromStored[STORAGE_EEPROM_SIZE];
+uint8_t eepromImage[STORAGE_EEPROM_SIZE];
+SimulatedEEPROMDriver eeprom(eepromStored, eepromImage, sizeof(eepromStored));
+
+#if PICOWIFI_ENABLE_SCANNER
+NetworkScanner scanner;
+#endif
+
+size_t lowestFreeHeap = SIZE_MAX;
+
+void sampleHeap() {
+    size_t freeHeap = rp2040.getFreeHeap();
+    if (freeHeap < lowestFreeHeap) lowestFreeHeap = freeHeap;
+}
+
+const char* backendName(StorageBackend backend) {
+    switch (backend) {
+        case StorageBackend::DUAL_BANK: return "DUAL_BANK";
+        case StorageBackend::FLASH_LOG: return "FLASH_LOG";
+        default: return "EEPROM_EMULATION";
+    }
+}
+
+void wipeStorage() {
+    flash.wipe();
+    flash.powerCycle();
+    eeprom.wipe();
+    eeprom.powerCycle();
+}
+
+uint32_t flashOperations() {
+    const SimulatedFlashStats& a = flash.getStats();
+    const SimulatedFlashStats& b = eeprom.getStats();
+    return a.erases + a.programs + b.erases + b.programs;
+}
+
+uint32_t flashBusyMicros() {
+    return flash.getStats().busyMicros + eeprom.getStats().busyMicros;
+}
+
+bool saveHostname(StorageManager& storage, const char* hostname) {
+    DeviceConfig device;
+    storage.loadDeviceConfig(device);
+    strncpy(device.hostname, hostname, sizeof(device.hostname) - 1);
+    device.hostname[sizeof(device.hostname) - 1] = '\0';
+    return storage.saveDeviceConfig(device);
+}
+
+// Reconnect time: from the link loss until loop() has the device back online
+void benchmarkReconnect() {
+    Serial.println("\n## Reconnect");
+
+    // The saved network is in storage before the manager starts, as after a reboot
+    wipeStorage();
+    StorageManager* seed = new StorageManager();
+    seed->begin(STORAGE_EEPROM_SIZE, StorageBackend::DUAL_BANK);
+    seed->saveWiFiCredentials(BENCH_SSID, BENCH_PASSWORD);
+    delete seed;
+
+    PicoWiFiConfig config;
+    config.enableSerial = false;
+    config.resetPin = 255;
+    config.storageBackend = StorageBackend::DUAL_BANK;
+    PicoWiFiManager* wifi = new PicoWiFiManager(config);
+
+    wifi->begin();
+    wifi->connectAsync();
+    while (wifi->isConnectPending()) {
+        wifi->loop();
+        sampleHeap();
+    }
+    Serial.printf("First connect: %lu ms (%s)\n", (unsigned long)wifi->getLastConnectDuration(),
+                  wifi->isConnected() ? "ok" : "FAILED");
+
+    Serial.println("| Case | Run | Outage ms | Connect ms | Path |");
+    Serial.println("|------|-----|-----------|------------|------|");
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        const char* name = pass == 0 ? "AP reboot" : "cached AP rejects";
+        for (uint8_t run = 0; run < RECONNECT_RUNS; run++) {
+            if (pass == 1) {
+                // The fast connect fails, so the fallback full connect is timed
+                radio.failNextConnects(1);
+            }
+            radio.dropLink();
+            uint32_t start = millis();
+            while (!wifi->isConnected() && millis() - start < RECONNECT_TIMEOUT_MS) {
+                wifi->loop();
+                sampleHeap();
+            }
+
+            if (wifi->isConnected()) {
+                Serial.printf("| %s | %u | %lu | %lu | %s |\n", name, run + 1, (unsigned long)(millis() - start),
+                              (unsigned long)wifi->getLastConnectDuration(),
+                              wifi->wasFastConnect() ? "fast" : "full");
+            } else {
+                Serial.printf("| %s | %u | timeout | - | - |\n", name, run + 1);
+            }
+        }
+    }
+
+    ReconnectStats stats = wifi->getReconnectStats();
+    Serial.printf("Recovery: last %lu ms, max %lu ms over %lu outages\n",
+                  (unsigned long)stats.lastRecoveryTime, (unsigned long)stats.maxRecoveryTime,
+                  (unsigned long)stats.linkLosses);
+    delete wifi;
+}
+
+#if PICOWIFI_ENABLE_SCANNER
+// Scan processing: results are ready at once, so only library CPU time is timed
+void benchmarkScan() {
+    Serial.println("\n## Scan processing");
+    Serial.println("| APs | Async us | Blocking us | Networks |");
+    Serial.println("|-----|----------|-------------|----------|");
+
+    SimulatedRadioTiming timing = radio.getTiming();
+    SimulatedRadioTiming instant = timing;
+    instant.scanLatency = 0;
+    radio.setTiming(instant);
+
+    const uint8_t counts[] = {8, 16, 32, 48};
+    for (uint8_t count : counts) {
+        radio.clearAccessPoints();
+        for (uint8_t i = 0; i < count; i++) {
+            // A few ESSes with several APs each, spread over the channels
+            char ssid[16];
+            snprintf(ssid, sizeof(ssid), "Net%02u", i / 3);
+            radio.addAccessPoint(ssid, "password", 1 + (i * 5) % 11, -40 - (i * 7) % 50);
+        }
+
+        scanner.clearCache();
+        scanner.startAsyncScan();
+        uint32_t start = micros();
+        scanner.update();
+        uint32_t async = micros() - start;
+
+        start = micros();
+        scanner.startScan();
+        uint32_t blocking = micros() - start;
+        sampleHeap();
+
+        Serial.printf("| %u | %lu | %lu | %d |\n", count, (unsigned long)async, (unsigned long)blocking,
+                      scanner.getNetworkCount());
+    }
+
+    radio.setTiming(timing);
+    radio.clearAccessPoints();
+    radio.addAccessPoint(BENCH_SSID, BENCH_PASSWORD, 6, -55);
+}
+#endif
+
+// Commit cost with the default flash timing
+void benchmarkCommit(StorageBackend backend) {
+    wipeStorage();
+    StorageManager* storage = new StorageManager();
+    storage->begin(STORAGE_EEPROM_SIZE, backend);
+
+    uint32_t operations = flashOperations();
+    uint32_t busy = flashBusyMicros();
+    uint32_t worst = 0;
+    uint32_t start = millis();
+    for (uint8_t run = 0; run < COMMIT_RUNS; run++) {
+        char hostname[16];
+        snprintf(hostname, sizeof(hostname), "bench-%u", run);
+        uint32_t began = millis();
+        saveHostname(*storage, hostname);
+        uint32_t took = millis() - began;
+        if (took > worst) worst = took;
+    }
+    uint32_t total = millis() - start;
+    sampleHeap();
+
+    Serial.printf("| %s | %lu | %lu | %lu | %lu |\n", backendName(backend),
+                  (unsigned long)(total / COMMIT_RUNS), (unsigned long)worst,
+                  (unsigned long)((flashOperations() - operations) / COMMIT_RUNS),
+                  (unsigned long)((flashBusyMicros() - busy) / COMMIT_RUNS));
+    delete storage;
+}
+
+// Cuts the power at every flash operation of one save and checks what the
+// next boot finds: the old or the new state is fine, defaults mean data loss
+void benchmarkPowerLoss(StorageBackend backend) {
+    // How many operations one save takes
+    wipeStorage();
+    StorageManager* storage = new StorageManager();
+    storage->begin(STORAGE_EEPROM_SIZE, backend);
+    saveHostname(*storage, "state-old");
+    uint32_t before = flashOperations();
+    saveHostname(*storage, "state-new");
+    uint32_t operations = flashOperations() - before;
+    delete storage;
+
+    uint32_t kept = 0;
+    uint32_t updated = 0;
+    uint32_t lost = 0;
+    for (uint32_t cut = 0; cut < operations; cut++) {
+        wipeStorage();
+        storage = new StorageManager();
+        storage->begin(STORAGE_EEPROM_SIZE, backend);
+        saveHostname(*storage, "state-old");
+
+        flash.failAfter(cut);
+        eeprom.failAfter(cut);
+        saveHostname(*storage, "state-new");
+        delete storage;
+        flash.powerCycle();
+        eeprom.powerCycle();
+
+        storage = new StorageManager();
+        storage->begin(STORAGE_EEPROM_SIZE, backend);
+        DeviceConfig device;
+        storage->loadDeviceConfig(device);
+        if (strcmp(device.hostname, "state-old") == 0) {
+            kept++;
+        } else if (strcmp(device.hostname, "state-new") == 0) {
+            updated++;
+        } else {
+            lost++;
+        }
+        delete storage;
+    }
+    sampleHeap();
+
+    Serial.printf("| %s | %lu | %lu | %lu | %lu | %s |\n", backendName(backend), (unsigned long)operations,
+                  (unsigned long)kept, (unsigned long)updated, (unsigned long)lost, lost == 0 ? "PASS" : "FAIL");
+}
+
+void benchmarkStorage() {
+    const StorageBackend backends[] = {
+        StorageBackend::EEPROM_EMULATION, StorageBackend::DUAL_BANK, StorageBackend::FLASH_LOG
+    };
+
+    Serial.println("\n## Storage commit");
+    Serial.println("| Backend | Avg ms | Max ms | Flash ops | Flash busy us |");
+    Serial.println("|---------|--------|--------|-----------|---------------|");
+    for (StorageBackend backend : backends) {
+        benchmarkCommit(backend);
+    }
+
+    // Timing off: the sweep repeats the save many times
+    SimulatedFlashTiming instant;
+    instant.eraseMicros = 0;
+    instant.programMicros = 0;
+    flash.setTiming(instant);
+    eeprom.setTiming(instant);
+
+    Serial.println("\n## Power loss during a save");
+    Serial.println("| Backend | Cut points | Old kept | New kept | Lost | Result |");
+    Serial.println("|---------|------------|----------|----------|------|--------|");
+    for (StorageBackend backend : backends) {
+        benchmarkPowerLoss(backend);
+    }
+    Serial.println("EEPROM emulation erases its only sector on every commit, so it is expected to lose data.");
+
+    SimulatedFlashTiming defaults;
+    flash.setTiming(defaults);
+    eeprom.setTiming(defaults);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n# PicoWiFiManager Benchmark");
+
+    PicoWiFiHAL::setWiFiDriver(&radio);
+    PicoWiFiHAL::setFlashDriver(&flash);
+    PicoWiFiHAL::setEEPROMDriver(&eeprom);
+
+    radio.addAccessPoint(BENCH_SSID, BENCH_PASSWORD, 6, -55);
+    radio.addAccessPoint(BENCH_SSID, BENCH_PASSWORD, 11, -70);
+    sampleHeap();
+    size_t startFreeHeap = lowestFreeHeap;
+
+    benchmarkReconnect();
+#if PICOWIFI_ENABLE_SCANNER
+    benchmarkScan();
+#endif
+    benchmarkStorage();
+
+    Serial.println("\n## Heap");
+    Serial.printf("Free at start: %lu bytes, lowest: %lu bytes, peak use: %lu bytes\n",
+                  (unsigned long)startFreeHeap, (unsigned long)lowestFreeHeap,
+                  (unsigned long)(startFreeHeap - lowestFreeHeap));
+
+    PicoWiFiHAL::setWiFiDriver(nullptr);
+    PicoWiFiHAL::setFlashDriver(nullptr);
+    PicoWiFiHAL::setEEPROMDriver(nullptr);
+    Serial.println("\nDone.");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,104 @@
+/**
+ * PicoWiFiManager - Low Power Example
+ *
+ * A battery sensor node that reports a reading every few minutes
+ *
+ * This example shows:
+ * - Selecting a radio power-save mode
+ * - Duty cycling with runDutyCycle(): connect, send, disconnect, sleep
+ * - Powering the radio down for the sleep
+ * - Comparing connect-to-ready times across power-save modes
+ *
+ * Set MEASURE_MODES to true to rotate through every mode and print the
+ * latency table, then pick the mode that suits the deployment.
+ */
+
+#include "PicoWiFiManager.h"
+
+PicoWiFiManager wifiManager;
+
+const uint32_t REPORT_PERIOD_MS = 5 * 60 * 1000;
+const bool MEASURE_MODES = false;
+const uint32_t CYCLES_PER_MODE = 5;      // When measuring
+const uint32_t MEASURE_PERIOD_MS = 20000;
+
+uint32_t cycle = 0;
+
+bool sendReading() {
+    // Replace with the real upload (MQTT publish, HTTP POST...)
+    WiFiClient client;
+    if (!client.connect("192.168.1.10", 8080)) {
+        return false;
+    }
+    client.printf("temperature=%.1f\n", analogReadTemp());
+    client.stop();
+
+    wifiManager.notifyFirstPacket();
+    return true;
+}
+
+void printReadyTimes() {
+    ConnectTiming timing;
+    wifiManager.getConnectTiming(timing);
+
+    // Connects after a powered-down sleep include the radio's start-up
+    bool fromOff = wifiManager.getConfig().powerPolicy.radioOffWhileSleeping;
+    Serial.println("Mode         connects  avg ms  p95 ms");
+    for (uint8_t i = 0; i < POWER_SAVE_MODE_COUNT; i++) {
+        const LatencyHistogram& ready = timing.getReadyHistogram((PowerSaveMode)i, fromOff);
+        Serial.printf("%-12s %8lu  %6lu  %6lu\n", PowerController::getModeName((PowerSaveMode)i),
+                      (unsigned long)ready.getCount(), (unsigned long)ready.getAverage(),
+                      (unsigned long)ready.getPercentile(95));
+    }
+
+    DutyCycleStats stats = wifiManager.getDutyCycleStats();
+    Serial.printf("%lu cycles, %lu failed, last awake %lu ms\n", (unsigned long)stats.cycles,
+                  (unsigned long)stats.failures, (unsigned long)stats.lastAwakeTime);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n=== PicoWiFiManager Low Power Example ===");
+
+    PicoWiFiConfig config;
+    config.powerPolicy.mode = PowerSaveMode::AGGRESSIVE;
+    config.powerPolicy.dtimInterval = 3;
+    config.powerPolicy.radioOffWhileSleeping = true;  // Lowest sleep current, slower wake
+    config.fastConnect = true;
+    config.fastConnectReuseLease = true;   // Skip DHCP on every wake
+    config.autoReconnect = false;          // runDutyCycle() decides when to connect
+    wifiManager.setConfig(config);
+
+    if (!wifiManager.begin()) {
+        Serial.println("Failed to initialize WiFi manager!");
+        while (true) {
+            delay(1000);
+        }
+    }
+
+    // Provision once through the portal; afterwards every wake uses fast connect
+    wifiManager.autoConnect();
+}
+
+void loop() {
+    if (MEASURE_MODES) {
+        uint8_t mode = (cycle / CYCLES_PER_MODE) % POWER_SAVE_MODE_COUNT;
+        PowerPolicy policy = wifiManager.getConfig().powerPolicy;
+        policy.mode = (PowerSaveMode)mode;
+        wifiManager.setPowerPolicy(policy);
+
+        wifiManager.runDutyCycle(MEASURE_PERIOD_MS, sendReading);
+
+        cycle++;
+        if (cycle % (CYCLES_PER_MODE * POWER_SAVE_MODE_COUNT) == 0) {
+            printReadyTimes();
+        }
+        return;
+    }
+
+    if (!wifiManager.runDutyCycle(REPORT_PERIOD_MS, sendReading)) {
+        Serial.println("Reading not sent");
+    }
+}
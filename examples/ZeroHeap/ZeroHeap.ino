@@ -0,0 +1,137 @@
+/**
+ * PicoWiFiManager - Zero Heap Example
+ *
+ * Verifies that the steady-state loop() path never touches the heap
+ *
+ * Build the whole project with PICOWIFI_STATIC_ALLOCATION=1, e.g. in
+ * platformio.ini:
+ *     build_flags = -DPICOWIFI_STATIC_ALLOCATION=1
+ *
+ * This example shows:
+ * - Counting every operator new made by the sketch and the library
+ * - Reading mallinfo() before and after every loop() pass, which also
+ *   catches malloc(), calloc() and realloc() from String and C code
+ * - Reporting PASS/FAIL once the measurement window closes
+ *
+ * A malloc() freed again within the same pass nets out in mallinfo(). The
+ * zero_heap check in extras/host counts every call instead, against the
+ * simulated radio, so it needs no access point.
+ */
+
+#include <malloc.h>
+#include "PicoWiFiManager.h"
+
+#if !PICOWIFI_STATIC_ALLOCATION
+#warning "Build with -DPICOWIFI_STATIC_ALLOCATION=1 to test the zero-allocation configuration"
+#endif
+
+// Counting allocators for the whole program
+static volatile uint32_t allocationCount = 0;
+
+void* operator new(size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+void* operator new[](size_t size) {
+    allocationCount++;
+    return malloc(size);
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+PicoWiFiManager wifiManager;
+
+const uint32_t WARMUP_MS = 10000;   // Let DHCP, ARP and the first snapshot settle
+const uint32_t MEASURE_MS = 60000;
+
+enum class Phase { WAITING, WARMUP, MEASURING, DONE };
+Phase phase = Phase::WAITING;
+uint32_t phaseStart = 0;
+uint32_t startAllocations = 0;
+size_t startUsedHeap = 0;
+uint32_t passes = 0;
+uint32_t heapChangingPasses = 0;
+long largestPassChange = 0;
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n=== PicoWiFiManager Zero Heap Example ===");
+    Serial.printf("Static allocation: %s\n", PICOWIFI_STATIC_ALLOCATION ? "on" : "off");
+
+    if (!wifiManager.begin()) {
+        Serial.println("Failed to initialize WiFi manager!");
+        while (true) {
+            delay(1000);
+        }
+    }
+
+    Serial.printf("After begin(): %lu allocations, %u bytes heap in use\n",
+                  (unsigned long)allocationCount, (unsigned)rp2040.getUsedHeap());
+
+    wifiManager.autoConnect();
+}
+
+void loop() {
+    // mallinfo() walks no lists and allocates nothing itself
+    struct mallinfo before = mallinfo();
+    wifiManager.loop();
+    struct mallinfo after = mallinfo();
+
+    uint32_t now = millis();
+
+    switch (phase) {
+        case Phase::WAITING:
+            if (wifiManager.isConnected()) {
+                Serial.println("Connected, warming up...");
+                // Library messages would count too, so keep them quiet
+                wifiManager.enableDebug(false);
+                phase = Phase::WARMUP;
+                phaseStart = now;
+            }
+            break;
+
+        case Phase::WARMUP:
+            if (now - phaseStart >= WARMUP_MS) {
+                Serial.println("Measuring...");
+                Serial.flush();
+                startAllocations = allocationCount;
+                startUsedHeap = rp2040.getUsedHeap();
+                phase = Phase::MEASURING;
+                phaseStart = now;
+            }
+            break;
+
+        case Phase::MEASURING: {
+            passes++;
+            long passChange = (long)after.uordblks - (long)before.uordblks;
+            if (passChange != 0) {
+                heapChangingPasses++;
+                if (labs(passChange) > labs(largestPassChange)) {
+                    largestPassChange = passChange;
+                }
+            }
+            if (now - phaseStart >= MEASURE_MS) {
+                uint32_t allocations = allocationCount - startAllocations;
+                long heapDelta = (long)rp2040.getUsedHeap() - (long)startUsedHeap;
+
+                Serial.printf("%lu loop() passes: %lu allocations, heap in use %+ld bytes\n",
+                              (unsigned long)passes, (unsigned long)allocations, heapDelta);
+                Serial.printf("%lu passes changed the heap (largest %+ld bytes)\n",
+                              (unsigned long)heapChangingPasses, largestPassChange);
+                bool passed = allocations == 0 && heapDelta == 0 && heapChangingPasses == 0;
+                Serial.println(passed ? "PASS" : "FAIL");
+                phase = Phase::DONE;
+            }
+            break;
+        }
+
+        case Phase::DONE:
+            break;
+    }
+}
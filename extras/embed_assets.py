@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""
+Embed the config portal web assets as gzip-compressed flash arrays.
+
+Reads extras/portal/{index.html,portal.css,portal.js}, compresses each one
+and writes PortalAssets.h at the library root. Re-run after editing any
+asset:
+
+    python3 extras/embed_assets.py
+"""
+
+import gzip
+import hashlib
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE_DIR = os.path.join(ROOT, "extras", "portal")
+OUTPUT = os.path.join(ROOT, "PortalAssets.h")
+
+# (file name, C symbol, MIME type)
+ASSETS = [
+    ("index.html", "PORTAL_INDEX_HTML", "text/html; charset=utf-8"),
+    ("portal.css", "PORTAL_CSS", "text/css"),
+    ("portal.js", "PORTAL_JS", "application/javascript"),
+]
+
+
+def read_assets():
+    return {name: open(os.path.join(SOURCE_DIR, name), "rb").read() for name, _, _ in ASSETS}
+
+
+def asset_version(contents):
+    digest = hashlib.sha1()
+    for name, _, _ in ASSETS:
+        digest.update(contents[name])
+    return digest.hexdigest()[:8]
+
+
+def c_array(symbol, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        chunk = ", ".join("0x%02x" % b for b in data[i:i + 16])
+        lines.append("    " + chunk + ",")
+    body = "\n".join(lines)
+    return ("static const uint8_t %s_GZ[] PROGMEM = {\n%s\n};\n"
+            "static const size_t %s_GZ_LEN = sizeof(%s_GZ);\n" % (symbol, body, symbol, symbol))
+
+
+def main():
+    contents = read_assets()
+    version = asset_version(contents)
+
+    out = []
+    out.append("/**\n")
+    out.append(" * PortalAssets - Precompressed config portal web assets\n")
+    out.append(" *\n")
+    out.append(" * GENERATED by extras/embed_assets.py from extras/portal/ - do not edit.\n")
+    out.append(" */\n\n")
+    out.append("#ifndef PORTAL_ASSETS_H\n#define PORTAL_ASSETS_H\n\n")
+    out.append("#include <Arduino.h>\n\n")
+    out.append("// Cache-busting token referenced by index.html as ?v=...\n")
+    out.append("#define PORTAL_ASSET_VERSION \"%s\"\n\n" % version)
+
+    for name, symbol, mime in ASSETS:
+        data = contents[name].replace(b"{{VERSION}}", version.encode())
+        compressed = gzip.compress(data, compresslevel=9, mtime=0)
+        out.append("// %s: %d bytes, %d bytes gzipped\n" % (name, len(data), len(compressed)))
+        out.append("static const char %s_TYPE[] = \"%s\";\n" % (symbol, mime))
+        out.append(c_array(symbol, compressed))
+        out.append("\n")
+
+    out.append("#endif // PORTAL_ASSETS_H\n")
+
+    with open(OUTPUT, "w") as f:
+        f.write("".join(out))
+
+
+if __name__ == "__main__":
+    main()
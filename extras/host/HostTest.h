@@ -0,0 +1,45 @@
+/**
+ * HostTest - Pass/fail bookkeeping for the host checks
+ *
+ *     HostTest::check(lost == 0, "DUAL_BANK keeps a state at every cut");
+ *     return HostTest::finish();
+ *
+ * Every check prints one PASS or FAIL line; finish() returns the exit code
+ * ctest looks at.
+ */
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include "HostStubs.h"
+
+class HostTest {
+public:
+    static bool check(bool passed, const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        printf("%s ", passed ? "PASS" : "FAIL");
+        vprintf(format, args);
+        printf("\n");
+        va_end(args);
+
+        if (!passed) failures()++;
+        return passed;
+    }
+
+    static int finish() {
+        if (failures() > 0) {
+            printf("%u check(s) failed\n", failures());
+            return 1;
+        }
+        return 0;
+    }
+
+private:
+    static unsigned& failures() {
+        static unsigned count = 0;
+        return count;
+    }
+};
+
+#endif // HOST_TEST_H
@@ -0,0 +1,244 @@
+/**
+ * Arduino - Host stand-in for the arduino-pico core
+ *
+ * Just enough of the core for the library to build and run on a PC. Time
+ * is virtual: delay() and delayMicroseconds() advance it without waiting,
+ * and every millis()/micros() read moves it on by HostClock::TICK_MICROS
+ * so polling loops make progress (see HostStubs.h).
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <string>
+#include <functional>
+#include <algorithm>
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+#define HEX 16
+#define DEC 10
+#define LED_BUILTIN 64
+#define A0 26
+
+#define PROGMEM
+#define PGM_P const char*
+#define F(x) x
+#define pgm_read_byte(p) (*(const uint8_t*)(p))
+#define digitalPinToInterrupt(p) (p)
+
+typedef bool boolean;
+
+class String : public std::string {
+public:
+    String() {}
+    String(const char* text) : std::string(text ? text : "") {}
+    String(const std::string& text) : std::string(text) {}
+    explicit String(char c) : std::string(1, c) {}
+    String(int value, int base = DEC) : std::string(format(base == HEX ? "%x" : "%d", value)) {}
+    String(unsigned value, int base = DEC) : std::string(format(base == HEX ? "%x" : "%u", value)) {}
+    String(long value, int base = DEC) : std::string(format(base == HEX ? "%lx" : "%ld", value)) {}
+    String(unsigned long value, int base = DEC) : std::string(format(base == HEX ? "%lx" : "%lu", value)) {}
+    String(double value, int decimals = 2) : std::string(format("%.*f", decimals, value)) {}
+
+    bool isEmpty() const { return empty(); }
+    bool equals(const String& other) const { return *this == other; }
+    bool startsWith(const String& prefix) const { return compare(0, prefix.size(), prefix) == 0; }
+    bool endsWith(const String& suffix) const {
+        return size() >= suffix.size() && compare(size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+    char charAt(unsigned index) const { return index < size() ? (*this)[index] : 0; }
+    int indexOf(char c) const { size_type at = find(c); return at == npos ? -1 : (int)at; }
+    String substring(unsigned from, unsigned to = ~0u) const {
+        return from < size() ? String(substr(from, to > size() ? npos : to - from)) : String();
+    }
+    int toInt() const { return atoi(c_str()); }
+    bool reserve(size_t size) { std::string::reserve(size); return true; }
+    void toUpperCase() { for (char& c : *this) c = (char)toupper((unsigned char)c); }
+    void toLowerCase() { for (char& c : *this) c = (char)tolower((unsigned char)c); }
+    void trim() {
+        size_type first = find_first_not_of(" \t\r\n");
+        size_type last = find_last_not_of(" \t\r\n");
+        *this = first == npos ? String() : String(substr(first, last - first + 1));
+    }
+
+private:
+    static std::string format(const char* format, ...) __attribute__((format(printf, 1, 2))) {
+        char buffer[40];
+        va_list args;
+        va_start(args, format);
+        vsnprintf(buffer, sizeof(buffer), format, args);
+        va_end(args);
+        return buffer;
+    }
+};
+
+inline String operator+(const String& a, const char* b) { return String(static_cast<const std::string&>(a) + b); }
+inline String operator+(const char* a, const String& b) { return String(a + static_cast<const std::string&>(b)); }
+inline String operator+(const String& a, const String& b) {
+    return String(static_cast<const std::string&>(a) + static_cast<const std::string&>(b));
+}
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* data, size_t length) {
+        size_t written = 0;
+        while (length-- > 0) written += write(*data++);
+        return written;
+    }
+    size_t write(const char* text) { return text ? write((const uint8_t*)text, strlen(text)) : 0; }
+    virtual void flush() {}
+
+    size_t print(const char* text) { return write(text); }
+    size_t print(const String& text) { return write((const uint8_t*)text.c_str(), text.length()); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(int value) { return printf("%d", value); }
+    size_t print(unsigned value) { return printf("%u", value); }
+    size_t print(long value) { return printf("%ld", value); }
+    size_t print(unsigned long value) { return printf("%lu", value); }
+    size_t print(double value, int decimals = 2) { return printf("%.*f", decimals, value); }
+    template <typename T> size_t println(const T& value) { return print(value) + println(); }
+    size_t println() { return write("\r\n"); }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, format);
+        size_t written = vprintf(format, args);
+        va_end(args);
+        return written;
+    }
+    size_t vprintf(const char* format, va_list args) {
+        char buffer[512];
+        int length = vsnprintf(buffer, sizeof(buffer), format, args);
+        if (length < 0) return 0;
+        return write((const uint8_t*)buffer, (size_t)length < sizeof(buffer) ? length : sizeof(buffer) - 1);
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    virtual int peek() { return -1; }
+    size_t readBytes(uint8_t* buffer, size_t length) {
+        size_t count = 0;
+        while (count < length && available() > 0) buffer[count++] = (uint8_t)read();
+        return count;
+    }
+    String readStringUntil(char terminator) {
+        String text;
+        while (available() > 0) {
+            int c = read();
+            if (c < 0 || c == terminator) break;
+            text += (char)c;
+        }
+        return text;
+    }
+};
+
+// Writes to stdout; input is fed with HostSerial::feed() (HostStubs.h)
+class SerialUSB : public Stream {
+public:
+    void begin(unsigned long) {}
+    void end() {}
+    operator bool() const { return true; }
+    int availableForWrite() { return 256; }
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    using Print::write;
+    int available() override;
+    int read() override;
+    int peek() override;
+};
+
+extern SerialUSB Serial;
+
+class IPAddress {
+public:
+    IPAddress() : _address(0) {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _address(a | b << 8 | c << 16 | (uint32_t)d << 24) {}
+    IPAddress(uint32_t address) : _address(address) {}
+
+    operator uint32_t() const { return _address; }
+    uint8_t operator[](int index) const { return (uint8_t)(_address >> (8 * index)); }
+    bool isSet() const { return _address != 0; }
+    bool fromString(const char* text) {
+        unsigned a, b, c, d;
+        if (!text || sscanf(text, "%u.%u.%u.%u", &a, &b, &c, &d) != 4) return false;
+        _address = IPAddress(a, b, c, d);
+        return true;
+    }
+    String toString() const {
+        char text[16];
+        snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+        return String(text);
+    }
+
+private:
+    uint32_t _address;
+};
+
+#define INADDR_NONE IPAddress(0, 0, 0, 0)
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, int value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+float analogReadTemp();
+void attachInterrupt(uint8_t pin, void (*callback)(), int mode);
+void attachInterruptParam(uint8_t pin, void (*callback)(void*), int mode, void* param);
+void detachInterrupt(uint8_t pin);
+void noInterrupts();
+void interrupts();
+
+long random(long limit);
+long random(long low, long high);
+
+// Heap figures come from the host allocator (mallinfo2)
+class RP2040 {
+public:
+    uint32_t hwrand32();
+    size_t getFreeHeap();
+    size_t getUsedHeap();
+    size_t getTotalHeap();
+    void restart();
+    void idleOtherCore() {}
+    void resumeOtherCore() {}
+    uint32_t getCycleCount();
+};
+
+extern RP2040 rp2040;
+
+template <class T> T constrain(T value, T low, T high) { return value < low ? low : value > high ? high : value; }
+template <class T, class U> auto min(T a, U b) -> decltype(a < b ? a : b) { return a < b ? a : b; }
+template <class T, class U> auto max(T a, U b) -> decltype(a > b ? a : b) { return a > b ? a : b; }
+
+inline void* memcpy_P(void* destination, const void* source, size_t length) {
+    return memcpy(destination, source, length);
+}
+
+#endif // HOST_ARDUINO_H
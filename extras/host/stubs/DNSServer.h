@@ -0,0 +1,21 @@
+/**
+ * DNSServer - Host stand-in; the captive DNS answers nothing
+ */
+
+#ifndef HOST_DNSSERVER_H
+#define HOST_DNSSERVER_H
+
+#include <WiFi.h>
+
+class DNSServer {
+public:
+    bool start(uint16_t port, const String& domain, IPAddress ip) {
+        (void)port; (void)domain; (void)ip;
+        return true;
+    }
+    void stop() {}
+    void processNextRequest() {}
+    void setTTL(uint32_t ttl) { (void)ttl; }
+};
+
+#endif // HOST_DNSSERVER_H
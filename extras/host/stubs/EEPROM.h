@@ -0,0 +1,28 @@
+/**
+ * EEPROM - Host stand-in for arduino-pico's EEPROM emulation (RAM only)
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <Arduino.h>
+
+class EEPROMClass {
+public:
+    void begin(size_t size);
+    bool commit() { return true; }
+    bool end() { return true; }
+    uint8_t read(int address) { return _data[address]; }
+    void write(int address, uint8_t value) { _data[address] = value; }
+    uint8_t* getDataPtr() { return _data; }
+    const uint8_t* getConstDataPtr() const { return _data; }
+    size_t length() const { return _size; }
+
+private:
+    uint8_t _data[4096];
+    size_t _size = 0;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
@@ -0,0 +1,324 @@
+/**
+ * HostStubs - Implementation of the host stand-ins
+ */
+
+#include "HostStubs.h"
+#include <WiFi.h>
+#include <WebServer.h>
+#include <EEPROM.h>
+#include <hardware/flash.h>
+#include <pico/cyw43_arch.h>
+#include <pico/stdlib.h>
+#include <malloc.h>
+#include <deque>
+
+// Typical for the RP2350 with the default linker script
+static const size_t HOST_HEAP_SIZE = 256 * 1024;
+
+static uint64_t hostMicros = 0;
+static bool serialQuiet = false;
+static std::deque<char> serialInput;
+
+SerialUSB Serial;
+RP2040 rp2040;
+WiFiClass WiFi;
+EEPROMClass EEPROM;
+cyw43_t cyw43_state;
+
+// The filesystem region of the linker script; SimulatedFlashDriver replaces it
+uint8_t _FS_start;
+uint8_t _FS_end;
+
+// HostClock
+
+uint64_t HostClock::now() {
+    return hostMicros;
+}
+
+void HostClock::advance(uint64_t micros) {
+    hostMicros += micros;
+}
+
+unsigned long millis() {
+    hostMicros += HostClock::TICK_MICROS;
+    return (unsigned long)(uint32_t)(hostMicros / 1000);
+}
+
+unsigned long micros() {
+    hostMicros += HostClock::TICK_MICROS;
+    return (unsigned long)(uint32_t)hostMicros;
+}
+
+void delay(unsigned long ms) {
+    hostMicros += (uint64_t)ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+    hostMicros += us;
+}
+
+void sleep_ms(uint32_t ms) {
+    delay(ms);
+}
+
+void sleep_us(uint64_t us) {
+    hostMicros += us;
+}
+
+void yield() {
+}
+
+// Serial
+
+void HostSerial::feed(const char* text) {
+    while (text && *text) {
+        serialInput.push_back(*text++);
+    }
+}
+
+void HostSerial::setQuiet(bool quiet) {
+    serialQuiet = quiet;
+}
+
+size_t SerialUSB::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+size_t SerialUSB::write(const uint8_t* data, size_t length) {
+    if (!serialQuiet) {
+        fwrite(data, 1, length, stdout);
+    }
+    return length;
+}
+
+int SerialUSB::available() {
+    return (int)serialInput.size();
+}
+
+int SerialUSB::read() {
+    if (serialInput.empty()) return -1;
+    char c = serialInput.front();
+    serialInput.pop_front();
+    return (uint8_t)c;
+}
+
+int SerialUSB::peek() {
+    return serialInput.empty() ? -1 : (uint8_t)serialInput.front();
+}
+
+// Pins; nothing is connected, inputs read high like an idle pull-up
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, int) {}
+int digitalRead(uint8_t) { return HIGH; }
+int analogRead(uint8_t) { return 0; }
+void analogWrite(uint8_t, int) {}
+float analogReadTemp() { return 25.0f; }
+void attachInterrupt(uint8_t, void (*)(), int) {}
+void attachInterruptParam(uint8_t, void (*)(void*), int, void*) {}
+void detachInterrupt(uint8_t) {}
+void noInterrupts() {}
+void interrupts() {}
+
+long random(long limit) {
+    return limit > 0 ? (long)(rp2040.hwrand32() % (uint32_t)limit) : 0;
+}
+
+long random(long low, long high) {
+    return high > low ? low + random(high - low) : low;
+}
+
+// RP2040
+
+uint32_t RP2040::hwrand32() {
+    // Fixed sequence so every run draws the same jitter
+    static uint32_t state = 0x2545F491;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+size_t RP2040::getUsedHeap() {
+    return mallinfo2().uordblks;
+}
+
+size_t RP2040::getTotalHeap() {
+    return HOST_HEAP_SIZE;
+}
+
+size_t RP2040::getFreeHeap() {
+    size_t used = getUsedHeap();
+    return used < HOST_HEAP_SIZE ? HOST_HEAP_SIZE - used : 0;
+}
+
+void RP2040::restart() {
+    fprintf(stderr, "rp2040.restart() called\n");
+    exit(2);
+}
+
+uint32_t RP2040::getCycleCount() {
+    // 150 MHz
+    return (uint32_t)(hostMicros * 150);
+}
+
+// Flash and CYW43; the defaults behind PicoWiFiHAL are never used on the host
+
+void flash_range_erase(uint32_t, size_t) {}
+void flash_range_program(uint32_t, const uint8_t*, size_t) {}
+
+async_context_t* cyw43_arch_async_context() {
+    static async_context_t context;
+    return &context;
+}
+
+// WiFi: the station side is idle, the softAP always comes up
+
+int WiFiClass::begin(const char*, const char*, const uint8_t*) { return WL_CONNECT_FAILED; }
+int WiFiClass::beginNoBlock(const char*, const char*, const uint8_t*) { return WL_IDLE_STATUS; }
+bool WiFiClass::mode(WiFiMode_t mode) { _mode = mode; return true; }
+WiFiMode_t WiFiClass::getMode() { return _mode; }
+int WiFiClass::disconnect(bool) { return 0; }
+void WiFiClass::end() { _mode = WIFI_OFF; _softAP = false; }
+bool WiFiClass::config(IPAddress, IPAddress, IPAddress, IPAddress) { return true; }
+void WiFiClass::setHostname(const char*) {}
+void WiFiClass::setDNS(IPAddress, IPAddress) {}
+bool WiFiClass::softAP(const char*, const char*) { _softAP = true; return true; }
+bool WiFiClass::softAPdisconnect(bool) { _softAP = false; return true; }
+IPAddress WiFiClass::softAPIP() { return _softAP ? IPAddress(192, 168, 4, 1) : INADDR_NONE; }
+uint8_t WiFiClass::status() { return WL_DISCONNECTED; }
+IPAddress WiFiClass::localIP() { return INADDR_NONE; }
+IPAddress WiFiClass::gatewayIP() { return INADDR_NONE; }
+IPAddress WiFiClass::subnetMask() { return INADDR_NONE; }
+IPAddress WiFiClass::dnsIP(uint8_t) { return INADDR_NONE; }
+const char* WiFiClass::SSID() { return ""; }
+int32_t WiFiClass::RSSI() { return 0; }
+uint8_t WiFiClass::channel() { return 0; }
+uint8_t* WiFiClass::BSSID(uint8_t* bssid) { memset(bssid, 0, 6); return bssid; }
+String WiFiClass::macAddress() { return String("28:CD:C1:00:00:01"); }
+uint8_t* WiFiClass::macAddress(uint8_t* mac) {
+    const uint8_t address[6] = {0x28, 0xCD, 0xC1, 0x00, 0x00, 0x01};
+    memcpy(mac, address, sizeof(address));
+    return mac;
+}
+int WiFiClass::ping(IPAddress, uint8_t) { return -1; }
+int8_t WiFiClass::scanNetworks(bool) { return 0; }
+int8_t WiFiClass::scanComplete() { return 0; }
+void WiFiClass::scanDelete() {}
+const char* WiFiClass::SSID(uint8_t) { return nullptr; }
+int32_t WiFiClass::RSSI(uint8_t) { return 0; }
+uint8_t WiFiClass::channel(uint8_t) { return 0; }
+uint8_t WiFiClass::encryptionType(uint8_t) { return ENC_TYPE_NONE; }
+uint8_t* WiFiClass::BSSID(uint8_t, uint8_t* bssid) { memset(bssid, 0, 6); return bssid; }
+
+// EEPROM
+
+void EEPROMClass::begin(size_t size) {
+    _size = size < sizeof(_data) ? size : sizeof(_data);
+}
+
+// WebServer
+
+static std::deque<WebServer*> webServers;
+
+WebServer::WebServer(int port)
+    : _port(port)
+    , _running(false)
+    , _method(HTTP_GET)
+    , _contentLength(0)
+    , _responseCode(0)
+    , _client(&_body) {
+    webServers.push_front(this);
+}
+
+WebServer::~WebServer() {
+    for (auto it = webServers.begin(); it != webServers.end(); ++it) {
+        if (*it == this) {
+            webServers.erase(it);
+            break;
+        }
+    }
+}
+
+WebServer* WebServer::find(int port) {
+    for (WebServer* server : webServers) {
+        if (server->_port == port) return server;
+    }
+    return nullptr;
+}
+
+void WebServer::on(const String& uri, HTTPMethod method, THandlerFunction handler) {
+    _routes.push_back(Route{uri, method, handler});
+}
+
+String WebServer::arg(const String& name) const {
+    for (const auto& arg : _args) {
+        if (arg.first == name) return arg.second;
+    }
+    return String();
+}
+
+bool WebServer::hasArg(const String& name) const {
+    for (const auto& arg : _args) {
+        if (arg.first == name) return true;
+    }
+    return false;
+}
+
+void WebServer::setArg(const char* name, const char* value) {
+    _args.push_back(std::make_pair(String(name), String(value)));
+}
+
+void WebServer::sendHeader(const String& name, const String& value, bool first) {
+    if (first) {
+        _headers.insert(_headers.begin(), std::make_pair(name, value));
+    } else {
+        _headers.push_back(std::make_pair(name, value));
+    }
+}
+
+String WebServer::getResponseHeader(const char* name) const {
+    for (const auto& header : _headers) {
+        if (header.first == name) return header.second;
+    }
+    return String();
+}
+
+void WebServer::send(int code, const char* type, const char* content) {
+    (void)type;
+    _responseCode = code;
+    if (content) {
+        _body.append(content);
+    }
+}
+
+void WebServer::send_P(int code, PGM_P type, PGM_P content, size_t length) {
+    (void)type;
+    _responseCode = code;
+    _body.append(content, length);
+}
+
+void WebServer::sendContent(const char* content, size_t length) {
+    _body.append(content, length);
+}
+
+bool WebServer::request(HTTPMethod method, const char* uri) {
+    _uri = uri;
+    _method = method;
+    _contentLength = 0;
+    _responseCode = 0;
+    _body.clear();
+    _headers.clear();
+
+    for (const Route& route : _routes) {
+        if (route.uri == uri && (route.method == HTTP_ANY || route.method == method)) {
+            route.handler();
+            return true;
+        }
+    }
+    if (_notFound) {
+        _notFound();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,32 @@
+/**
+ * HostStubs - Test hooks of the host stand-ins
+ *
+ * The stand-in headers in this directory replace the arduino-pico core and
+ * Pico SDK so the library builds on a PC. These hooks let a host test
+ * steer what the hardware would have done.
+ */
+
+#ifndef HOST_STUBS_H
+#define HOST_STUBS_H
+
+#include <Arduino.h>
+
+// Virtual time shared by millis(), micros(), delay() and delayMicroseconds()
+class HostClock {
+public:
+    // Every millis()/micros() read moves time on by this much
+    static const uint32_t TICK_MICROS = 10;
+
+    static uint64_t now();
+    static void advance(uint64_t micros);
+};
+
+class HostSerial {
+public:
+    // Bytes returned by Serial.read() from now on
+    static void feed(const char* text);
+    // Output is written to stdout unless silenced
+    static void setQuiet(bool quiet);
+};
+
+#endif // HOST_STUBS_H
@@ -0,0 +1,93 @@
+/**
+ * WebServer - Host stand-in for arduino-pico's WebServer
+ *
+ * Keeps the registered routes and runs them on request() instead of
+ * listening on a socket, recording what the handler sent:
+ *
+ *     WebServer* server = WebServer::find(80);
+ *     server->request(HTTP_GET, "/scan");
+ *     server->getResponseCode();   // 200
+ *
+ * Arguments for the handler are set with setArg() before the request.
+ */
+
+#ifndef HOST_WEBSERVER_H
+#define HOST_WEBSERVER_H
+
+#include <WiFi.h>
+#include <vector>
+
+enum HTTPMethod { HTTP_ANY, HTTP_GET, HTTP_HEAD, HTTP_POST, HTTP_PUT, HTTP_PATCH, HTTP_DELETE, HTTP_OPTIONS };
+
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+public:
+    typedef std::function<void(void)> THandlerFunction;
+
+    explicit WebServer(int port = 80);
+    ~WebServer();
+
+    void begin() { _running = true; }
+    void stop() { _running = false; }
+    void close() { _running = false; }
+    void handleClient() {}
+
+    void on(const String& uri, THandlerFunction handler) { on(uri, HTTP_ANY, handler); }
+    void on(const String& uri, HTTPMethod method, THandlerFunction handler);
+    void onNotFound(THandlerFunction handler) { _notFound = handler; }
+
+    // Request being handled
+    String uri() const { return _uri; }
+    HTTPMethod method() const { return _method; }
+    String arg(const String& name) const;
+    bool hasArg(const String& name) const;
+    String header(const String& name) const { (void)name; return String(); }
+    void collectHeaders(const char** names, size_t count) { (void)names; (void)count; }
+    WiFiClient& client() { return _client; }
+
+    // Response
+    void setContentLength(size_t length) { _contentLength = length; }
+    void sendHeader(const String& name, const String& value, bool first = false);
+    void send(int code, const char* type = nullptr, const char* content = nullptr);
+    void send(int code, const char* type, const String& content) { send(code, type, content.c_str()); }
+    void send(int code, const String& type, const String& content) { send(code, type.c_str(), content.c_str()); }
+    void send_P(int code, PGM_P type, PGM_P content) { send(code, type, content); }
+    void send_P(int code, PGM_P type, PGM_P content, size_t length);
+    void sendContent(const char* content, size_t length);
+    void sendContent(const String& content) { sendContent(content.c_str(), content.length()); }
+    void sendContent_P(PGM_P content, size_t length) { sendContent(content, length); }
+
+    // Host test hooks
+    static WebServer* find(int port);  // Most recently created server on port
+    bool isRunning() const { return _running; }
+    void setArg(const char* name, const char* value);
+    void clearArgs() { _args.clear(); }
+    bool request(HTTPMethod method, const char* uri);  // false if nothing handled it
+    int getResponseCode() const { return _responseCode; }
+    const std::string& getResponseBody() const { return _body; }
+    size_t getResponseBytes() const { return _body.size(); }
+    String getResponseHeader(const char* name) const;
+
+private:
+    struct Route {
+        String uri;
+        HTTPMethod method;
+        THandlerFunction handler;
+    };
+
+    int _port;
+    bool _running;
+    std::vector<Route> _routes;
+    THandlerFunction _notFound;
+    std::vector<std::pair<String, String>> _args;
+    std::vector<std::pair<String, String>> _headers;
+    String _uri;
+    HTTPMethod _method;
+    size_t _contentLength;
+    int _responseCode;
+    std::string _body;
+    WiFiClient _client;
+};
+
+#endif // HOST_WEBSERVER_H
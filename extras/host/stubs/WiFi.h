@@ -0,0 +1,106 @@
+/**
+ * WiFi - Host stand-in for arduino-pico's WiFi library
+ *
+ * The library reaches the station side through PicoWiFiHAL, which the host
+ * tests point at SimulatedWiFiDriver. What is left here is the softAP side
+ * of the portal, which always comes up at 192.168.4.1, and idle
+ * implementations behind CYW43WiFiDriver.
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum {
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL,
+    WL_SCAN_COMPLETED,
+    WL_CONNECTED,
+    WL_CONNECT_FAILED,
+    WL_CONNECTION_LOST,
+    WL_DISCONNECTED
+} wl_status_t;
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1, WIFI_AP = 2, WIFI_AP_STA = 3 } WiFiMode_t;
+
+enum { ENC_TYPE_TKIP = 2, ENC_TYPE_CCMP = 4, ENC_TYPE_WEP = 5, ENC_TYPE_NONE = 7, ENC_TYPE_AUTO = 8 };
+
+#define WIFI_SCAN_RUNNING (-1)
+#define WIFI_SCAN_FAILED (-2)
+
+class WiFiClass {
+public:
+    int begin(const char* ssid, const char* password = nullptr, const uint8_t* bssid = nullptr);
+    int beginNoBlock(const char* ssid, const char* password = nullptr, const uint8_t* bssid = nullptr);
+    bool mode(WiFiMode_t mode);
+    WiFiMode_t getMode();
+    int disconnect(bool wifiOff = false);
+    void end();
+    bool config(IPAddress ip, IPAddress dns, IPAddress gateway, IPAddress subnet);
+    void setHostname(const char* name);
+    void setDNS(IPAddress primary, IPAddress secondary = INADDR_NONE);
+    void lowPowerMode() {}
+    void noLowPowerMode() {}
+
+    bool softAP(const char* ssid, const char* password = nullptr);
+    bool softAPdisconnect(bool wifiOff = false);
+    IPAddress softAPIP();
+
+    uint8_t status();
+    bool connected() { return status() == WL_CONNECTED; }
+    IPAddress localIP();
+    IPAddress gatewayIP();
+    IPAddress subnetMask();
+    IPAddress dnsIP(uint8_t index = 0);
+    const char* SSID();
+    int32_t RSSI();
+    uint8_t channel();
+    uint8_t* BSSID(uint8_t* bssid);
+    String macAddress();
+    uint8_t* macAddress(uint8_t* mac);
+    int ping(IPAddress host, uint8_t ttl = 128);
+
+    int8_t scanNetworks(bool async = false);
+    int8_t scanComplete();
+    void scanDelete();
+    const char* SSID(uint8_t index);
+    int32_t RSSI(uint8_t index);
+    uint8_t channel(uint8_t index);
+    uint8_t encryptionType(uint8_t index);
+    uint8_t* BSSID(uint8_t index, uint8_t* bssid);
+
+private:
+    WiFiMode_t _mode = WIFI_OFF;
+    bool _softAP = false;
+};
+
+extern WiFiClass WiFi;
+
+// No network: connect() fails, and writes go to the WebServer response
+// when the client came from WebServer::client()
+class WiFiClient : public Stream {
+public:
+    WiFiClient() : _sink(nullptr) {}
+    explicit WiFiClient(std::string* sink) : _sink(sink) {}
+
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t* data, size_t length) override {
+        if (_sink) _sink->append((const char*)data, length);
+        return length;
+    }
+    using Print::write;
+
+    int connect(const char* host, uint16_t port) { (void)host; (void)port; return 0; }
+    int connect(IPAddress ip, uint16_t port) { (void)ip; (void)port; return 0; }
+    bool connected() { return _sink != nullptr; }
+    void stop() {}
+    void setNoDelay(bool) {}
+    IPAddress remoteIP() { return IPAddress(192, 168, 4, 2); }
+
+private:
+    std::string* _sink;
+};
+
+#endif // HOST_WIFI_H
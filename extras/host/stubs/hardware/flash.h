@@ -0,0 +1,19 @@
+/**
+ * hardware/flash - Host stand-in for the Pico SDK flash geometry
+ */
+
+#ifndef HOST_HARDWARE_FLASH_H
+#define HOST_HARDWARE_FLASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define FLASH_PAGE_SIZE (1u << 8)
+#define XIP_BASE 0x10000000
+
+// Never reached on the host: the tests install SimulatedFlashDriver
+void flash_range_erase(uint32_t offset, size_t count);
+void flash_range_program(uint32_t offset, const uint8_t* data, size_t count);
+
+#endif // HOST_HARDWARE_FLASH_H
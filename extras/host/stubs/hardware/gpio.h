@@ -0,0 +1,16 @@
+/**
+ * hardware/gpio - Host stand-in
+ */
+
+#ifndef HOST_HARDWARE_GPIO_H
+#define HOST_HARDWARE_GPIO_H
+
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+enum gpio_function { GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5 };
+
+inline void gpio_set_function(uint gpio, enum gpio_function function) { (void)gpio; (void)function; }
+
+#endif // HOST_HARDWARE_GPIO_H
@@ -0,0 +1,15 @@
+/**
+ * hardware/pwm - Host stand-in; the LED goes nowhere
+ */
+
+#ifndef HOST_HARDWARE_PWM_H
+#define HOST_HARDWARE_PWM_H
+
+#include <hardware/gpio.h>
+
+inline uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) & 7; }
+inline void pwm_set_wrap(uint slice, uint16_t wrap) { (void)slice; (void)wrap; }
+inline void pwm_set_enabled(uint slice, bool enabled) { (void)slice; (void)enabled; }
+inline void pwm_set_gpio_level(uint gpio, uint16_t level) { (void)gpio; (void)level; }
+
+#endif // HOST_HARDWARE_PWM_H
@@ -0,0 +1,13 @@
+/**
+ * hardware/sync - Host stand-in; the host has nothing to mask
+ */
+
+#ifndef HOST_HARDWARE_SYNC_H
+#define HOST_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+inline uint32_t save_and_disable_interrupts() { return 0; }
+inline void restore_interrupts(uint32_t status) { (void)status; }
+
+#endif // HOST_HARDWARE_SYNC_H
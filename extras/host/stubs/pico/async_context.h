@@ -0,0 +1,30 @@
+/**
+ * pico/async_context - Host stand-in; workers are accepted but never run
+ */
+
+#ifndef HOST_PICO_ASYNC_CONTEXT_H
+#define HOST_PICO_ASYNC_CONTEXT_H
+
+#include <stdint.h>
+
+typedef struct async_context {
+    int unused;
+} async_context_t;
+
+typedef struct async_work_on_timeout {
+    void (*do_work)(async_context_t* context, struct async_work_on_timeout* worker);
+    uint64_t next_time;
+    void* user_data;
+} async_at_time_worker_t;
+
+inline bool async_context_add_at_time_worker_in_ms(async_context_t* context, async_at_time_worker_t* worker,
+                                                   uint32_t ms) {
+    (void)context; (void)worker; (void)ms;
+    return true;
+}
+inline bool async_context_remove_at_time_worker(async_context_t* context, async_at_time_worker_t* worker) {
+    (void)context; (void)worker;
+    return true;
+}
+
+#endif // HOST_PICO_ASYNC_CONTEXT_H
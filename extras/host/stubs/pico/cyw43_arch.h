@@ -0,0 +1,68 @@
+/**
+ * pico/cyw43_arch - Host stand-in for the CYW43 driver
+ *
+ * The host tests use SimulatedWiFiDriver; only the power-save call and the
+ * types behind CYW43WiFiDriver are needed. Scans fail and cyw43_wifi_pm()
+ * stores the value for HostStubs.h.
+ */
+
+#ifndef HOST_PICO_CYW43_ARCH_H
+#define HOST_PICO_CYW43_ARCH_H
+
+#include <stdint.h>
+#include <pico/async_context.h>
+
+#define CYW43_ITF_STA 0
+#define CYW43_ITF_AP 1
+#define CYW43_WL_GPIO_LED_PIN 0
+
+#define CYW43_NO_POWERSAVE_MODE 0
+#define CYW43_PM1_POWERSAVE_MODE 1
+#define CYW43_PM2_POWERSAVE_MODE 2
+
+#define cyw43_pm_value(pm_mode, pm2_sleep_ret_ms, li_beacon_period, li_dtim_period, li_assoc) \
+    (((li_assoc) << 20) | ((li_dtim_period) << 16) | ((li_beacon_period) << 12) | \
+     (((pm2_sleep_ret_ms) / 10) << 4) | (pm_mode))
+
+#define CYW43_DEFAULT_PM cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, 200, 1, 1, 10)
+#define CYW43_PERFORMANCE_PM cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, 20, 1, 1, 1)
+#define CYW43_AGGRESSIVE_PM cyw43_pm_value(CYW43_PM2_POWERSAVE_MODE, 2000, 1, 1, 10)
+#define CYW43_NONE_PM cyw43_pm_value(CYW43_NO_POWERSAVE_MODE, 10, 0, 0, 0)
+
+typedef struct {
+    uint32_t pm;
+} cyw43_t;
+
+typedef struct {
+    uint8_t bssid[6];
+    uint16_t channel;
+    uint8_t auth_mode;
+    int16_t rssi;
+    uint8_t ssid_len;
+    uint8_t ssid[32];
+} cyw43_ev_scan_result_t;
+
+typedef struct {
+    uint32_t ssid_len;
+    uint8_t ssid[32];
+    int32_t scan_type;
+} cyw43_wifi_scan_options_t;
+
+extern cyw43_t cyw43_state;
+
+inline int cyw43_wifi_pm(cyw43_t* self, uint32_t pm) {
+    self->pm = pm;
+    return 0;
+}
+inline int cyw43_wifi_scan(cyw43_t* self, cyw43_wifi_scan_options_t* options, void* env,
+                           int (*callback)(void*, const cyw43_ev_scan_result_t*)) {
+    (void)self; (void)options; (void)env; (void)callback;
+    return -1;
+}
+inline bool cyw43_wifi_scan_active(cyw43_t* self) { (void)self; return false; }
+inline void cyw43_arch_lwip_begin() {}
+inline void cyw43_arch_lwip_end() {}
+inline void cyw43_arch_gpio_put(unsigned int pin, bool value) { (void)pin; (void)value; }
+async_context_t* cyw43_arch_async_context();
+
+#endif // HOST_PICO_CYW43_ARCH_H
@@ -0,0 +1,23 @@
+/**
+ * pico/multicore - Host stand-in with a single core
+ *
+ * Core 1 never starts, so the host tests run the library single-core.
+ */
+
+#ifndef HOST_PICO_MULTICORE_H
+#define HOST_PICO_MULTICORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pico/stdlib.h>
+
+inline void multicore_launch_core1_with_stack(void (*entry)(void), uint32_t* stack, size_t size) {
+    (void)entry; (void)stack; (void)size;
+}
+inline void multicore_reset_core1() {}
+inline void multicore_lockout_victim_init() {}
+inline bool multicore_lockout_victim_is_initialized(unsigned int core) { (void)core; return false; }
+inline void multicore_lockout_start_blocking() {}
+inline void multicore_lockout_end_blocking() {}
+
+#endif // HOST_PICO_MULTICORE_H
@@ -0,0 +1,15 @@
+/**
+ * pico/stdlib - Host stand-in; everything runs on "core 0"
+ */
+
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+#include <stdint.h>
+
+inline uint32_t get_core_num() { return 0; }
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+inline void tight_loop_contents() {}
+
+#endif // HOST_PICO_STDLIB_H
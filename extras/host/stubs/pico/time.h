@@ -0,0 +1,35 @@
+/**
+ * pico/time - Host stand-in; alarms and repeating timers never fire
+ */
+
+#ifndef HOST_PICO_TIME_H
+#define HOST_PICO_TIME_H
+
+#include <stdint.h>
+
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void* user_data);
+
+typedef struct repeating_timer {
+    int64_t delay_us;
+    void* user_data;
+} repeating_timer_t;
+
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* timer);
+
+inline alarm_id_t add_alarm_in_ms(uint32_t ms, alarm_callback_t callback, void* user_data, bool fire_if_past) {
+    (void)ms; (void)callback; (void)user_data; (void)fire_if_past;
+    return 1;
+}
+inline bool cancel_alarm(alarm_id_t id) { (void)id; return true; }
+
+inline bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void* user_data,
+                                   repeating_timer_t* timer) {
+    (void)callback;
+    timer->delay_us = (int64_t)delay_ms * 1000;
+    timer->user_data = user_data;
+    return true;
+}
+inline bool cancel_repeating_timer(repeating_timer_t* timer) { (void)timer; return true; }
+
+#endif // HOST_PICO_TIME_H
@@ -0,0 +1,52 @@
+/**
+ * pico/util/queue - Host stand-in: a fixed-size FIFO, no locking
+ */
+
+#ifndef HOST_PICO_UTIL_QUEUE_H
+#define HOST_PICO_UTIL_QUEUE_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint8_t* data;
+    unsigned int elementSize;
+    unsigned int capacity;
+    unsigned int head;
+    unsigned int count;
+} queue_t;
+
+inline void queue_init(queue_t* queue, unsigned int element_size, unsigned int element_count) {
+    queue->data = (uint8_t*)calloc(element_count, element_size);
+    queue->elementSize = element_size;
+    queue->capacity = element_count;
+    queue->head = 0;
+    queue->count = 0;
+}
+
+inline void queue_free(queue_t* queue) {
+    free(queue->data);
+    queue->data = nullptr;
+    queue->count = 0;
+}
+
+inline bool queue_is_empty(queue_t* queue) { return queue->count == 0; }
+
+inline bool queue_try_add(queue_t* queue, const void* data) {
+    if (queue->count == queue->capacity) return false;
+    unsigned int slot = (queue->head + queue->count) % queue->capacity;
+    memcpy(queue->data + slot * queue->elementSize, data, queue->elementSize);
+    queue->count++;
+    return true;
+}
+
+inline bool queue_try_remove(queue_t* queue, void* data) {
+    if (queue->count == 0) return false;
+    memcpy(data, queue->data + queue->head * queue->elementSize, queue->elementSize);
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    return true;
+}
+
+#endif // HOST_PICO_UTIL_QUEUE_H
@@ -0,0 +1,133 @@
+/**
+ * Portal latency - every portal route driven through the stubbed WebServer
+ *
+ * Each request runs the real ConfigPortal handler and ChunkedResponse; the
+ * handler time is taken on the host CPU. Then credentials are submitted
+ * through /connect and followed to a connection on the simulated radio.
+ */
+
+#include "HostTest.h"
+#include "PicoWiFiManager.h"
+#include "SimulatedWiFi.h"
+#include "SimulatedStorage.h"
+#include <WebServer.h>
+#include <chrono>
+
+static const char* TEST_SSID = "HostNet";
+static const char* TEST_PASSWORD = "hostpass";
+static const uint16_t REQUESTS = 200;
+static const uint32_t TIMEOUT_MS = 60000;
+
+// Loose for a PC: catches handlers that start to block or wait
+static const uint32_t P95_LIMIT_US = 2000;
+
+static SimulatedWiFiDriver radio;
+
+alignas(FLASH_SECTOR_SIZE) static uint8_t flashRegion[6 * FLASH_SECTOR_SIZE];
+static SimulatedFlashDriver flash(flashRegion, sizeof(flashRegion));
+
+static uint8_t eepromStored[STORAGE_EEPROM_SIZE];
+static uint8_t eepromImage[STORAGE_EEPROM_SIZE];
+static SimulatedEEPROMDriver eeprom(eepromStored, eepromImage, sizeof(eepromStored));
+
+struct Route {
+    const char* uri;
+    bool redirect;     // Answered with the raw 302 written to the client
+};
+
+static const Route ROUTES[] = {
+    {"/", false},
+    {"/portal.css", false},
+    {"/portal.js", false},
+    {"/state.json", false},
+    {"/result.json", false},
+    {"/info", false},
+    {"/generate_204", true},
+    {"/hotspot-detect.html", true},
+    {"/favicon.ico", true},
+};
+
+static bool answered(WebServer& server, const Route& route) {
+    if (route.redirect) {
+        return server.getResponseBody().compare(0, 12, "HTTP/1.1 302") == 0;
+    }
+    return server.getResponseCode() == 200 && server.getResponseBytes() > 0;
+}
+
+static void runFor(PicoWiFiManager& wifi, uint32_t ms) {
+    uint32_t start = millis();
+    while (millis() - start < ms) {
+        wifi.loop();
+    }
+}
+
+int main() {
+    HostSerial::setQuiet(true);
+    PicoWiFiHAL::setWiFiDriver(&radio);
+    PicoWiFiHAL::setFlashDriver(&flash);
+    PicoWiFiHAL::setEEPROMDriver(&eeprom);
+
+    radio.addAccessPoint(TEST_SSID, TEST_PASSWORD, 6, -55);
+    radio.addAccessPoint("Neighbour", "other", 1, -72);
+    radio.addAccessPoint("Cafe", "", 11, -80);
+
+    PicoWiFiConfig config;
+    config.enableSerial = false;
+    config.resetPin = 255;
+    PicoWiFiManager wifi(config);
+    HostTest::check(wifi.begin(), "manager starts on the simulated drivers");
+    HostTest::check(wifi.startConfigPortal("PicoSetup"), "portal starts");
+
+    WebServer* server = WebServer::find(80);
+    if (!HostTest::check(server != nullptr && server->isRunning(), "portal web server is listening")) {
+        return HostTest::finish();
+    }
+
+    // Let the first background scan land so /state.json has networks to list
+    runFor(wifi, 5000);
+
+    printf("| Route | Bytes | Avg us | p95 us | Max us |\n");
+    printf("|-------|-------|--------|--------|--------|\n");
+    for (const Route& route : ROUTES) {
+        LatencyHistogram latency;
+        bool ok = true;
+        for (uint16_t i = 0; i < REQUESTS; i++) {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            ok = server->request(HTTP_GET, route.uri) && ok;
+            latency.add((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count());
+            ok = answered(*server, route) && ok;
+        }
+        printf("| %s | %lu | %lu | %lu | %lu |\n", route.uri, (unsigned long)server->getResponseBytes(),
+               (unsigned long)latency.getAverage(), (unsigned long)latency.getPercentile(95),
+               (unsigned long)latency.getMax());
+
+        HostTest::check(ok, "%s answered every request", route.uri);
+        HostTest::check(latency.getPercentile(95) <= P95_LIMIT_US, "%s p95 %lu us (limit %lu)", route.uri,
+                        (unsigned long)latency.getPercentile(95), (unsigned long)P95_LIMIT_US);
+    }
+
+    server->request(HTTP_GET, "/state.json");
+    HostTest::check(server->getResponseBody().find(TEST_SSID) != std::string::npos,
+                    "/state.json lists the scanned networks");
+
+    // Provisioning: submit, then follow /result.json until the join is done
+    server->clearArgs();
+    server->setArg("ssid", TEST_SSID);
+    server->setArg("password", TEST_PASSWORD);
+    server->request(HTTP_POST, "/connect");
+    server->clearArgs();
+    HostTest::check(server->getResponseCode() == 200, "/connect accepts the credentials");
+
+    uint32_t start = millis();
+    bool connected = false;
+    while (!connected && millis() - start < TIMEOUT_MS) {
+        runFor(wifi, 100);
+        server->request(HTTP_GET, "/result.json");
+        connected = server->getResponseBody().find("\"connected\"") != std::string::npos;
+    }
+    HostTest::check(connected && wifi.isConnected(), "provisioned through the portal in %lu ms",
+                    (unsigned long)(millis() - start));
+
+    return HostTest::finish();
+}
@@ -0,0 +1,137 @@
+/**
+ * Power-loss sweep - cuts the power at every flash operation of one save
+ *
+ * The next boot has to find the old or the new state. Defaults mean the
+ * save lost data, which fails the power-fail atomic backends; EEPROM
+ * emulation rewrites its only sector in place and is reported, not judged.
+ */
+
+#include "HostTest.h"
+#include "StorageManager.h"
+#include "SimulatedStorage.h"
+
+alignas(FLASH_SECTOR_SIZE) static uint8_t flashRegion[6 * FLASH_SECTOR_SIZE];
+static SimulatedFlashDriver flash(flashRegion, sizeof(flashRegion));
+
+static uint8_t eepromStored[STORAGE_EEPROM_SIZE];
+static uint8_t eepromImage[STORAGE_EEPROM_SIZE];
+static SimulatedEEPROMDriver eeprom(eepromStored, eepromImage, sizeof(eepromStored));
+
+struct SweepResult {
+    uint32_t operations = 0;
+    uint32_t kept = 0;
+    uint32_t updated = 0;
+    uint32_t lost = 0;
+};
+
+static const char* backendName(StorageBackend backend) {
+    switch (backend) {
+        case StorageBackend::DUAL_BANK: return "DUAL_BANK";
+        case StorageBackend::FLASH_LOG: return "FLASH_LOG";
+        case StorageBackend::AUTO: return "AUTO";
+        default: return "EEPROM_EMULATION";
+    }
+}
+
+static void wipeStorage() {
+    flash.wipe();
+    flash.powerCycle();
+    eeprom.wipe();
+    eeprom.powerCycle();
+}
+
+static uint32_t flashOperations() {
+    const SimulatedFlashStats& a = flash.getStats();
+    const SimulatedFlashStats& b = eeprom.getStats();
+    return a.erases + a.programs + b.erases + b.programs;
+}
+
+static bool saveHostname(StorageManager& storage, const char* hostname) {
+    DeviceConfig device;
+    storage.loadDeviceConfig(device);
+    strncpy(device.hostname, hostname, sizeof(device.hostname) - 1);
+    device.hostname[sizeof(device.hostname) - 1] = '\0';
+    return storage.saveDeviceConfig(device);
+}
+
+static SweepResult sweep(StorageBackend backend) {
+    SweepResult result;
+
+    // How many operations one save takes
+    wipeStorage();
+    {
+        StorageManager storage;
+        storage.begin(STORAGE_EEPROM_SIZE, backend);
+        saveHostname(storage, "state-old");
+        uint32_t before = flashOperations();
+        saveHostname(storage, "state-new");
+        result.operations = flashOperations() - before;
+    }
+
+    for (uint32_t cut = 0; cut < result.operations; cut++) {
+        wipeStorage();
+        {
+            StorageManager storage;
+            storage.begin(STORAGE_EEPROM_SIZE, backend);
+            saveHostname(storage, "state-old");
+
+            flash.failAfter(cut);
+            eeprom.failAfter(cut);
+            saveHostname(storage, "state-new");
+        }
+        flash.powerCycle();
+        eeprom.powerCycle();
+
+        StorageManager storage;
+        storage.begin(STORAGE_EEPROM_SIZE, backend);
+        DeviceConfig device;
+        storage.loadDeviceConfig(device);
+        if (strcmp(device.hostname, "state-old") == 0) {
+            result.kept++;
+        } else if (strcmp(device.hostname, "state-new") == 0) {
+            result.updated++;
+        } else {
+            result.lost++;
+        }
+    }
+    return result;
+}
+
+int main() {
+    HostSerial::setQuiet(true);
+    PicoWiFiHAL::setFlashDriver(&flash);
+    PicoWiFiHAL::setEEPROMDriver(&eeprom);
+
+    // The sweep repeats the save many times; flash timing adds nothing here
+    SimulatedFlashTiming instant;
+    instant.eraseMicros = 0;
+    instant.programMicros = 0;
+    flash.setTiming(instant);
+    eeprom.setTiming(instant);
+
+    const StorageBackend backends[] = {
+        StorageBackend::DUAL_BANK, StorageBackend::FLASH_LOG, StorageBackend::AUTO,
+        StorageBackend::EEPROM_EMULATION
+    };
+    for (StorageBackend backend : backends) {
+        SweepResult result = sweep(backend);
+        printf("%s: %lu cut points, old kept %lu, new kept %lu, lost %lu\n", backendName(backend),
+               (unsigned long)result.operations, (unsigned long)result.kept,
+               (unsigned long)result.updated, (unsigned long)result.lost);
+
+        if (backend == StorageBackend::EEPROM_EMULATION) {
+            continue;
+        }
+        HostTest::check(result.operations > 0, "%s: a save reaches the flash", backendName(backend));
+        HostTest::check(result.lost == 0, "%s: no cut point loses the stored state", backendName(backend));
+    }
+
+    // AUTO has to land on the banks when the region is free
+    wipeStorage();
+    StorageManager storage;
+    storage.begin(STORAGE_EEPROM_SIZE, StorageBackend::AUTO);
+    HostTest::check(storage.getBackend() == StorageBackend::DUAL_BANK,
+                    "AUTO picks DUAL_BANK on erased flash");
+
+    return HostTest::finish();
+}
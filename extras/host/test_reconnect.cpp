@@ -0,0 +1,110 @@
+/**
+ * Reconnect - link loss to back online, through the fast-connect cache and
+ * through the full-connect fallback
+ *
+ * Limits follow from the scripted latencies: a fast reconnect is the radio
+ * settle, a pinned join and DHCP; the fallback adds the rejected pinned
+ * join and a full join.
+ */
+
+#include "HostTest.h"
+#include "PicoWiFiManager.h"
+#include "SimulatedWiFi.h"
+#include "SimulatedStorage.h"
+
+static const char* TEST_SSID = "HostNet";
+static const char* TEST_PASSWORD = "hostpass";
+static const uint8_t RUNS = 5;
+static const uint32_t TIMEOUT_MS = 60000;
+
+// PicoWiFiManager's radio settle before every join
+static const uint32_t SETTLE_MS = 100;
+// Slack for loop() passes and state changes between the scripted steps
+static const uint32_t SLACK_MS = 250;
+
+static SimulatedWiFiDriver radio;
+
+alignas(FLASH_SECTOR_SIZE) static uint8_t flashRegion[6 * FLASH_SECTOR_SIZE];
+static SimulatedFlashDriver flash(flashRegion, sizeof(flashRegion));
+
+static uint8_t eepromStored[STORAGE_EEPROM_SIZE];
+static uint8_t eepromImage[STORAGE_EEPROM_SIZE];
+static SimulatedEEPROMDriver eeprom(eepromStored, eepromImage, sizeof(eepromStored));
+
+static bool waitConnected(PicoWiFiManager& wifi, uint32_t& elapsed) {
+    uint32_t start = millis();
+    while (!wifi.isConnected() && millis() - start < TIMEOUT_MS) {
+        wifi.loop();
+    }
+    elapsed = millis() - start;
+    return wifi.isConnected();
+}
+
+int main() {
+    HostSerial::setQuiet(true);
+    PicoWiFiHAL::setWiFiDriver(&radio);
+    PicoWiFiHAL::setFlashDriver(&flash);
+    PicoWiFiHAL::setEEPROMDriver(&eeprom);
+
+    radio.addAccessPoint(TEST_SSID, TEST_PASSWORD, 6, -55);
+    radio.addAccessPoint(TEST_SSID, TEST_PASSWORD, 11, -70);
+
+    // The saved network is in storage before the manager starts, as after a reboot
+    {
+        StorageManager seed;
+        seed.begin();
+        seed.saveWiFiCredentials(TEST_SSID, TEST_PASSWORD);
+    }
+
+    PicoWiFiConfig config;
+    config.enableSerial = false;
+    config.resetPin = 255;
+    PicoWiFiManager wifi(config);
+    HostTest::check(wifi.begin(), "manager starts on the simulated drivers");
+
+    const SimulatedRadioTiming& timing = radio.getTiming();
+    const ReconnectPolicy& policy = config.reconnectPolicy;
+    uint32_t firstAttempt = policy.initialDelay + policy.initialDelay * policy.jitterPercent / 100;
+    uint32_t fastLimit = SETTLE_MS + timing.pinnedLatency + timing.dhcpLatency + SLACK_MS;
+    uint32_t fallbackLimit = fastLimit + timing.pinnedLatency + timing.connectLatency + timing.dhcpLatency;
+    uint32_t fullLimit = SETTLE_MS + timing.connectLatency + timing.dhcpLatency + SLACK_MS;
+
+    wifi.connectAsync();
+    uint32_t elapsed = 0;
+    bool connected = waitConnected(wifi, elapsed);
+    HostTest::check(connected && wifi.getLastConnectDuration() <= fullLimit, "first connect %lu ms (limit %lu)",
+                    (unsigned long)wifi.getLastConnectDuration(), (unsigned long)fullLimit);
+
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        bool fallback = pass == 1;
+        const char* name = fallback ? "cached AP rejects" : "AP reboot";
+        uint32_t limit = fallback ? fallbackLimit : fastLimit;
+
+        for (uint8_t run = 1; run <= RUNS; run++) {
+            if (fallback) {
+                // The fast connect fails, so the fallback full connect is timed
+                radio.failNextConnects(1);
+            }
+            radio.dropLink();
+
+            connected = waitConnected(wifi, elapsed);
+            uint32_t took = wifi.getLastConnectDuration();
+            HostTest::check(connected, "%s %u: back online after %lu ms", name, run, (unsigned long)elapsed);
+            if (!connected) continue;
+
+            HostTest::check(wifi.wasFastConnect() != fallback, "%s %u: %s path", name, run,
+                            wifi.wasFastConnect() ? "fast" : "full");
+            HostTest::check(took <= limit, "%s %u: connect %lu ms (limit %lu)", name, run,
+                            (unsigned long)took, (unsigned long)limit);
+            HostTest::check(elapsed <= firstAttempt + limit + SLACK_MS, "%s %u: outage %lu ms (limit %lu)", name,
+                            run, (unsigned long)elapsed, (unsigned long)(firstAttempt + limit + SLACK_MS));
+        }
+    }
+
+    ReconnectStats stats = wifi.getReconnectStats();
+    HostTest::check(stats.recoveries == 2 * RUNS, "every outage recovered (%lu of %lu)",
+                    (unsigned long)stats.recoveries, (unsigned long)stats.linkLosses);
+    HostTest::check(stats.portalFallbacks == 0, "no portal fallback");
+
+    return HostTest::finish();
+}
@@ -0,0 +1,76 @@
+/**
+ * Scan processing - background and blocking scans over growing AP counts
+ *
+ * The simulated scan completes at once, so what is timed is the library's
+ * own work on the results, on the host CPU. Both paths have to produce the
+ * same list: one entry per SSID, its strongest BSSID, capped at maxResults.
+ */
+
+#include "HostTest.h"
+#include "NetworkScanner.h"
+#include "SimulatedWiFi.h"
+#include <chrono>
+
+// Loose for a PC: catches processing that starts to block or wait, not small slowdowns
+static const uint32_t PROCESSING_LIMIT_US = 5000;
+
+static SimulatedWiFiDriver radio;
+
+static uint32_t hostMicros(std::chrono::steady_clock::time_point since) {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+int main() {
+    HostSerial::setQuiet(true);
+    PicoWiFiHAL::setWiFiDriver(&radio);
+
+    SimulatedRadioTiming instant = radio.getTiming();
+    instant.scanLatency = 0;
+    radio.setTiming(instant);
+
+    NetworkScanner scanner;
+    radio.setMode(WIFI_STA);
+
+    const uint8_t counts[] = {8, 16, 32, 48};
+    for (uint8_t count : counts) {
+        radio.clearAccessPoints();
+        for (uint8_t i = 0; i < count; i++) {
+            // A few ESSes with several APs each, spread over the channels
+            char ssid[16];
+            snprintf(ssid, sizeof(ssid), "Net%02u", i / 3);
+            radio.addAccessPoint(ssid, "password", 1 + (i * 5) % 11, -40 - (i * 7) % 50);
+        }
+        int essCount = (count + 2) / 3;
+        int expected = essCount < scanner.getConfig().maxResults ? essCount : scanner.getConfig().maxResults;
+
+        scanner.clearCache();
+        bool started = scanner.startAsyncScan();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        scanner.update();
+        uint32_t async = hostMicros(start);
+        int asyncCount = scanner.getNetworkCount();
+
+        // The strongest AP of Net00 is the first one added
+        ScannedNetwork best;
+        bool found = scanner.findNetwork("Net00", best);
+
+        start = std::chrono::steady_clock::now();
+        bool blocking = scanner.startScan();
+        uint32_t blockingTime = hostMicros(start);
+        int blockingCount = scanner.getNetworkCount();
+
+        printf("%u APs: async %lu us, blocking %lu us, %d networks\n", count, (unsigned long)async,
+               (unsigned long)blockingTime, blockingCount);
+        HostTest::check(started && asyncCount == expected, "%u APs: background scan lists %d of %d networks",
+                        count, asyncCount, expected);
+        HostTest::check(blocking && blockingCount == expected, "%u APs: blocking scan lists %d of %d networks",
+                        count, blockingCount, expected);
+        HostTest::check(found && best.rssi == -40 && best.channel == 1,
+                        "%u APs: strongest BSSID kept per SSID (%d dBm, ch %u)", count, best.rssi, best.channel);
+        HostTest::check(async <= PROCESSING_LIMIT_US && blockingTime <= PROCESSING_LIMIT_US,
+                        "%u APs: processing within %lu us", count, (unsigned long)PROCESSING_LIMIT_US);
+    }
+
+    return HostTest::finish();
+}
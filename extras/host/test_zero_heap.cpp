@@ -0,0 +1,151 @@
+/**
+ * Zero heap - the connected loop() path of a PICOWIFI_STATIC_ALLOCATION
+ * build makes no allocations
+ *
+ * The ZeroHeap example on the host: instead of a live access point the
+ * manager runs against the simulated radio, and instead of mallinfo() alone
+ * every operator new and every malloc(), calloc() and realloc() is counted.
+ * The C allocators are reached through the linker's --wrap, as in the
+ * arduino-pico core, so calls from the library's C code are seen too.
+ */
+
+#include "HostTest.h"
+#include "PicoWiFiManager.h"
+#include "SimulatedWiFi.h"
+#include "SimulatedStorage.h"
+#include <malloc.h>
+#include <new>
+
+#if !PICOWIFI_STATIC_ALLOCATION
+#error "test_zero_heap needs PICOWIFI_STATIC_ALLOCATION=1"
+#endif
+
+static const char* TEST_SSID = "HostNet";
+static const char* TEST_PASSWORD = "hostpass";
+static const uint32_t CONNECT_TIMEOUT_MS = 60000;
+static const uint32_t WARMUP_MS = 10000;
+static const uint32_t MEASURE_MS = 60000;
+
+// Only counted while a measured loop() pass runs
+static bool counting = false;
+static uint32_t allocationCount = 0;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* pointer, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    if (counting) allocationCount++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    if (counting) allocationCount++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* pointer, size_t size) {
+    if (counting) allocationCount++;
+    return __real_realloc(pointer, size);
+}
+}
+
+// libstdc++ calls malloc() from its own object, which --wrap does not
+// reach; __real_malloc keeps these from being counted twice
+void* operator new(size_t size) {
+    if (counting) allocationCount++;
+    void* pointer = __real_malloc(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void* operator new[](size_t size) {
+    if (counting) allocationCount++;
+    void* pointer = __real_malloc(size);
+    if (!pointer) throw std::bad_alloc();
+    return pointer;
+}
+
+void operator delete(void* pointer) noexcept { free(pointer); }
+void operator delete[](void* pointer) noexcept { free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { free(pointer); }
+
+static SimulatedWiFiDriver radio;
+
+alignas(FLASH_SECTOR_SIZE) static uint8_t flashRegion[6 * FLASH_SECTOR_SIZE];
+static SimulatedFlashDriver flash(flashRegion, sizeof(flashRegion));
+
+static uint8_t eepromStored[STORAGE_EEPROM_SIZE];
+static uint8_t eepromImage[STORAGE_EEPROM_SIZE];
+static SimulatedEEPROMDriver eeprom(eepromStored, eepromImage, sizeof(eepromStored));
+
+int main() {
+    HostSerial::setQuiet(true);
+    PicoWiFiHAL::setWiFiDriver(&radio);
+    PicoWiFiHAL::setFlashDriver(&flash);
+    PicoWiFiHAL::setEEPROMDriver(&eeprom);
+
+    radio.addAccessPoint(TEST_SSID, TEST_PASSWORD, 6, -55);
+
+    {
+        StorageManager seed;
+        seed.begin();
+        seed.saveWiFiCredentials(TEST_SSID, TEST_PASSWORD);
+    }
+
+    PicoWiFiConfig config;
+    config.enableSerial = false;
+    config.resetPin = 255;
+    PicoWiFiManager wifi(config);
+    HostTest::check(wifi.begin(), "manager starts on the simulated drivers");
+    wifi.enableDebug(false);
+
+    wifi.connectAsync();
+    uint32_t start = millis();
+    while (!wifi.isConnected() && millis() - start < CONNECT_TIMEOUT_MS) {
+        wifi.loop();
+    }
+    if (!HostTest::check(wifi.isConnected(), "connected to the simulated AP")) {
+        return HostTest::finish();
+    }
+
+    // Let the first snapshot, timing records and reconnect bookkeeping settle
+    start = millis();
+    while (millis() - start < WARMUP_MS) {
+        wifi.loop();
+    }
+
+    uint32_t passes = 0;
+    uint32_t heapChangingPasses = 0;
+    long largestPassChange = 0;
+    size_t startUsedHeap = mallinfo2().uordblks;
+
+    start = millis();
+    while (millis() - start < MEASURE_MS) {
+        size_t before = mallinfo2().uordblks;
+        counting = true;
+        wifi.loop();
+        counting = false;
+        long passChange = (long)mallinfo2().uordblks - (long)before;
+
+        passes++;
+        if (passChange != 0) {
+            heapChangingPasses++;
+            if (labs(passChange) > labs(largestPassChange)) {
+                largestPassChange = passChange;
+            }
+        }
+    }
+    long heapDelta = (long)mallinfo2().uordblks - (long)startUsedHeap;
+
+    HostTest::check(wifi.isConnected(), "still connected after %lu loop() passes", (unsigned long)passes);
+    HostTest::check(allocationCount == 0, "%lu allocations (new, malloc, calloc, realloc) in %lu passes",
+                    (unsigned long)allocationCount, (unsigned long)passes);
+    HostTest::check(heapChangingPasses == 0, "%lu passes changed the heap (largest %+ld bytes)",
+                    (unsigned long)heapChangingPasses, largestPassChange);
+    HostTest::check(heapDelta == 0, "heap in use %+ld bytes over the run", heapDelta);
+
+    return HostTest::finish();
+}
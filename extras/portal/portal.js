@@ -0,0 +1,51 @@
+(function () {
+  function el(id) { return document.getElementById(id); }
+
+  function bars(rssi) {
+    if (rssi > -50) return '●●●●';
+    if (rssi > -65) return '●●●○';
+    if (rssi > -80) return '●●○○';
+    return '●○○○';
+  }
+
+  function render(state) {
+    document.title = state.title;
+    el('title').textContent = 'WiFi ' + state.title;
+
+    var list = el('networks');
+    list.innerHTML = '';
+    if (!state.networks.length) {
+      list.innerHTML = '<p class="empty">未找到網路</p>';
+    }
+    state.networks.forEach(function (net) {
+      var item = document.createElement('div');
+      item.className = 'network-item';
+      item.textContent = bars(net.rssi) + ' ' + net.ssid + ' (' + net.rssi + ' dBm)' +
+        (net.enc ? ' [加密]' : ' [開放]');
+      item.onclick = function () {
+        el('ssid').value = net.ssid;
+        el('password').focus();
+      };
+      list.appendChild(item);
+    });
+
+    if (state.custom) {
+      el('custom').innerHTML = '<hr>' + state.custom;
+    }
+  }
+
+  function load() {
+    var xhr = new XMLHttpRequest();
+    xhr.open('GET', '/state.json');
+    xhr.onload = function () {
+      if (xhr.status !== 200) return;
+      var state = JSON.parse(xhr.responseText);
+      // Keep showing cached results while the device refreshes its scan
+      if (state.networks.length || !state.scanning) render(state);
+      if (state.scanning) setTimeout(load, 2000);
+    };
+    xhr.send();
+  }
+
+  load();
+})();
@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""
+Push WiFi credentials to PicoWiFiManager devices over USB serial.
+
+Talks to SerialProvisioner (config.serialProvisioning = true) on every port
+given, in parallel, and reports each device's MAC, IP and connect time:
+
+    python3 extras/provision.py --ssid Factory --password secret /dev/ttyACM*
+    python3 extras/provision.py --ssid Factory --password secret \\
+        --bssid aa:bb:cc:dd:ee:ff --channel 6 --erase /dev/ttyACM0
+
+Frames are 0xA5 0x5A | type | seq | length u16 | payload | CRC-32 (little
+endian); log text the device prints between frames is skipped. Needs
+pyserial.
+"""
+
+import argparse
+import struct
+import sys
+import threading
+import time
+import zlib
+
+try:
+    import serial
+except ImportError:
+    sys.exit("pyserial is required: pip install pyserial")
+
+SYNC = b"\xa5\x5a"
+PROTOCOL_VERSION = 1
+
+HELLO = 0x01
+PROVISION = 0x02
+STATUS = 0x03
+ERASE = 0x04
+CONNECT_RESULT = 0x10
+
+FLAG_CONNECT = 0x01
+FLAG_HINT = 0x02
+
+RESULTS = ["ok", "bad CRC", "bad length", "bad payload", "unknown command",
+           "storage failed", "connect failed"]
+
+
+class ProvisionError(Exception):
+    pass
+
+
+class Device:
+    def __init__(self, port, baud):
+        self.port = port
+        self.link = serial.Serial(port, baud, timeout=0.05)
+        self.seq = 0
+        self.buffer = b""
+
+    def close(self):
+        self.link.close()
+
+    def send(self, command, payload=b""):
+        self.seq = (self.seq + 1) & 0xFF
+        body = struct.pack("<BBH", command, self.seq, len(payload)) + payload
+        self.link.write(SYNC + body + struct.pack("<I", zlib.crc32(body)))
+        return self.seq
+
+    def receive(self, command, seq, timeout):
+        # Returns the payload of the reply to (command, seq), result first
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            self.buffer += self.link.read(256)
+            while True:
+                start = self.buffer.find(SYNC)
+                if start < 0:
+                    self.buffer = self.buffer[-1:]
+                    break
+                frame = self.buffer[start + 2:]
+                if len(frame) < 4:
+                    self.buffer = self.buffer[start:]
+                    break
+                kind, frame_seq, length = struct.unpack("<BBH", frame[:4])
+                if len(frame) < 4 + length + 4:
+                    self.buffer = self.buffer[start:]
+                    break
+                body = frame[:4 + length]
+                (crc,) = struct.unpack("<I", frame[4 + length:8 + length])
+                self.buffer = frame[8 + length:]
+                if crc != zlib.crc32(body):
+                    continue
+                if kind == command | 0x80 and frame_seq == seq:
+                    return body[4:]
+        raise ProvisionError("no reply to command 0x%02x" % command)
+
+    def request(self, command, payload=b"", timeout=2.0):
+        seq = self.send(command, payload)
+        reply = self.receive(command, seq, timeout)
+        if not reply or reply[0] != 0:
+            code = reply[0] if reply else 255
+            raise ProvisionError(RESULTS[code] if code < len(RESULTS) else "error %d" % code)
+        return seq, reply[1:]
+
+
+def format_ip(value):
+    return ".".join(str(b) for b in struct.pack("<I", value))
+
+
+def provision_network_payload(args, connect):
+    ssid = args.ssid.encode()
+    password = args.password.encode()
+    if not 0 < len(ssid) < 32 or len(password) >= 64:
+        sys.exit("SSID must be 1-31 bytes and the password under 64 bytes")
+    flags = FLAG_CONNECT if connect else 0
+    hint = b""
+    if args.bssid:
+        flags |= FLAG_HINT
+        hint = struct.pack("<B", args.channel) + bytes(int(part, 16) for part in args.bssid.split(":"))
+    return (struct.pack("<BBB", flags, args.priority, len(ssid)) + ssid +
+            struct.pack("<B", len(password)) + password + hint)
+
+
+def provision(port, args, results):
+    started = time.monotonic()
+    row = {"port": port, "mac": "", "result": "", "ip": "", "connect": ""}
+    results.append(row)
+    try:
+        device = Device(port, args.baud)
+    except serial.SerialException as error:
+        row["result"] = str(error)
+        return
+    try:
+        _, hello = device.request(HELLO)
+        version, _, _ = struct.unpack("<BBB", hello[:3])
+        row["mac"] = ":".join("%02x" % b for b in hello[3:9])
+        if version != PROTOCOL_VERSION:
+            raise ProvisionError("protocol version %d" % version)
+
+        if args.erase:
+            device.request(ERASE)
+
+        connect = not args.no_connect
+        seq, reply = device.request(PROVISION, provision_network_payload(args, connect))
+        if connect and reply[:1] == b"\x01":
+            result = device.receive(CONNECT_RESULT, seq, args.timeout)
+            ip, duration, fast = struct.unpack("<IIB", result[1:10])
+            row["connect"] = "%d ms%s" % (duration, " (fast)" if fast else "")
+            if result[0] != 0:
+                raise ProvisionError("connect failed")
+            row["ip"] = format_ip(ip)
+        elif connect:
+            raise ProvisionError("saved, but no connect started")
+        row["result"] = "ok (%.1f s)" % (time.monotonic() - started)
+    except ProvisionError as error:
+        row["result"] = str(error)
+    finally:
+        device.close()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("ports", nargs="+")
+    parser.add_argument("--ssid", required=True)
+    parser.add_argument("--password", default="")
+    parser.add_argument("--priority", type=int, default=0)
+    parser.add_argument("--bssid", help="AP to join first, as aa:bb:cc:dd:ee:ff (needs --channel)")
+    parser.add_argument("--channel", type=int, default=0)
+    parser.add_argument("--erase", action="store_true", help="Forget saved networks first")
+    parser.add_argument("--no-connect", action="store_true", help="Only save the credentials")
+    parser.add_argument("--timeout", type=float, default=30.0, help="Seconds to wait for the connect")
+    parser.add_argument("--baud", type=int, default=115200)
+    args = parser.parse_args()
+    if args.bssid and not args.channel:
+        parser.error("--bssid needs --channel")
+
+    results = []
+    threads = [threading.Thread(target=provision, args=(port, args, results)) for port in args.ports]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    print("| Port | MAC | IP | Connect | Result |")
+    print("|------|-----|----|---------|--------|")
+    for row in sorted(results, key=lambda r: r["port"]):
+        print("| %(port)s | %(mac)s | %(ip)s | %(connect)s | %(result)s |" % row)
+
+    return 0 if all(row["result"].startswith("ok") for row in results) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
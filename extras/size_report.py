@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""
+Report flash and RAM use of the examples for each feature configuration.
+
+Builds the Basic, Advanced and DualCore examples with arduino-cli once per
+PICOWIFI_ENABLE_* configuration and prints a Markdown table of the
+resulting section sizes:
+
+    python3 extras/size_report.py
+    python3 extras/size_report.py --fqbn rp2040:rp2040:rpipico2w --examples Basic
+
+Needs arduino-cli with the arduino-pico core installed, and this library
+visible to it (it is passed with --library). Flash is text + data, RAM is
+data + bss, both as the linker laid them out.
+"""
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+EXAMPLES = ["Basic", "Advanced", "DualCore"]
+
+# (name, compiler flags)
+CONFIGURATIONS = [
+    ("full", []),
+    ("no-portal", ["-DPICOWIFI_ENABLE_PORTAL=0"]),
+    ("headless", ["-DPICOWIFI_ENABLE_PORTAL=0", "-DPICOWIFI_ENABLE_SCANNER=0",
+                  "-DPICOWIFI_ENABLE_STATUS_SERVER=0"]),
+    ("minimal", ["-DPICOWIFI_ENABLE_PORTAL=0", "-DPICOWIFI_ENABLE_SCANNER=0",
+                 "-DPICOWIFI_ENABLE_STATUS_SERVER=0", "-DPICOWIFI_ENABLE_DEBUG=0",
+                 "-DPICOWIFI_ENABLE_DIAGNOSTICS=0", "-DPICOWIFI_ENABLE_SERIAL_PROVISIONING=0"]),
+]
+
+
+def find_size_tool(explicit):
+    if explicit:
+        return explicit
+    if shutil.which("arm-none-eabi-size"):
+        return "arm-none-eabi-size"
+    # arduino-pico ships its toolchain beside the core
+    packages = os.path.expanduser("~/.arduino15/packages/rp2040/tools/pqt-gcc")
+    for dirpath, _, filenames in os.walk(packages):
+        if "arm-none-eabi-size" in filenames:
+            return os.path.join(dirpath, "arm-none-eabi-size")
+    sys.exit("arm-none-eabi-size not found; pass --size-tool")
+
+
+def build(arduino_cli, fqbn, example, flags, output_dir):
+    sketch = os.path.join(ROOT, "examples", example)
+    extra = " ".join(flags)
+    command = [
+        arduino_cli, "compile", "--fqbn", fqbn,
+        "--library", ROOT,
+        "--output-dir", output_dir,
+        "--build-property", "compiler.c.extra_flags=" + extra,
+        "--build-property", "compiler.cpp.extra_flags=" + extra,
+        sketch,
+    ]
+    result = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        return None
+    return os.path.join(output_dir, example + ".ino.elf")
+
+
+def section_sizes(size_tool, elf):
+    # Berkeley format: text data bss dec hex filename
+    output = subprocess.check_output([size_tool, elf], text=True).splitlines()
+    text, data, bss = (int(field) for field in output[1].split()[:3])
+    return text + data, data + bss
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--fqbn", default="rp2040:rp2040:rpipico2w")
+    parser.add_argument("--arduino-cli", default="arduino-cli")
+    parser.add_argument("--size-tool")
+    parser.add_argument("--examples", nargs="+", default=EXAMPLES)
+    args = parser.parse_args()
+
+    results = {}
+    size_tool = None
+    with tempfile.TemporaryDirectory() as scratch:
+        for example in args.examples:
+            for name, flags in CONFIGURATIONS:
+                output_dir = os.path.join(scratch, example, name)
+                sys.stderr.write("Building %s (%s)...\n" % (example, name))
+                elf = build(args.arduino_cli, args.fqbn, example, flags, output_dir)
+                if elf is None:
+                    results[(example, name)] = None
+                    continue
+                size_tool = size_tool or find_size_tool(args.size_tool)
+                results[(example, name)] = section_sizes(size_tool, elf)
+
+    print("| Example | Configuration | Flash (bytes) | vs full | RAM (bytes) | vs full |")
+    print("|---------|---------------|--------------:|--------:|------------:|--------:|")
+    for example in args.examples:
+        baseline = results.get((example, "full"))
+        for name, _ in CONFIGURATIONS:
+            sizes = results[(example, name)]
+            if sizes is None:
+                print("| %s | %s | build failed | | | |" % (example, name))
+                continue
+            flash, ram = sizes
+            flash_delta = "%+d" % (flash - baseline[0]) if baseline else ""
+            ram_delta = "%+d" % (ram - baseline[1]) if baseline else ""
+            print("| %s | %s | %d | %s | %d | %s |" % (example, name, flash, flash_delta, ram, ram_delta))
+
+    return 0 if all(results.values()) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())